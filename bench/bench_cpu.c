@@ -0,0 +1,131 @@
+// bench/bench_cpu.c
+// Interpreter throughput: whole frames of a few instruction mixes, in frames per second and as a
+// multiple of the real Game Boy's speed. Used to compare core builds (THREADED_CORE, ENABLE_LTO,
+// PGO) against each other
+#define _POSIX_C_SOURCE 199309L
+#include <core/bus.h>
+#include <gbemu.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define FRAMES 600 // Ten emulated seconds
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Arithmetic on a WRAM buffer
+static const u8 alu_program[] = {
+    0x21, 0x00, 0xC0, // start: LD HL, $C000
+    0x7E,             // loop: LD A, (HL)
+    0x80,             // ADD A, B
+    0x89,             // ADC A, C
+    0x92,             // SUB D
+    0xAB,             // XOR E
+    0x22,             // LD (HL+), A
+    0x04,             // INC B
+    0x0D,             // DEC C
+    0x7C,             // LD A, H
+    0xFE, 0xD0,       // CP $D0
+    0x20, 0xF3,       // JR NZ, loop
+    0x18, 0xEE,       // JR start
+};
+
+// Calls into ROM subroutines, with stack traffic in WRAM
+static const u8 call_program[] = {
+    0x31, 0xF0, 0xDF, // LD SP, $DFF0
+    0xCD, 0x40, 0x01, // loop: CALL $0140
+    0xCD, 0x50, 0x01, // CALL $0150
+    0x18, 0xF8,       // JR loop
+};
+
+static const u8 call_sub1[] = {
+    0xC5, // PUSH BC
+    0x04, // INC B
+    0x0C, // INC C
+    0x79, // LD A, C
+    0x80, // ADD A, B
+    0x47, // LD B, A
+    0xC1, // POP BC
+    0xC9, // RET
+};
+
+static const u8 call_sub2[] = {
+    0xD5,       // PUSH DE
+    0x1C,       // INC E
+    0x7B,       // LD A, E
+    0xE6, 0x0F, // AND $0F
+    0x20, 0x01, // JR NZ, skip
+    0x14,       // INC D
+    0xD1,       // skip: POP DE
+    0xC9,       // RET
+};
+
+// CB-prefixed instructions on registers and (HL)
+static const u8 cb_program[] = {
+    0x21, 0x00, 0xC0, // start: LD HL, $C000
+    0xCB, 0x37,       // loop: SWAP A
+    0xCB, 0x11,       // RL C
+    0xCB, 0x38,       // SRL B
+    0xCB, 0x46,       // BIT 0, (HL)
+    0xCB, 0xC6,       // SET 0, (HL)
+    0xCB, 0x86,       // RES 0, (HL)
+    0xCB, 0x3E,       // SRL (HL)
+    0x23,             // INC HL
+    0x7C,             // LD A, H
+    0xFE, 0xD0,       // CP $D0
+    0x20, 0xEC,       // JR NZ, loop
+    0x18, 0xE7,       // JR start
+};
+
+static GameBoy gb;
+
+static void run(const char *name, u8 *rom) {
+    gb_init(&gb);
+    gb.cart.rom      = rom;
+    gb.cart.rom_size = 2 * MBC_ROM_BANK_SIZE;
+    mbc_init(&gb);
+    mmu_map_update(&gb);
+    cpu_reset(&gb.cpu);
+    gb.running = true;
+
+    double start = now_seconds();
+    for (int frame = 0; frame < FRAMES; frame++)
+        gb_run_frame(&gb);
+    double elapsed = now_seconds() - start;
+
+    double emulated = (double)FRAMES * GB_FRAME_CYCLES / GB_CLOCK_HZ;
+    printf("%-6s %8.0f frames/s  %7.1fx real time\n", name, FRAMES / elapsed, emulated / elapsed);
+}
+
+int main(void) {
+    u8 *rom = calloc(1, 2 * MBC_ROM_BANK_SIZE);
+    if (!rom)
+        return 1;
+
+#ifdef GB_THREADED_CORE
+    printf("Threaded core, %d frames per workload\n\n", FRAMES);
+#else
+    printf("Table-driven core, %d frames per workload\n\n", FRAMES);
+#endif
+
+    memcpy(rom + 0x0100, alu_program, sizeof(alu_program));
+    run("alu", rom);
+
+    memset(rom, 0, 2 * MBC_ROM_BANK_SIZE);
+    memcpy(rom + 0x0100, call_program, sizeof(call_program));
+    memcpy(rom + 0x0140, call_sub1, sizeof(call_sub1));
+    memcpy(rom + 0x0150, call_sub2, sizeof(call_sub2));
+    run("call", rom);
+
+    memset(rom, 0, 2 * MBC_ROM_BANK_SIZE);
+    memcpy(rom + 0x0100, cb_program, sizeof(cb_program));
+    run("cb", rom);
+
+    free(rom);
+    return 0;
+}
@@ -0,0 +1,77 @@
+// bench/bench_fork.c
+// Cost of branching from one state: gb_fork and a short run, against a full struct copy
+#define _POSIX_C_SOURCE 199309L
+#include <core/bus.h>
+#include <core/fork.h>
+#include <gbemu.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BRANCHES 20000
+#define BRANCH_CYCLES 2000 // A few hundred instructions per branch
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main(void) {
+    // Writes a few WRAM pages per branch: INC A; LD (HL+),A; JR -4
+    static const u8 program[] = {0x3C, 0x22, 0x18, 0xFC};
+    static GameBoy  gb;
+    static GameBoy  copy;
+
+    gb_init(&gb);
+    gb.cart.rom_size = 4 * MBC_ROM_BANK_SIZE;
+    gb.cart.rom      = calloc(1, gb.cart.rom_size);
+    gb.cart.ram_size = 0x8000;
+    gb.cart.ram      = calloc(1, gb.cart.ram_size);
+    memcpy(gb.cart.rom + 0x0100, program, sizeof(program));
+    gb.cart.header.cart_type = 0x03;
+    mbc_init(&gb);
+    mmu_map_update(&gb);
+    cpu_reset(&gb.cpu);
+    gb.cpu.regs.h = 0xC0;
+    gb.running    = true;
+    gb_run_cycles(&gb, GB_FRAME_CYCLES / 2);
+
+    printf("%d branches of %d cycles, %zu byte instance\n\n", BRANCHES, BRANCH_CYCLES,
+           sizeof(GameBoy));
+
+    // Struct copy: every byte, then the pointers into it fixed up
+    double start = now_seconds();
+    for (int i = 0; i < BRANCHES; i++) {
+        memcpy(&copy, &gb, sizeof(GameBoy));
+        copy.cpu.gb = &copy;
+        mmu_map_update(&copy);
+        gb_run_cycles(&copy, BRANCH_CYCLES);
+    }
+    double copy_time = now_seconds() - start;
+
+    // Forks of a fork share one snapshot
+    GameBoy *root = gb_fork(&gb);
+    if (!root) {
+        fprintf(stderr, "gb_fork failed\n");
+        return 1;
+    }
+
+    start = now_seconds();
+    for (int i = 0; i < BRANCHES; i++) {
+        GameBoy *branch = gb_fork(root);
+        gb_run_cycles(branch, BRANCH_CYCLES);
+        gb_fork_free(branch);
+    }
+    double fork_time = now_seconds() - start;
+
+    printf("%-12s %10.3f us/branch\n", "struct copy", copy_time * 1e6 / BRANCHES);
+    printf("%-12s %10.3f us/branch  (%.2fx)\n", "gb_fork", fork_time * 1e6 / BRANCHES,
+           copy_time / fork_time);
+
+    gb_fork_free(root);
+    free(gb.cart.rom);
+    free(gb.cart.ram);
+    return 0;
+}
@@ -0,0 +1,119 @@
+// bench/bench_lockstep.c
+// Frames per second per instance for batches of the same ROM: gb_run_frame on each instance,
+// against lockstep_run_frame on the batch
+#define _POSIX_C_SOURCE 199309L
+#include <core/bus.h>
+#include <core/lockstep.h>
+#include <gbemu.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define FRAMES 30
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Busy loop over a WRAM buffer and a ROM subroutine, waiting for VBlank by polling LY in between
+// Each instance starts with a different B, so their data (not their code) differs
+static const u8 program[] = {
+    0x31, 0xF0, 0xDF, // LD SP, $DFF0
+    0x21, 0x00, 0xC0, // loop: LD HL, $C000
+    0x0E, 0x00,       // LD C, $00
+    0x78,             // fill: LD A, B
+    0x81,             // ADD A, C
+    0x22,             // LD (HL+), A
+    0xCD, 0x40, 0x01, // CALL $0140
+    0x0D,             // DEC C
+    0x20, 0xF7,       // JR NZ, fill
+    0xF0, 0x44,       // wait: LDH A, ($44)
+    0xFE, 0x90,       // CP $90
+    0x20, 0xFA,       // JR NZ, wait
+    0x04,             // INC B
+    0x18, 0xE9,       // JR loop
+};
+
+static const u8 subroutine[] = {
+    0x7E,       // LD A, (HL)
+    0xA8,       // XOR B
+    0x57,       // LD D, A
+    0x1F,       // RRA
+    0x5F,       // LD E, A
+    0x83,       // ADD A, E
+    0xC9,       // RET
+};
+
+static void setup(GameBoy *gb, u8 *rom, u8 seed) {
+    gb_init(gb);
+    gb->cart.rom      = rom;
+    gb->cart.rom_size = 2 * MBC_ROM_BANK_SIZE;
+    mbc_init(gb);
+    mmu_map_update(gb);
+    cpu_reset(&gb->cpu);
+    gb->cpu.regs.b = seed;
+    gb->running    = true;
+}
+
+static void run(u8 *rom, u32 count) {
+    GameBoy  *lanes = malloc(count * sizeof(GameBoy));
+    GameBoy **ptrs  = malloc(count * sizeof(GameBoy *));
+    Lockstep *ls    = malloc(sizeof(Lockstep));
+    if (!lanes || !ptrs || !ls) {
+        fprintf(stderr, "Failed to allocate %u instances\n", count);
+        exit(1);
+    }
+
+    for (u32 i = 0; i < count; i++) {
+        setup(&lanes[i], rom, (u8)i);
+        ptrs[i] = &lanes[i];
+    }
+
+    double start = now_seconds();
+    for (int frame = 0; frame < FRAMES; frame++) {
+        for (u32 i = 0; i < count; i++)
+            gb_run_frame(&lanes[i]);
+    }
+    double single_time = now_seconds() - start;
+
+    for (u32 i = 0; i < count; i++)
+        setup(&lanes[i], rom, (u8)i);
+    if (!lockstep_init(ls, ptrs, count)) {
+        fprintf(stderr, "lockstep_init failed\n");
+        exit(1);
+    }
+
+    start = now_seconds();
+    for (int frame = 0; frame < FRAMES; frame++)
+        lockstep_run_frame(ls);
+    double lockstep_time = now_seconds() - start;
+
+    double frames = (double)FRAMES * count;
+    printf("%4u instances  gb_run_frame %8.0f frames/s  lockstep %8.0f frames/s  (%.2fx)\n", count,
+           frames / single_time, frames / lockstep_time, single_time / lockstep_time);
+
+    lockstep_free(ls);
+    free(ls);
+    free(ptrs);
+    free(lanes);
+}
+
+int main(void) {
+    u8 *rom = calloc(1, 2 * MBC_ROM_BANK_SIZE);
+    if (!rom)
+        return 1;
+    memcpy(rom + 0x0100, program, sizeof(program));
+    memcpy(rom + 0x0140, subroutine, sizeof(subroutine));
+
+    printf("%d frames per instance, %zu byte instances\n\n", FRAMES, sizeof(GameBoy));
+    run(rom, 1);
+    run(rom, 16);
+    run(rom, 64);
+    run(rom, 256);
+
+    free(rom);
+    return 0;
+}
@@ -0,0 +1,69 @@
+// bench/bench_rewind.c
+// Per-frame cost and arena footprint of recording 60 seconds of rewind
+#define _POSIX_C_SOURCE 199309L
+#include <core/bus.h>
+#include <core/rewind.h>
+#include <gbemu.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define FRAMES (60 * 60)
+#define ARENA_SIZE (16 << 20)
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main(void) {
+    // Fills WRAM with a counter, so every frame has fresh bytes: INC A; LD (HL+),A; JR -4
+    static const u8 program[] = {0x3C, 0x22, 0x18, 0xFC};
+    static GameBoy  gb;
+
+    gb_init(&gb);
+    gb.cart.rom_size = 4 * MBC_ROM_BANK_SIZE;
+    gb.cart.rom      = calloc(1, gb.cart.rom_size);
+    gb.cart.ram_size = 0x2000;
+    gb.cart.ram      = calloc(1, gb.cart.ram_size);
+    memcpy(gb.cart.rom + 0x0100, program, sizeof(program));
+    gb.cart.header.cart_type = 0x03;
+    mbc_init(&gb);
+    mmu_map_update(&gb);
+    cpu_reset(&gb.cpu);
+    gb.running = true;
+
+    Rewind rw;
+    if (!rewind_init(&rw, &gb, ARENA_SIZE, FRAMES, 0)) {
+        fprintf(stderr, "Failed to allocate the rewind arena\n");
+        return 1;
+    }
+
+    double push_time = 0.0;
+    for (int frame = 0; frame < FRAMES; frame++) {
+        while (gb_run_cycles(&gb, GB_FRAME_CYCLES).reason != GB_STOP_FRAME)
+            ;
+        double start = now_seconds();
+        rewind_push(&rw, &gb);
+        push_time += now_seconds() - start;
+    }
+
+    double start = now_seconds();
+    for (u32 age = 0; age < rewind_count(&rw); age++)
+        rewind_load(&rw, &gb, age);
+    double load_time = now_seconds() - start;
+
+    printf("%d frames, %zu byte states, keyframe every %u\n", FRAMES, rw.state_size,
+           rw.keyframe_interval);
+    printf("held %u states in %.2f MB (%.0f B/frame)\n", rewind_count(&rw),
+           rewind_bytes_used(&rw) / 1048576.0, (double)rewind_bytes_used(&rw) / rewind_count(&rw));
+    printf("push %8.2f us/frame\n", push_time * 1e6 / FRAMES);
+    printf("load %8.2f us/state\n", load_time * 1e6 / rewind_count(&rw));
+
+    rewind_free(&rw);
+    free(gb.cart.rom);
+    free(gb.cart.ram);
+    return 0;
+}
@@ -4,11 +4,67 @@
 #include <core/utils.h>
 #include <gbemu.h>
 
+// ---------------------------------------------
+// Memory map (page table)
+// ---------------------------------------------
+#define MMU_PAGE_SHIFT 8
+#define MMU_PAGE_SIZE 0x100
+
 // ---------------------------------------------
 // Memory read/write
+// The fast path is inline: one table lookup and a load for plain memory. Unmapped pages (I/O,
+// OAM, MBC registers, trapped code pages) go through the slow path in bus.c
 // ---------------------------------------------
-u8   mmu_read(GameBoy *gb, u16 addr);
-void mmu_write(GameBoy *gb, u16 addr, u8 value);
+u8   mmu_read_slow(GameBoy *gb, u16 addr);
+void mmu_write_slow(GameBoy *gb, u16 addr, u8 value);
+
+static inline u8 mmu_read(GameBoy *gb, u16 addr) {
+    const u8 *page = gb->read_map[addr >> MMU_PAGE_SHIFT];
+    if (page)
+        return page[addr & (MMU_PAGE_SIZE - 1)];
+
+    return mmu_read_slow(gb, addr);
+}
+
+static inline void mmu_write(GameBoy *gb, u16 addr, u8 value) {
+    u8 *page = gb->write_map[addr >> MMU_PAGE_SHIFT];
+    if (page) {
+        page[addr & (MMU_PAGE_SIZE - 1)] = value;
+        return;
+    }
+
+    mmu_write_slow(gb, addr, value);
+}
+
+// Little-endian 16-bit access (stack, immediates): one load or store when both bytes are in the
+// same mapped page, else two byte accesses, high byte first for writes as PUSH does
+static inline u16 mmu_read16(GameBoy *gb, u16 addr) {
+    const u8 *page = gb->read_map[addr >> MMU_PAGE_SHIFT];
+    u8        off  = addr & (MMU_PAGE_SIZE - 1);
+    if (page && off != MMU_PAGE_SIZE - 1)
+        return load_le16(page + off);
+
+    u8 lo = mmu_read(gb, addr);
+    return MAKE_U16(mmu_read(gb, addr + 1), lo);
+}
+
+static inline void mmu_write16(GameBoy *gb, u16 addr, u16 value) {
+    u8 *page = gb->write_map[addr >> MMU_PAGE_SHIFT];
+    u8  off  = addr & (MMU_PAGE_SIZE - 1);
+    if (page && off != MMU_PAGE_SIZE - 1) {
+        store_le16(page + off, value);
+        return;
+    }
+
+    mmu_write(gb, addr + 1, GET_HIGH_BYTE(value));
+    mmu_write(gb, addr, GET_LOW_BYTE(value));
+}
+
+// Rebuild the page table, must be called whenever banks or access permissions change
+void mmu_map_update(GameBoy *gb);
+
+// Remap only 0x0000 - 0x7FFF to the current ROM banks, for MBC bank switches
+void mmu_map_rom(GameBoy *gb);
 
 // ---------------------------------------------
 // Debug Helpers
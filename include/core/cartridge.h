@@ -2,6 +2,7 @@
 #ifndef CARTRIDGE_H
 #define CARTRIDGE_H
 
+#include <core/mbc.h>
 #include <core/utils.h>
 #include <stddef.h>
 
@@ -41,30 +42,102 @@ typedef struct {
     bool cgb_supported; // Game Boy Color support (0x80 = enhanced, 0xC0 = only)
 } CartHeader;
 
+// ---------------------------------------------
+// Shared ROM image
+// One per distinct image in the process. Loading the file an image came from again (same device,
+// inode, size and modification time) reuses it without reading the file; any other file is read
+// and shares an image only if its contents are identical. Reference counted and never written:
+// instances loaded with cart_load_shared point rom at it and copy the parsed header, only
+// cartridge RAM and MBC registers are allocated per instance
+// ---------------------------------------------
+
+// Identity of a ROM file from fstat, all 0 where it isn't available
+typedef struct {
+    u64 dev;
+    u64 ino;
+    u64 mtime; // Nanoseconds, a rebuild within the same second still counts as another file
+} RomFileId;
+
+typedef struct RomImage {
+    u8              *rom;
+    size_t           rom_size;
+    bool             rom_mapped;
+    RomFileId        file; // File it was loaded from
+    RawRomHeader     raw_header;
+    CartHeader       header;
+    unsigned         refs;
+    struct RomImage *next;
+} RomImage;
+
 // ---------------------------------------------
 // Cartridge
 // ---------------------------------------------
 typedef struct {
-    u8          *rom;        // ROM data
-    size_t       rom_size;   // ROM size in bytes
-    u8          *ram;        // External RAM (for save data)
-    size_t       ram_size;   // RAM size in bytes
-    RawRomHeader raw_header; // Raw header as read from ROM
-    CartHeader   header;     // Parsed header with usable values
-    // MBC-specific state (later)
-    // Battery flag (later)
+    u8          *rom;          // ROM data
+    size_t       rom_size;     // ROM size in bytes
+    bool         rom_mapped;   // rom is a read-only mapping of the file, released with munmap
+    bool         rom_borrowed; // rom belongs to another cartridge (cart_share_rom), never freed
+    RomImage    *image;        // Shared image rom belongs to (cart_load_shared), NULL if owned
+    u8          *ram;          // External RAM (for save data)
+    size_t       ram_size;     // RAM size in bytes
+    bool         ram_mapped;   // ram is a MAP_SHARED mapping of the .sav file (cart_map_save)
+    RawRomHeader raw_header;   // Raw header as read from ROM
+    CartHeader   header;       // Parsed header with usable values
+    Mbc          mbc;          // Bank controller registers and mapped banks
 } Cartridge;
 
 // ---------------------------------------------
 // Cartridge Functions
 // ---------------------------------------------
 
+// cart_load_flags options
+#define CART_LOAD_NO_MMAP 0x01  // Always copy the image to the heap
+#define CART_LOAD_WILLNEED 0x02 // Have the kernel read the whole mapping ahead
+#define CART_LOAD_HUGEPAGE 0x04 // Ask for transparent huge pages (Linux, if the file system can)
+
 // Load ROM from disk & parse header
+// The image is mapped read-only where mmap is available, so every instance (and process) running
+// the same file shares its page cache pages instead of holding a private copy. Falls back to
+// reading it into the heap
 int         cart_load(Cartridge *cart, const char *path);
+int         cart_load_flags(Cartridge *cart, const char *path, unsigned flags);
+
+// Load through the process-wide image registry: a ROM already loaded by another instance is
+// reused, without reading the file again when it is the same one. Thread safe, released by
+// cart_unload. Unlike cart_load, prints nothing unless loading fails
+int         cart_load_shared(Cartridge *cart, const char *path);
+
+// Number of distinct images currently held by the registry
+unsigned    cart_shared_images(void);
 
-// Unlod the cart: Free the allocated memory for RAM & ROM
+// Point dst at the ROM of src: a shared image gains a reference, anything else is borrowed and
+// must outlive dst. Copies the headers, leaves RAM and MBC alone
+void        cart_share_rom(Cartridge *dst, const Cartridge *src);
+
+// Unlod the cart: Free the allocated memory for RAM & ROM (or drop the shared image reference)
 void        cart_unload(Cartridge *cart);
 
+// ---------------------------------------------
+// Battery-backed saves
+// The .sav file is mapped MAP_SHARED in place of the heap RAM: games write straight into the page
+// cache through the page table, nothing is copied per write or per frame, and what was written
+// survives the emulator crashing. cart_sync_save bounds what an OS crash can lose
+// ---------------------------------------------
+
+// Cart types with a battery ("+BATTERY" in get_cart_type_name)
+bool        cart_has_battery(u8 cart_type);
+
+// rom_path with its extension replaced by .sav. Returns false if it doesn't fit in size
+bool        cart_save_path(const char *rom_path, char *out, size_t size);
+
+// Back cart RAM with the file, created (holding the current RAM) if missing, grown if shorter
+// Returns 0 on success, -1 if it can't be opened or mapped (RAM then stays on the heap)
+// The page table must be rebuilt afterwards (gb_attach_save does it)
+int         cart_map_save(Cartridge *cart, const char *path);
+
+// Flush the mapped RAM to disk, waiting for the write when wait is set
+void        cart_sync_save(Cartridge *cart, bool wait);
+
 // Parse raw header into usable format
 void        parse_header(const RawRomHeader *raw, CartHeader *out);
 
@@ -8,21 +8,37 @@
 // ---------------------------------------------
 // CPU Registers (CPU State)
 // https://gbdev.io/pandocs/CPU_Registers_and_Flags.html
+//
+// Each pair is a union of its 16-bit value and its two halves in host byte order, so regs.hl
+// and regs.h / regs.l are the same storage and pair operations are plain 16-bit ones
 // ---------------------------------------------
+#if GB_HOST_BIG_ENDIAN
+#define REG_PAIR(hi, lo)                                                                           \
+    GB_EXTENSION union {                                                                           \
+        struct {                                                                                   \
+            u8 hi, lo;                                                                             \
+        };                                                                                         \
+        u16 hi##lo;                                                                                \
+    }
+#else
+#define REG_PAIR(hi, lo)                                                                           \
+    GB_EXTENSION union {                                                                           \
+        struct {                                                                                   \
+            u8 lo, hi;                                                                             \
+        };                                                                                         \
+        u16 hi##lo;                                                                                \
+    }
+#endif
 
 struct GameBoy;
 
 typedef struct {
-    // 8 bit registers
-    struct {
-        u8 a; // Accumulator
-        u8 f; // Flags
-        u8 b;
-        u8 c;
-        u8 d;
-        u8 e;
-        u8 h;
-        u8 l;
+    // 8 bit registers, and their 16 bit pairs
+    GB_EXTENSION struct {
+        REG_PAIR(a, f); // Accumulator, Flags (af: see cpu_read_af)
+        REG_PAIR(b, c);
+        REG_PAIR(d, e);
+        REG_PAIR(h, l);
     } regs;
 
     // 16 bit registers
@@ -36,6 +52,19 @@ typedef struct {
 
     // Pointer to the emulator context (for memory access)
     struct GameBoy *gb;
+
+    // Last flag-setting operation while regs.f is stale (see cpu_flags.h)
+    // Never pending outside cpu_step / cpu_run, so not part of the saved state
+    struct {
+        u16  result;   // 8-bit result, bit 8 the carry out or kept
+        u8   operands; // XOR of the operands
+        u8   n;        // FLAG_SUBT for subtractions
+        bool pending;
+    } lazy;
+
+    // Interrupts that need the CPU now (see Interrupts below)
+    // Derived from IE, IF, IME and halted, so not part of the saved state
+    u8              int_pending;
 } CPU;
 
 // ---------------------------------------------
@@ -51,20 +80,68 @@ typedef struct {
 // ---------------------------------------------
 void cpu_init(CPU *cpu, struct GameBoy *gb);
 void cpu_reset(CPU *cpu);
-u8   cpu_step(CPU *cpu); // Execute 1 instruction, return cycles
+u8   cpu_step(CPU *cpu);             // Execute 1 instruction, return cycles
+u32  cpu_run(CPU *cpu, u32 budget); // Execute until budget, next event or HALT, return cycles
+
+// ---------------------------------------------
+// Idle fast-forward (used by cpu_run)
+// Time in which the CPU provably does nothing until a hardware event is skipped in one step
+// ---------------------------------------------
+#define IDLE_LOOP_LEN 6     // LDH A, (a8); CP/AND n8; JR Z/NZ back to the LDH
+#define IDLE_LOOP_CYCLES 32 // 12 + 8 + 12 (jump taken)
+
+u32  cpu_halt_skip(u64 now, u64 end);      // Cycles a halted CPU idles to reach end
+bool cpu_is_idle_loop(CPU *cpu, u16 pc);   // Polling loop on a register only events change
+u32  cpu_idle_loop_skip(u64 now, u64 end); // Whole loop iterations that fit before end
+
+// ---------------------------------------------
+// Interrupts
+// https://gbdev.io/pandocs/Interrupts.html
+// cpu->int_pending caches IE & IF, masked to nothing unless IME is set (dispatch) or the CPU is
+// halted (wake-up), so the run loops test one byte per instruction. Everything that changes IE,
+// IF, IME or halted calls cpu_update_interrupts: code setting those fields directly must too
+// ---------------------------------------------
+#define INT_VECTOR_BASE 0x40    // VBlank, then STAT, Timer, Serial and Joypad 8 bytes apart
+#define INT_DISPATCH_CYCLES 20
+
+void cpu_update_interrupts(CPU *cpu);
+u8   cpu_service_interrupt(CPU *cpu); // End HALT and, with IME set, dispatch. Returns cycles
+
+// An interrupt to dispatch, or one that ends HALT
+static inline bool cpu_interrupt_pending(const CPU *cpu) {
+    return cpu->int_pending != 0;
+}
 
 // ---------------------------------------------
 // Register pair accessors
+// BC, DE and HL are inline, AF builds F from any pending lazy flags (cpu.c)
 // ---------------------------------------------
 u16  cpu_read_af(const CPU *cpu);
-u16  cpu_read_bc(const CPU *cpu);
-u16  cpu_read_de(const CPU *cpu);
-u16  cpu_read_hl(const CPU *cpu);
-
 void cpu_write_af(CPU *cpu, u16 value);
-void cpu_write_bc(CPU *cpu, u16 value);
-void cpu_write_de(CPU *cpu, u16 value);
-void cpu_write_hl(CPU *cpu, u16 value);
+
+static inline u16 cpu_read_bc(const CPU *cpu) {
+    return cpu->regs.bc;
+}
+
+static inline u16 cpu_read_de(const CPU *cpu) {
+    return cpu->regs.de;
+}
+
+static inline u16 cpu_read_hl(const CPU *cpu) {
+    return cpu->regs.hl;
+}
+
+static inline void cpu_write_bc(CPU *cpu, u16 value) {
+    cpu->regs.bc = value;
+}
+
+static inline void cpu_write_de(CPU *cpu, u16 value) {
+    cpu->regs.de = value;
+}
+
+static inline void cpu_write_hl(CPU *cpu, u16 value) {
+    cpu->regs.hl = value;
+}
 
 // ---------------------------------------------
 // Flag Helpers
@@ -72,6 +149,7 @@ void cpu_write_hl(CPU *cpu, u16 value);
 bool cpu_get_flag(CPU *cpu, u8 flag);
 void cpu_set_flag(CPU *cpu, u8 flag);
 void cpu_clear_flag(CPU *cpu, u8 flag);
+void cpu_sync_flags(CPU *cpu); // Build regs.f from a pending lazy flags operation
 
 // ---------------------------------------------
 // Internal CPU Functions (used by tables/exec)
@@ -0,0 +1,62 @@
+// include/core/cpu/cpu_decode.h
+#ifndef CPU_DECODE_H
+#define CPU_DECODE_H
+
+#include <core/cpu/cpu_exec.h>
+#include <core/utils.h>
+
+// ---------------------------------------------
+// Basic-block decode cache
+// Straight-line runs of instructions are decoded once into handler lists and replayed by
+// cpu_run without fetching and looking up every opcode again. Blocks never cross a 256-byte page
+// and end at the first instruction that can change PC or the interrupt state.
+//
+// Blocks are keyed by the host address of their first opcode, which identifies both the ROM bank
+// and the PC, so banked-out code is simply not found. Pages of RAM holding cached code have their
+// write_map entry cleared: the next write through the slow path drops their blocks.
+// ---------------------------------------------
+#define DECODE_BLOCK_MAX 16  // Instructions per block
+#define DECODE_CACHE_SIZE 512 // Direct-mapped, power of two
+
+struct GameBoy;
+
+typedef struct {
+    const u8 *host;      // Host address of the first opcode, NULL when the entry is empty
+    u8        count;     // Decoded instructions
+    bool      idle_loop; // Polling loop the run loop may fast-forward (see cpu_is_idle_loop)
+    InstrFunc handlers[DECODE_BLOCK_MAX];
+} DecodedBlock;
+
+typedef struct {
+    DecodedBlock blocks[DECODE_CACHE_SIZE];
+
+    // Original write_map entry of every page trapped because it holds cached code
+    u8          *trapped[0x100];
+} DecodeCache;
+
+// Block starting at the current PC, decoding it on a miss
+// NULL when the code can't be cached (I/O, HRAM or tile data, illegal opcode)
+const DecodedBlock *cpu_decode_block(struct GameBoy *gb, u16 pc);
+
+// Drop the blocks of a trapped page and re-enable direct writes to it
+void                cpu_decode_invalidate(struct GameBoy *gb, u16 addr);
+
+// Drop every block, used when the memory map is rebuilt
+void                cpu_decode_flush(struct GameBoy *gb);
+
+// ---------------------------------------------
+// Shared ROM blocks (see lockstep.h)
+// A block of ROM code depends on nothing but the image, so instances running the same image can
+// share one cache of them. Such a cache belongs to none of them: it traps no pages and isn't
+// flushed when their memory maps are rebuilt
+// ---------------------------------------------
+
+// Block starting at pc from a shared cache, decoding it on a miss
+// NULL when the PC isn't in a mapped ROM page or the code can't be cached
+const DecodedBlock *cpu_decode_rom_block(DecodeCache *cache, struct GameBoy *gb, u16 pc);
+
+// cpu_run of the table-driven core, taking ROM blocks from rom_cache when it isn't NULL
+// The code anywhere else still goes through the instance's own cache
+u32                 cpu_run_blocks(CPU *cpu, u32 budget, DecodeCache *rom_cache);
+
+#endif // !CPU_DECODE_H
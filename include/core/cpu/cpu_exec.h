@@ -6,8 +6,16 @@
 
 #include <core/cpu/cpu.h>
 
+// Instruction handler: executes one opcode (PC already past it) and returns the T-cycles it took
 typedef u8 (*InstrFunc)(CPU *cpu);
 
+// Handler for an opcode, NULL for illegal opcodes
+InstrFunc cpu_get_handler(u8 opcode);
+
+// Handler for the opcode following a CB prefix. Skips that opcode itself, so with PC past the
+// prefix it runs the whole instruction
+InstrFunc cpu_get_cb_handler(u8 opcode);
+
 // =====================================================
 // 8-bit Load Instructions
 // =====================================================
@@ -314,8 +322,7 @@ u8 instr_stop(CPU *cpu);
 u8 instr_halt(CPU *cpu);
 u8 instr_di(CPU *cpu);
 u8 instr_ei(CPU *cpu);
-// TODO:
-// u8 instr_prefix_cb(CPU *cpu);
+u8 instr_prefix_cb(CPU *cpu); // Dispatches through the CB table (cpu_cb.c)
 
 // =====================================================
 // Rotates / Flags
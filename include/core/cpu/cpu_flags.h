@@ -0,0 +1,89 @@
+// include/core/cpu/cpu_flags.h
+// Lazy flags for the table-driven handlers (cpu_exec.c, cpu_cb.c)
+#ifndef CPU_FLAGS_H
+#define CPU_FLAGS_H
+
+#include <core/cpu/cpu.h>
+
+// ---------------------------------------------
+// Lazy flags
+// ADD, ADC, SUB, SBC, CP, INC and DEC don't compute F. They record their 9-bit result (the carry
+// out, or the carry INC/DEC keep, in bit 8) and the XOR of their operands, which together give
+// Z, N, H and C, and the flags are only built when an instruction reads them. Most are
+// overwritten by the next arithmetic instruction first.
+//
+// Handlers go through flags_* for every read of F and flags_set for every write, never regs.f.
+// cpu_execute and cpu_run leave regs.f up to date (cpu_sync_flags)
+// ---------------------------------------------
+
+// F from the recorded operation. H is bit 4 of operands ^ result: the carry into bit 4
+static inline u8 flags_from_lazy(const CPU *cpu) {
+    u16 r = cpu->lazy.result;
+    return ((u8)r ? 0 : FLAG_ZERO) | cpu->lazy.n | (((cpu->lazy.operands ^ r) & 0x10) << 1) |
+           ((r >> 4) & FLAG_CARRY);
+}
+
+// Materialise F and return it
+static inline u8 flags_get(CPU *cpu) {
+    if (cpu->lazy.pending) {
+        cpu->regs.f       = flags_from_lazy(cpu);
+        cpu->lazy.pending = false;
+    }
+    return cpu->regs.f;
+}
+
+// All four flags known: store them, dropping any recorded operation
+static inline void flags_set(CPU *cpu, u8 f) {
+    cpu->regs.f       = f;
+    cpu->lazy.pending = false;
+}
+
+// Single flags, read without materialising F (conditional jumps, ADC/SBC, rotates)
+static inline bool flags_zero(const CPU *cpu) {
+    return cpu->lazy.pending ? (u8)cpu->lazy.result == 0 : (cpu->regs.f & FLAG_ZERO) != 0;
+}
+
+static inline u8 flags_carry(const CPU *cpu) {
+    return cpu->lazy.pending ? (cpu->lazy.result >> 8) & 1 : (cpu->regs.f & FLAG_CARRY) != 0;
+}
+
+static inline void flags_defer(CPU *cpu, u16 result, u8 operands, u8 n) {
+    cpu->lazy.result   = result;
+    cpu->lazy.operands = operands;
+    cpu->lazy.n        = n;
+    cpu->lazy.pending  = true;
+}
+
+// ---------------------------------------------
+// Arithmetic with deferred flags
+// Return the 8-bit result
+// ---------------------------------------------
+
+// x + y + carry (ADD, ADC)
+static inline u8 alu_add(CPU *cpu, u8 x, u8 y, u8 carry) {
+    u16 r = x + y + carry;
+    flags_defer(cpu, r, x ^ y, 0);
+    return (u8)r;
+}
+
+// x - y - carry (SUB, SBC, CP): a borrow sets bits 8-15
+static inline u8 alu_sub(CPU *cpu, u8 x, u8 y, u8 carry) {
+    u16 r = (u16)(x - y - carry);
+    flags_defer(cpu, r, x ^ y, FLAG_SUBT);
+    return (u8)r;
+}
+
+// INC and DEC keep C
+static inline u8 alu_inc(CPU *cpu, u8 x) {
+    u8 r = x + 1;
+    flags_defer(cpu, r | (flags_carry(cpu) << 8), x ^ 1, 0);
+    return r;
+}
+
+static inline u8 alu_dec(CPU *cpu, u8 x) {
+    u8 r = x - 1;
+    flags_defer(cpu, r | (flags_carry(cpu) << 8), x ^ 1, FLAG_SUBT);
+    return r;
+}
+
+#endif // !CPU_FLAGS_H
@@ -0,0 +1,45 @@
+// include/core/fork.h
+#ifndef FORK_H
+#define FORK_H
+
+#include <core/utils.h>
+#include <gbemu.h>
+
+// ---------------------------------------------
+// Copy-on-write forks
+//
+// gb_fork clones an instance for branching searches. The ROM is shared (cart_share_rom), VRAM,
+// the tile cache and the registers are copied, and WRAM and cart RAM are shared per 256-byte page
+// with a read-only, reference counted snapshot: the fork's page table reads those pages from the
+// snapshot and leaves their write entries NULL, so the first write to a page goes through the slow
+// path and copies it in (fork_unshare). The decode cache starts empty.
+//
+// Forking an instance that isn't a fork takes the snapshot from it, a copy of its WRAM and cart
+// RAM. Forking a fork reuses its snapshot and only copies the pages it already wrote. To branch
+// many times from one state, fork it once and branch from that fork.
+//
+// A fork never writes to the .sav file of its source and doesn't flush one. Sources with a heap
+// or mapped (not cart_load_shared) ROM must outlive their forks.
+// ---------------------------------------------
+
+// NULL on allocation failure
+GameBoy *gb_fork(const GameBoy *gb);
+
+// Release a fork (or any heap instance): its snapshot reference, cart RAM and ROM reference
+void     gb_fork_free(GameBoy *gb);
+
+// ---------------------------------------------
+// Page table hooks (bus.c, savestate.c)
+// ---------------------------------------------
+
+// Point the shared pages at the snapshot, after the page table was rebuilt
+void     fork_map_shared(GameBoy *gb);
+
+// Copy in the shared page holding addr. Returns false if it isn't one
+bool     fork_unshare(GameBoy *gb, u16 addr);
+
+// Stop sharing: copy every shared page in first when keep is set, otherwise the caller overwrites
+// WRAM and cart RAM. Rebuilds the page table
+void     fork_detach(GameBoy *gb, bool keep);
+
+#endif // !FORK_H
@@ -0,0 +1,45 @@
+// include/core/lockstep.h
+#ifndef LOCKSTEP_H
+#define LOCKSTEP_H
+
+#include <core/cpu/cpu_decode.h>
+#include <core/utils.h>
+#include <gbemu.h>
+
+// ---------------------------------------------
+// Lockstep execution
+//
+// Runs a batch of instances of the same ROM frame by frame in one loop. Every round, each lane
+// (instance) runs whole cpu_run slices until it has passed the end of the round, so the lanes
+// move through the frame together. ROM code is decoded once for the whole batch into a shared
+// cache, code anywhere else (WRAM, HRAM) into the lane's own.
+//
+// Rounds are a few scanlines long: switching lanes every slice (every scheduled event) costs more
+// in cache misses on the lanes' state than the shared decoding saves.
+//
+// Lanes run through gb_frame_run, so each ends up exactly where gb_run_frame would have left it.
+// The lanes' ROM images must stay loaded while they are in the batch. Uses the table-driven
+// handlers in either core build.
+// ---------------------------------------------
+#define LOCKSTEP_ROUND_CYCLES (8 * 456) // Eight scanlines
+
+typedef struct {
+    GameBoy   **lanes;
+    u32         count;
+
+    // Per lane: progress through the current frame
+    GbFrame    *frames;
+
+    // ROM blocks, shared by every lane
+    DecodeCache decode;
+} Lockstep;
+
+// Batch count instances, which stay owned by the caller
+// Returns false on allocation failure
+bool lockstep_init(Lockstep *ls, GameBoy **lanes, u32 count);
+void lockstep_free(Lockstep *ls);
+
+// Run every lane to the end of its current video frame
+void lockstep_run_frame(Lockstep *ls);
+
+#endif // !LOCKSTEP_H
@@ -0,0 +1,83 @@
+// include/core/mbc.h
+#ifndef MBC_H
+#define MBC_H
+
+#include <core/utils.h>
+#include <stdbool.h>
+
+// ---------------------------------------------
+// Memory Bank Controllers (MBC1, MBC3, MBC5)
+// https://gbdev.io/pandocs/MBCs.html
+//
+// Writes to 0x0000 - 0x7FFF land in the controller registers. Every register write recomputes the
+// effective banks once and caches a host pointer to each of them, which mmu_map_update copies into
+// the page table, so ROM/RAM reads never do bank arithmetic or dispatch on the MBC type. The
+// slow path (short images, RTC registers, disabled RAM) goes through mbc_rom_read/mbc_ram_read.
+// ---------------------------------------------
+#define MBC_ROM_BANK_SIZE 0x4000
+#define MBC_RAM_BANK_SIZE 0x2000
+
+struct GameBoy;
+
+typedef enum {
+    MBC_NONE, // ROM only (32 KB), optional unbanked RAM
+    MBC_1,
+    MBC_3,
+    MBC_5,
+} MbcType;
+
+// MBC3 real time clock registers, selected by writing 0x08 - 0x0C to 0x4000 - 0x5FFF
+typedef enum {
+    RTC_S,  // Seconds
+    RTC_M,  // Minutes
+    RTC_H,  // Hours
+    RTC_DL, // Day counter, low 8 bits
+    RTC_DH, // Bit 0 day counter bit 8, bit 6 halt, bit 7 day counter carry
+    RTC_REGS,
+} RtcReg;
+
+typedef struct {
+    MbcType type;
+
+    // Registers as written
+    bool    ram_enabled; // 0x0000 - 0x1FFF, 0x0A in the low nibble
+    u16     bank_lo;     // 0x2000 - 0x3FFF ROM bank (MBC5: 9 bits over two registers)
+    u8      bank_hi;     // 0x4000 - 0x5FFF RAM bank, MBC1 upper ROM bits, MBC3 RTC select
+    u8      mode;        // 0x6000 - 0x7FFF MBC1 banking mode, MBC3 last latch write
+
+    // Effective banks, derived from the registers by mbc_update_banks
+    u16     rom_bank0;   // Mapped at 0x0000 - 0x3FFF (non-zero only in MBC1 mode 1)
+    u16     rom_bank;    // Mapped at 0x4000 - 0x7FFF
+    u8      ram_bank;    // Mapped at 0xA000 - 0xBFFF
+    bool    rtc_mapped;  // MBC3: an RTC register is selected instead of a RAM bank
+
+    // MBC3 clock: registers hold what the game wrote, the clock itself doesn't run yet
+    u8      rtc[RTC_REGS];
+    u8      rtc_latched[RTC_REGS];
+
+    // Host pointers to the banks above, NULL when past the end of the image or RAM is disabled
+    // Last, so save states can stop short of them (they differ between instances)
+    u8     *rom_bank0_ptr;
+    u8     *rom_bank_ptr;
+    u8     *ram_bank_ptr;
+} Mbc;
+
+// ---------------------------------------------
+// MBC Functions
+// ---------------------------------------------
+
+// Pick the controller from the cartridge header and reset it to the power-on banks
+void mbc_init(struct GameBoy *gb);
+
+// Recompute the effective banks and their host pointers (called by mmu_map_update)
+void mbc_update_banks(struct GameBoy *gb);
+
+// Register write (0x0000 - 0x7FFF), remaps the affected pages
+void mbc_write(struct GameBoy *gb, u16 addr, u8 value);
+
+// Slow path accesses for 0x0000 - 0x7FFF and 0xA000 - 0xBFFF
+u8   mbc_rom_read(struct GameBoy *gb, u16 addr);
+u8   mbc_ram_read(struct GameBoy *gb, u16 addr);
+void mbc_ram_write(struct GameBoy *gb, u16 addr, u8 value);
+
+#endif // !MBC_H
@@ -0,0 +1,106 @@
+// include/core/ppu.h
+#ifndef PPU_H
+#define PPU_H
+
+#include <core/utils.h>
+#include <stdbool.h>
+
+// ---------------------------------------------
+// Picture Processing Unit
+// https://gbdev.io/pandocs/Rendering.html
+//
+// Mode changes are scheduler events (SCHED_PPU), so LY and STAT only change between instructions
+// and the CPU never waits on the PPU. Each visible line is rendered into the frame buffer in one
+// pass at the end of mode 3, using the registers as they are at that point.
+//
+// PPU_RENDER_DOT keeps mid-line register writes (raster effects) visible: a write during mode 3
+// first renders the pixels the LCD has already output, so the rest of the line uses the new value.
+// ---------------------------------------------
+#define PPU_WIDTH 160
+#define PPU_HEIGHT 144
+#define PPU_LINES 154
+
+// T-cycles per mode, mode 3 is fixed at its shortest length (no sprite/SCX penalties)
+#define PPU_LINE_CYCLES 456
+#define PPU_OAM_CYCLES 80
+#define PPU_DRAW_CYCLES 172
+#define PPU_HBLANK_CYCLES (PPU_LINE_CYCLES - PPU_OAM_CYCLES - PPU_DRAW_CYCLES)
+
+// LCDC bits
+#define LCDC_BG_ENABLE 0x01
+#define LCDC_OBJ_ENABLE 0x02
+#define LCDC_OBJ_SIZE 0x04  // 8x16 sprites
+#define LCDC_BG_MAP 0x08    // 0x9C00 background map
+#define LCDC_TILE_DATA 0x10 // 0x8000 unsigned tile addressing
+#define LCDC_WIN_ENABLE 0x20
+#define LCDC_WIN_MAP 0x40 // 0x9C00 window map
+#define LCDC_LCD_ENABLE 0x80
+
+// STAT interrupt sources
+#define STAT_HBLANK_INT 0x08
+#define STAT_VBLANK_INT 0x10
+#define STAT_OAM_INT 0x20
+#define STAT_LYC_INT 0x40
+
+#define PPU_MAX_SPRITES 10 // Per line
+#define PPU_TILES 384      // Tiles in the 0x8000 - 0x97FF tile data area
+
+struct GameBoy;
+
+typedef enum {
+    PPU_MODE_HBLANK = 0,
+    PPU_MODE_VBLANK = 1,
+    PPU_MODE_OAM    = 2,
+    PPU_MODE_DRAW   = 3,
+} PpuMode;
+
+typedef enum {
+    PPU_RENDER_SCANLINE, // Whole line at the end of mode 3
+    PPU_RENDER_DOT,      // Catch up to the current dot on register writes during mode 3
+} PpuRenderMode;
+
+typedef struct {
+    // Registers (0xFF40 - 0xFF4B)
+    u8   lcdc;
+    u8   stat; // Interrupt source bits only, mode and LYC flag are computed on read
+    u8   scy;
+    u8   scx;
+    u8   ly;
+    u8   lyc;
+    u8   bgp;
+    u8   obp0;
+    u8   obp1;
+    u8   wy;
+    u8   wx;
+
+    // Internal state
+    u8   mode;         // PpuMode
+    u8   render_mode;  // PpuRenderMode
+    u8   line_x;       // Pixels of the current line already rendered
+    u8   window_line;  // Window row, advances only on lines that showed the window
+    bool window_y_hit; // WY matched LY during this frame
+    bool window_drawn; // Window visible on the current line
+    bool stat_line;    // OR of the enabled STAT sources, interrupts fire on its rising edge
+    u64  mode_start;   // Cycle the current mode began
+    u64  frame_count;  // Frames completed (VBlank entries)
+
+    // Sprite pixels of the current line, set up at the start of mode 3
+    // Bits 0-1 color index (0 = none), bit 4 OBP1, bit 7 behind BG colors 1-3
+    u8   obj_line[PPU_WIDTH];
+    u8   obj_count; // Sprites on the current line
+
+    // Shades 0 (white) - 3 (black) after palette mapping
+    u8   framebuffer[PPU_HEIGHT][PPU_WIDTH];
+} PPU;
+
+// ---------------------------------------------
+// PPU Functions
+// ---------------------------------------------
+void ppu_init(struct GameBoy *gb); // Post-boot state, LCD on at the start of line 0
+u8   ppu_read(struct GameBoy *gb, u16 addr);
+void ppu_write(struct GameBoy *gb, u16 addr, u8 value);
+
+// Mark every decoded tile stale, after VRAM was changed without going through mmu_write
+void ppu_invalidate_tiles(struct GameBoy *gb);
+
+#endif // !PPU_H
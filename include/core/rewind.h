@@ -0,0 +1,70 @@
+// include/core/rewind.h
+#ifndef REWIND_H
+#define REWIND_H
+
+#include <core/utils.h>
+#include <gbemu.h>
+#include <stddef.h>
+
+// ---------------------------------------------
+// Rewind buffer
+//
+// A ring of save states (see savestate.h), normally one per frame, packed into an arena allocated
+// once by rewind_init. Every keyframe_interval-th state is a keyframe, the others are stored as
+// the XOR against the latest keyframe; both are then run-length coded over 8-byte words, so the
+// unchanged bulk of a frame (ROM banks aside, most of VRAM, WRAM and cart RAM) costs a few bytes.
+// Restoring any state unpacks at most two entries.
+//
+// When the arena or the entry ring is full the oldest keyframe is dropped together with its
+// deltas. Pushing and restoring never allocate.
+// ---------------------------------------------
+#define REWIND_KEYFRAME_INTERVAL 60 // One keyframe per second of frames
+
+typedef struct {
+    u32  offset;   // Packed bytes in the arena
+    u32  size;
+    bool keyframe; // Otherwise a delta against the closest older keyframe
+} RewindEntry;
+
+typedef struct {
+    u8          *arena;
+    size_t       arena_size;
+    size_t       head; // Where the next entry goes
+
+    RewindEntry *entries; // Ring, oldest at first
+    u32          capacity;
+    u32          first;
+    u32          count;
+
+    u32          keyframe_interval;
+    u32          since_keyframe; // Entries pushed since the newest keyframe
+
+    size_t       state_size; // gb_state_size of the instance, a multiple of 8
+    u8          *key;        // Unpacked newest keyframe
+    u8          *state;      // Scratch state for push and restore
+    u8          *packed;     // Scratch packed entry, sized for the worst case
+} Rewind;
+
+// Allocate an arena of arena_size bytes for up to max_states states of gb
+// keyframe_interval 0 uses REWIND_KEYFRAME_INTERVAL. Returns false on allocation failure
+bool   rewind_init(Rewind *rw, GameBoy *gb, size_t arena_size, u32 max_states,
+                   u32 keyframe_interval);
+void   rewind_free(Rewind *rw);
+
+// Drop every state, the next push is a keyframe
+void   rewind_clear(Rewind *rw);
+
+// Record the current state. Returns false if it can't fit in the arena or gb's state size
+// changed (another cartridge)
+bool   rewind_push(Rewind *rw, GameBoy *gb);
+
+// Load the state age entries before the newest (0: newest) without dropping anything
+bool   rewind_load(Rewind *rw, GameBoy *gb, u32 age);
+
+// Load the newest state and drop it, so repeated calls step back one entry at a time
+bool   rewind_pop(Rewind *rw, GameBoy *gb);
+
+u32    rewind_count(const Rewind *rw);
+size_t rewind_bytes_used(const Rewind *rw); // Packed bytes currently held
+
+#endif // !REWIND_H
@@ -0,0 +1,37 @@
+// include/core/savestate.h
+#ifndef SAVESTATE_H
+#define SAVESTATE_H
+
+#include <core/utils.h>
+#include <gbemu.h>
+#include <stddef.h>
+
+// ---------------------------------------------
+// Save states
+//
+// A state is a header followed by a fixed sequence of chunks (cart, CPU, VRAM, WRAM/OAM/HRAM,
+// scheduler, timer, PPU, MBC, cart RAM, system), each an id, a size and the raw bytes of the
+// component struct, padded to 8 bytes. Saving and loading are one memcpy (or iovec) per chunk.
+//
+// The chunks are this build's struct layouts: any change to a saved struct must bump
+// GB_STATE_VERSION. Loading checks the version, every chunk id and size, and that the cart chunk
+// (raw header and ROM size) matches the running cartridge before touching the machine. ROM, the
+// tile and decode caches and the page table aren't saved, they are rebuilt on load. Breakpoints
+// and the .sav sync interval belong to the instance and are kept.
+// ---------------------------------------------
+#define GB_STATE_VERSION 4
+
+// Bytes gb_save_state needs for this instance (depends on the cart RAM size)
+size_t gb_state_size(GameBoy *gb);
+
+// Returns the bytes written, 0 if size is too small
+size_t gb_save_state(GameBoy *gb, void *buf, size_t size);
+
+// Returns false, leaving the machine untouched, if the state doesn't match this build or cart
+bool   gb_load_state(GameBoy *gb, const void *buf, size_t size);
+
+// Same through a file (a single writev). Return 0 on success, -1 on I/O errors or a bad state
+int    gb_save_state_file(GameBoy *gb, const char *path);
+int    gb_load_state_file(GameBoy *gb, const char *path);
+
+#endif // !SAVESTATE_H
@@ -0,0 +1,68 @@
+// include/core/scheduler.h
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <core/utils.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// ---------------------------------------------
+// Event scheduler
+// Components register the cycle of their next state change instead of being ticked every
+// instruction. The CPU runs freely up to the earliest deadline, then the due events are
+// dispatched (catch-up model). Each event kind is pending at most once, so the min-heap never
+// holds more than SCHED_EVENT_COUNT entries.
+// ---------------------------------------------
+#define SCHED_NEVER UINT64_MAX
+
+struct GameBoy;
+
+typedef enum {
+    SCHED_TIMER,  // TIMA overflow
+    SCHED_PPU,    // LCD mode transition
+    SCHED_APU,    // Frame sequencer step
+    SCHED_SERIAL, // Serial transfer complete
+    SCHED_SAVE,   // Periodic flush of a mapped .sav file
+    SCHED_EVENT_COUNT,
+} SchedEvent;
+
+// Called once the event is due, with the cycle it was scheduled for (gb->cycles may be later)
+typedef void (*SchedHandler)(struct GameBoy *gb, u64 when);
+
+typedef struct {
+    u64 when;
+    u8  event;
+} SchedEntry;
+
+typedef struct {
+    SchedEntry   heap[SCHED_EVENT_COUNT];
+    i8           slot[SCHED_EVENT_COUNT]; // Heap index of each event, -1 when not pending
+    u8           count;
+
+    // cpu_run returns at the first instruction boundary at or past this cycle
+    // Lowered when an event is scheduled earlier than the running slice
+    u64          deadline;
+
+    SchedHandler handlers[SCHED_EVENT_COUNT];
+} Scheduler;
+
+// ---------------------------------------------
+// Scheduler Functions
+// ---------------------------------------------
+void sched_init(Scheduler *s);
+void sched_set_handler(Scheduler *s, SchedEvent event, SchedHandler handler);
+
+// Add the event, or move it if already pending
+void sched_schedule(Scheduler *s, SchedEvent event, u64 when);
+void sched_cancel(Scheduler *s, SchedEvent event);
+bool sched_is_pending(const Scheduler *s, SchedEvent event);
+u64  sched_when(const Scheduler *s, SchedEvent event); // SCHED_NEVER when not pending
+u64  sched_next(const Scheduler *s);                   // Earliest deadline, SCHED_NEVER if none
+
+// Start a cpu_run slice ending at end, or earlier at the next event
+void sched_set_deadline(Scheduler *s, u64 end);
+
+// Dispatch every event due at gb->cycles, in deadline order
+void sched_run_due(struct GameBoy *gb);
+
+#endif // !SCHEDULER_H
@@ -0,0 +1,39 @@
+// include/core/tile_decode.h
+#ifndef TILE_DECODE_H
+#define TILE_DECODE_H
+
+#include <core/utils.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ---------------------------------------------
+// 2bpp tile row decoding
+// https://gbdev.io/pandocs/Tile_Data.html
+//
+// A tile row is two bitplane bytes (low, high), bit 7 being the leftmost pixel. Rows are decoded
+// in batches into 8 bytes each, already mapped through a BGP/OBP style palette: pass
+// TILE_PALETTE_IDENTITY to get the raw color indices.
+//
+// SSE2 and AVX2 kernels are built on x86 with GCC/Clang and picked at runtime from what the CPU
+// supports, once per process (thread safe). Define GB_NO_SIMD to build the scalar loop only.
+// ---------------------------------------------
+#define TILE_PALETTE_IDENTITY 0xE4 // Color i -> shade i
+
+typedef enum {
+    TILE_DECODE_SCALAR,
+    TILE_DECODE_SSE2,
+    TILE_DECODE_AVX2,
+    TILE_DECODE_AUTO, // Best supported kernel
+} TileDecodeImpl;
+
+// Decode rows tile rows from planes (2 * rows bytes) into out (8 * rows bytes)
+void           tile_decode_rows(const u8 *planes, size_t rows, u8 palette, u8 *out);
+
+// Force a kernel, for tests and benchmarks: call it while no other thread decodes
+// Returns false if this build or CPU lacks it
+bool           tile_decode_select(TileDecodeImpl impl);
+bool           tile_decode_supported(TileDecodeImpl impl);
+TileDecodeImpl tile_decode_active(void);
+const char    *tile_decode_name(TileDecodeImpl impl);
+
+#endif // !TILE_DECODE_H
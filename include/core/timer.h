@@ -0,0 +1,36 @@
+// include/core/timer.h
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <core/utils.h>
+#include <stdbool.h>
+
+// ---------------------------------------------
+// Timer (DIV, TIMA, TMA, TAC)
+// https://gbdev.io/pandocs/Timer_and_Divider_Registers.html
+//
+// Nothing is ticked per instruction. DIV is the top byte of a 16-bit system counter derived from
+// gb->cycles, TIMA is brought up to date from its last sync point whenever it is accessed, and
+// the next TIMA overflow is a scheduler event (SCHED_TIMER) that reloads TMA and raises IF.
+// Register accesses see the cycle count at the start of the accessing instruction.
+// ---------------------------------------------
+struct GameBoy;
+
+typedef struct {
+    u64  div_offset;     // System counter = (u16)(cycles + div_offset)
+    u64  tima_sync;      // Cycle up to which tima is current
+    u64  reload_at;      // Cycle TMA is loaded after an overflow, while reload_pending
+    bool reload_pending; // TIMA overflowed and reads 0 until reload_at
+    u8   tima;           // Timer counter (0xFF05)
+    u8   tma;            // Timer modulo (0xFF06)
+    u8   tac;            // Timer control (0xFF07), bit 2 enable, bits 0-1 clock select
+} Timer;
+
+// ---------------------------------------------
+// Timer Functions
+// ---------------------------------------------
+void timer_init(struct GameBoy *gb); // Post-boot state, registers the overflow event handler
+u8   timer_read(struct GameBoy *gb, u16 addr);
+void timer_write(struct GameBoy *gb, u16 addr, u8 value);
+
+#endif // !TIMER_H
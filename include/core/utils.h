@@ -4,6 +4,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 // ---------------------------------------------
 // Type Definitions
@@ -47,38 +48,140 @@ typedef int64_t  i64;
 // ---------------------------------------------
 
 // Combine two 8-bit values into 16 bit (high B, low B)
-#define MAKE_U16(hi, lo) (((u16)(hi) << 8) | (u16)lo)
+#define MAKE_U16(hi, lo) (((u16)(hi) << 8) | (u16)(lo))
 
 // Extract high/low 8 bits from a 16-bit value
 #define GET_HIGH_BYTE(val) ((u8)((val) >> 8))
 #define GET_LOW_BYTE(val) ((u8)((val) & 0xFF))
 
 // ---------------------------------------------
-// Complex Utility Functions
+// Byte order
+// The Game Boy is little-endian. Register pairs and 16-bit memory accesses are laid out for the
+// host, so they need to know its order
 // ---------------------------------------------
-u16  swap_bytes(u16 val);              // Swap endianness
-bool check_half_carry_add(u8 a, u8 b); // Check if half-carry occurred (bit 3->4)
-bool check_carry_add(u8 a, u8 b);      // Check if carry occurred (bit 7->8)
-bool check_half_carry_sub(u8 a, u8 b); // Half-carry for subtraction
-bool check_carry_sub(u8 a, u8 b);      // Carry for subtraction
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define GB_HOST_BIG_ENDIAN 1
+#else
+#define GB_HOST_BIG_ENDIAN 0
+#endif
+
+// Anonymous structs and unions are C11, GCC and Clang take them in C99 as an extension
+#ifdef __GNUC__
+#define GB_EXTENSION __extension__
+#else
+#define GB_EXTENSION
+#endif
+
+// Little-endian 16-bit load and store, a single (unaligned) access on little-endian hosts
+static inline u16 load_le16(const u8 *p) {
+#if GB_HOST_BIG_ENDIAN
+    return MAKE_U16(p[1], p[0]);
+#else
+    u16 value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+#endif
+}
+
+static inline void store_le16(u8 *p, u16 value) {
+#if GB_HOST_BIG_ENDIAN
+    p[0] = GET_LOW_BYTE(value);
+    p[1] = GET_HIGH_BYTE(value);
+#else
+    memcpy(p, &value, sizeof(value));
+#endif
+}
+
+// ---------------------------------------------
+// Utility Functions
+// Inline: the carry checks run on every arithmetic instruction
+// ---------------------------------------------
+
+// Swap endianness
+static inline u16 swap_bytes(u16 val) {
+    return (u16)((val << 8) | (val >> 8));
+}
+
+// Check if half-carry occurred (bit 3->4)
+static inline bool check_half_carry_add(u8 a, u8 b) {
+    return ((a & 0x0F) + (b & 0x0F)) > 0x0F;
+}
+
+// Check if carry occurred (bit 7->8)
+static inline bool check_carry_add(u8 a, u8 b) {
+    return (u16)a + (u16)b > 0xFF;
+}
+
+// Half-carry for subtraction
+static inline bool check_half_carry_sub(u8 a, u8 b) {
+    return (a & 0x0F) < (b & 0x0F);
+}
+
+// Carry for subtraction
+static inline bool check_carry_sub(u8 a, u8 b) {
+    return a < b;
+}
 
 // 16-bit carry checks (for 16-bit arithmetic)
-bool check_half_carry_add_u16(u16 a, u16 b); // Half-carry bit 11->12
-bool check_carry_add_u16(u16 a, u16 b);      // Carry bit 15->16
+// Half-carry bit 11->12
+static inline bool check_half_carry_add_u16(u16 a, u16 b) {
+    return ((a & 0x0FFF) + (b & 0x0FFF)) > 0x0FFF;
+}
+
+// Carry bit 15->16
+static inline bool check_carry_add_u16(u16 a, u16 b) {
+    return ((u32)a + (u32)b) > 0xFFFF;
+}
 
 // ADC instruction helpers
-bool check_half_carry_adc(u8 a, u8 b, u8 carry);
-bool check_carry_adc(u8 a, u8 b, u8 carry);
+static inline bool check_half_carry_adc(u8 a, u8 b, u8 carry) {
+    return ((a & 0x0F) + (b & 0x0F) + carry) > 0x0F;
+}
+
+static inline bool check_carry_adc(u8 a, u8 b, u8 carry) {
+    return (u16)a + (u16)b + carry > 0xFF;
+}
 
 // SBC instruction helpers
-bool check_half_carry_sbc(u8 a, u8 b, u8 carry);
-bool check_carry_sbc(u8 a, u8 b, u8 carry);
+static inline bool check_half_carry_sbc(u8 a, u8 b, u8 carry) {
+    return (a & 0x0F) < ((b & 0x0F) + carry);
+}
 
+static inline bool check_carry_sbc(u8 a, u8 b, u8 carry) {
+    return (u16)a < (u16)b + carry;
+}
 
 // Binary Coded Decimal (BCD) adjustment for DAA instruction
-u8   adjust_bcd(u8 value, bool subtract, bool carry, bool half_carry);
+static inline u8 adjust_bcd(u8 value, bool subtract, bool carry, bool half_carry) {
+    u8 correction = 0;
+
+    if (!subtract) {
+        // After ADD / ADC
+        if (half_carry || (value & 0x0F) > 0x09)
+            correction |= 0x06;
+
+        if (carry || value > 0x99)
+            correction |= 0x60;
+
+        value += correction;
+    } else {
+        // After SUB / SBC
+        if (half_carry)
+            correction |= 0x06;
+
+        if (carry)
+            correction |= 0x60;
+
+        value -= correction;
+    }
+
+    return value;
+}
 
 // Sign extension (for relative jumps)
-i16  sign_extend_i8(u8 val); // Extend 8 bit signed to 16-bit
+// Extend 8 bit signed to 16-bit
+static inline i16 sign_extend_i8(u8 val) {
+    return (val & 0x80) ? (i16)(val | 0xFF00) : (i16)val;
+}
 
 #endif
@@ -3,9 +3,62 @@
 #define GBEMU_H
 
 #include <core/cpu/cpu.h>
+#include <core/cpu/cpu_decode.h>
 #include <core/cartridge.h>
+#include <core/ppu.h>
+#include <core/scheduler.h>
+#include <core/timer.h>
 #include <core/utils.h>
 
+// ---------------------------------------------
+// Timing
+// ---------------------------------------------
+#define GB_CLOCK_HZ 4194304     // T-cycles per second
+#define GB_FRAME_CYCLES 70224   // T-cycles per video frame (154 lines * 456 dots)
+#define GB_SAVE_SYNC_FRAMES 300 // Default .sav flush interval, about 5 seconds
+
+// ---------------------------------------------
+// Copy-on-write forks (see core/fork.h)
+// ---------------------------------------------
+// 256-byte pages tracked per fork: WRAM, then up to 128 KB of cart RAM
+#define GB_FORK_PAGES ((0x2000 + 0x20000) >> 8)
+
+typedef struct ForkSnapshot ForkSnapshot;
+
+// ---------------------------------------------
+// Interrupts (bits of IE and IF)
+// ---------------------------------------------
+#define INT_VBLANK 0x01
+#define INT_STAT 0x02
+#define INT_TIMER 0x04
+#define INT_SERIAL 0x08
+#define INT_JOYPAD 0x10
+
+// ---------------------------------------------
+// Batched Execution
+// ---------------------------------------------
+#define GB_MAX_BREAKPOINTS 16
+
+// Why gb_run_cycles returned
+typedef enum {
+    GB_STOP_BUDGET,     // Cycle budget consumed
+    GB_STOP_HALT,       // CPU executed HALT
+    GB_STOP_BREAKPOINT, // PC reached a breakpoint
+    GB_STOP_FRAME,      // Crossed a video frame boundary
+} GbStopReason;
+
+typedef struct {
+    GbStopReason reason;
+    u32          cycles;    // T-cycles executed
+    u32          overshoot; // T-cycles run past the budget or frame boundary
+} GbRunResult;
+
+// Progress through one gb_run_frame done in pieces (see gb_frame_run), zeroed to start a frame
+typedef struct {
+    u64  end;  // Frame boundary it runs to, 0 until it starts
+    bool done; // Frame complete
+} GbFrame;
+
 // ---------------------------------------------
 // Main GameBoy Struct
 // ---------------------------------------------
@@ -17,12 +70,52 @@ typedef struct GameBoy {
     // Memory
     // https://gbdev.io/pandocs/Memory_Map.html#memory-map
     u8        vram[0x2000]; // Video RAM - 8 KB (0x8000 - 0x9FFF)
+
+    // Tile data (0x8000 - 0x97FF) decoded to one color index per pixel, refreshed by the PPU when
+    // it next samples a tile that mmu_write marked dirty. Code writing gb->vram directly must call
+    // ppu_invalidate_tiles
+    u8        tile_cache[PPU_TILES][64];
+    bool      tile_dirty[PPU_TILES];
+
     u8        wram[0x2000]; // Work RAM - 8 KB (0xC000 - 0xDFFF)
     u8        oam[0xA0];    // Object Attribute Memory - 160 B (0xFE00 - 0xFE9E)
     u8        hram[0x7F];   // High RAM - 127 B (0xFF88 - 0xFFFE)
 
     // I/O Registers
     u8        ie_register; // Interrupt Enable Register (0xFFFF)
+    u8        if_register; // Interrupt Flag Register (0xFF0F)
+
+    // Memory map: one host pointer per 256-byte page (see mmu_map_update)
+    // A NULL entry routes the access through the slow path in bus.c
+    u8       *read_map[0x100];
+    u8       *write_map[0x100];
+    // Bumped whenever the code behind an address may have changed (ROM bank switch, map rebuild,
+    // invalidated code page), so a running block can tell its remaining handlers went stale
+    u32       map_gen;
+
+    // Decoded basic blocks for cpu_run (see cpu_decode.h)
+    DecodeCache decode;
+
+    // Debugger breakpoints, checked by gb_run_cycles
+    u16       breakpoints[GB_MAX_BREAKPOINTS];
+    u8        breakpoint_count;
+
+    // Pending timer/PPU/APU/serial deadlines
+    Scheduler sched;
+
+    // DIV/TIMA, computed on access (see timer.h)
+    Timer     timer;
+
+    // LCD modes, registers and frame buffer
+    PPU       ppu;
+
+    // T-cycles between flushes of a mapped .sav file, 0 for none (see gb_attach_save)
+    u64       save_sync_cycles;
+
+    // Forks only: the snapshot this instance shares memory with, and which of its WRAM and cart
+    // RAM pages still read from it (copied in on their first write)
+    ForkSnapshot *fork_base;
+    u64           fork_shared[(GB_FORK_PAGES + 63) / 64];
 
     // System state
     u64       cycles;
@@ -37,6 +130,26 @@ void gb_load_rom(GameBoy *gb, const char *path);
 void gb_step(GameBoy *gb);
 void gb_run_frame(GameBoy *gb);
 
+// Run for up to budget T-cycles, stopping early on HALT, a breakpoint or the end of a frame
+// Frames are counted from power-on, every GB_FRAME_CYCLES
+GbRunResult gb_run_cycles(GameBoy *gb, u32 budget);
+
+// gb_run_frame in pieces, for running instances side by side (see lockstep.h): runs whole
+// cpu_run slices until gb->cycles reaches until, and the pieces end exactly where gb_run_frame
+// would. ROM blocks come from rom_cache unless it is NULL (table-driven core in either build)
+// Returns false once the frame is complete
+bool        gb_frame_run(GameBoy *gb, GbFrame *frame, u64 until, DecodeCache *rom_cache);
+
+// Back battery RAM with a .sav file (see cart_map_save), flushed every sync_frames frames of
+// emulated time and when the cart is unloaded (0: only then). Returns 0 on success
+int  gb_attach_save(GameBoy *gb, const char *path, u32 sync_frames);
+
+bool gb_add_breakpoint(GameBoy *gb, u16 addr);
+void gb_clear_breakpoints(GameBoy *gb);
+
+// Set bits in IF, called by components when an interrupt source fires
+void gb_request_interrupt(GameBoy *gb, u8 mask);
+
 // ---------------------------------------------
 // I/O Handlers (called by MMU)
 // ---------------------------------------------
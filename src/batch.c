@@ -0,0 +1,316 @@
+// src/batch.c
+// baredmg-batch: run many headless instances at once, one job per ROM, spread over a thread pool
+#define _POSIX_C_SOURCE 200809L
+#include <core/bus.h>
+#include <core/cartridge.h>
+#include <core/cpu/cpu.h>
+#include <gbemu.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BATCH_DEFAULT_FRAMES 600 // 10 seconds of emulated time per job
+
+// ---------------------------------------------
+// Jobs
+// ---------------------------------------------
+typedef struct {
+    const char *rom_path;
+    u32         frames;
+
+    // Filled in by the worker that ran it
+    bool        loaded;
+    u64         cycles;
+    u16         pc, sp, af, bc, de, hl;
+    u64         frame_hash; // FNV-1a of the last frame buffer
+    double      seconds;    // Wall time
+    int         worker;
+} BatchJob;
+
+// ---------------------------------------------
+// Work-stealing queues
+// Every worker starts with a contiguous slice of the job list, takes from the back of its own
+// deque and, once it is empty, steals from the front of the others. Jobs are whole emulation
+// runs (milliseconds to seconds), so a mutex per deque costs nothing measurable
+// ---------------------------------------------
+typedef struct {
+    pthread_mutex_t lock;
+    u32             head; // Next job to steal
+    u32             tail; // One past the next job to run
+} JobDeque;
+
+typedef struct {
+    BatchJob *jobs;
+    JobDeque *deques;
+    int       workers;
+} BatchPool;
+
+typedef struct {
+    BatchPool *pool;
+    int        id;
+} WorkerArgs;
+
+static bool deque_pop(JobDeque *dq, u32 *job) {
+    bool found = false;
+
+    pthread_mutex_lock(&dq->lock);
+    if (dq->head < dq->tail) {
+        *job  = --dq->tail;
+        found = true;
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return found;
+}
+
+static bool deque_steal(JobDeque *dq, u32 *job) {
+    bool found = false;
+
+    pthread_mutex_lock(&dq->lock);
+    if (dq->head < dq->tail) {
+        *job  = dq->head++;
+        found = true;
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return found;
+}
+
+// Own deque first, then the others starting from the next worker
+static bool next_job(BatchPool *pool, int id, u32 *job) {
+    if (deque_pop(&pool->deques[id], job))
+        return true;
+
+    for (int i = 1; i < pool->workers; i++) {
+        if (deque_steal(&pool->deques[(id + i) % pool->workers], job))
+            return true;
+    }
+    return false;
+}
+
+// ---------------------------------------------
+// Running a job
+// ---------------------------------------------
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static u64 frame_hash(const PPU *ppu) {
+    const u8 *bytes = &ppu->framebuffer[0][0];
+    u64       hash  = 0xCBF29CE484222325ULL;
+
+    for (size_t i = 0; i < sizeof(ppu->framebuffer); i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+// Like gb_load_rom without printing the header, and never touching a .sav file
+static void run_job(BatchJob *job, GameBoy *gb) {
+    double start = now_seconds();
+
+    gb_init(gb);
+    if (cart_load_shared(&gb->cart, job->rom_path) != 0)
+        return;
+
+    mbc_init(gb);
+    mmu_map_update(gb);
+    cpu_reset(&gb->cpu);
+    gb->running = true;
+
+    for (u32 frame = 0; frame < job->frames && gb->running; frame++)
+        gb_run_frame(gb);
+
+    job->loaded     = true;
+    job->cycles     = gb->cycles;
+    job->pc         = gb->cpu.pc;
+    job->sp         = gb->cpu.sp;
+    job->af         = cpu_read_af(&gb->cpu);
+    job->bc         = cpu_read_bc(&gb->cpu);
+    job->de         = cpu_read_de(&gb->cpu);
+    job->hl         = cpu_read_hl(&gb->cpu);
+    job->frame_hash = frame_hash(&gb->ppu);
+    job->seconds    = now_seconds() - start;
+
+    cart_unload(&gb->cart);
+}
+
+static void *worker_main(void *arg) {
+    WorkerArgs *args = arg;
+    BatchPool  *pool = args->pool;
+    u32         job;
+
+    // One instance per worker, reinitialized for every job
+    GameBoy    *gb   = malloc(sizeof(GameBoy));
+    if (!gb)
+        return NULL;
+
+    while (next_job(pool, args->id, &job)) {
+        pool->jobs[job].worker = args->id;
+        run_job(&pool->jobs[job], gb);
+    }
+
+    free(gb);
+    return NULL;
+}
+
+// ---------------------------------------------
+// Command line
+// ---------------------------------------------
+static void print_usage(const char *program_name) {
+    printf("Usage: %s [options] <rom> [<rom> ...]\n", program_name);
+    printf("\n");
+    printf("Runs one headless instance per job on a thread pool and prints a result line per\n");
+    printf("job, in command line order.\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("  -f <num>         Frames to run per job (default %d)\n", BATCH_DEFAULT_FRAMES);
+    printf("  -n <num>         Jobs per ROM (default 1)\n");
+    printf("  -j <num>         Worker threads (default: online CPUs)\n");
+    printf("  -h               Show this help message\n");
+}
+
+static bool parse_count(int argc, char *argv[], int *i, int *out) {
+    if (*i + 1 >= argc) {
+        fprintf(stderr, "Error: %s requires a number\n", argv[*i]);
+        return false;
+    }
+    *out = atoi(argv[++*i]);
+    if (*out <= 0) {
+        fprintf(stderr, "Error: Invalid value for %s\n", argv[*i - 1]);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    int frames  = BATCH_DEFAULT_FRAMES;
+    int copies  = 1;
+    int workers = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int roms    = 0;
+
+    const char **rom_paths = calloc((size_t)argc, sizeof(char *));
+    if (!rom_paths)
+        return 1;
+
+    // Parse arguments
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0) {
+            print_usage(argv[0]);
+            free(rom_paths);
+            return 0;
+        }
+
+        else if (strcmp(argv[i], "-f") == 0) {
+            if (!parse_count(argc, argv, &i, &frames))
+                return 1;
+        }
+
+        else if (strcmp(argv[i], "-n") == 0) {
+            if (!parse_count(argc, argv, &i, &copies))
+                return 1;
+        }
+
+        else if (strcmp(argv[i], "-j") == 0) {
+            if (!parse_count(argc, argv, &i, &workers))
+                return 1;
+        }
+
+        else if (argv[i][0] == '-') {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 1;
+        }
+
+        else {
+            rom_paths[roms++] = argv[i];
+        }
+    }
+
+    if (roms == 0) {
+        fprintf(stderr, "Error: No ROM file specified\n\n");
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    // No more workers than jobs
+    u32 job_count = (u32)roms * (u32)copies;
+    if ((u32)workers > job_count)
+        workers = (int)job_count;
+
+    BatchJob   *jobs    = calloc(job_count, sizeof(BatchJob));
+    JobDeque   *deques  = calloc((size_t)workers, sizeof(JobDeque));
+    pthread_t  *threads = calloc((size_t)workers, sizeof(pthread_t));
+    WorkerArgs *args    = calloc((size_t)workers, sizeof(WorkerArgs));
+    if (!jobs || !deques || !threads || !args) {
+        fprintf(stderr, "Failed to allocate %u jobs\n", job_count);
+        return 1;
+    }
+
+    for (u32 j = 0; j < job_count; j++) {
+        jobs[j].rom_path = rom_paths[j / (u32)copies];
+        jobs[j].frames   = (u32)frames;
+    }
+
+    // Hold every image for the whole run, so jobs find it in the registry instead of reloading
+    // it each time the last job using it finishes. Jobs of ROMs that fail here fail too
+    Cartridge *held = calloc((size_t)roms, sizeof(Cartridge));
+    if (!held)
+        return 1;
+    for (int r = 0; r < roms; r++)
+        cart_load_shared(&held[r], rom_paths[r]);
+
+    // Contiguous slices: copies of a ROM mostly stay on one worker, which loads it first
+    BatchPool pool = {jobs, deques, workers};
+    for (int w = 0; w < workers; w++) {
+        pthread_mutex_init(&deques[w].lock, NULL);
+        deques[w].head = (u32)((u64)job_count * (u64)w / (u64)workers);
+        deques[w].tail = (u32)((u64)job_count * (u64)(w + 1) / (u64)workers);
+    }
+
+    double start = now_seconds();
+    for (int w = 0; w < workers; w++) {
+        args[w] = (WorkerArgs){&pool, w};
+        if (pthread_create(&threads[w], NULL, worker_main, &args[w]) != 0) {
+            fprintf(stderr, "Failed to start worker %d\n", w);
+            return 1;
+        }
+    }
+    for (int w = 0; w < workers; w++)
+        pthread_join(threads[w], NULL);
+    double elapsed = now_seconds() - start;
+
+    // Results, in job order
+    int failed = 0;
+    printf("job\trom\tcycles\tpc\tsp\taf\tbc\tde\thl\tframe_hash\tworker\tseconds\n");
+    for (u32 j = 0; j < job_count; j++) {
+        const BatchJob *job = &jobs[j];
+        if (!job->loaded) {
+            printf("%u\t%s\tFAILED\n", j, job->rom_path);
+            failed++;
+            continue;
+        }
+        printf("%u\t%s\t%llu\t%04X\t%04X\t%04X\t%04X\t%04X\t%04X\t%016llX\t%d\t%.3f\n", j,
+               job->rom_path, (unsigned long long)job->cycles, job->pc, job->sp, job->af,
+               job->bc, job->de, job->hl, (unsigned long long)job->frame_hash, job->worker,
+               job->seconds);
+    }
+
+    fprintf(stderr, "%u jobs on %d workers in %.3f s\n", job_count, workers, elapsed);
+
+    for (int r = 0; r < roms; r++)
+        cart_unload(&held[r]);
+    for (int w = 0; w < workers; w++)
+        pthread_mutex_destroy(&deques[w].lock);
+    free(held);
+    free(args);
+    free(threads);
+    free(deques);
+    free(jobs);
+    free(rom_paths);
+    return failed ? 1 : 0;
+}
@@ -1,6 +1,9 @@
 #include <core/utils.h>
 #include <gbemu.h>
+#include <core/bus.h>
+#include <core/fork.h>
 #include <stdio.h>
+#include <string.h>
 
 /*
 Memory Map:
@@ -23,210 +26,288 @@ https://gbdev.io/pandocs/Memory_Map.html#memory-map
 0xFFFF          : Interrupt Enable Register (IE)
 */
 
-// Read one byte from memory
-u8 mmu_read(GameBoy *gb, u16 addr) {
+// ---------------------------------------------
+// Page table
+// ---------------------------------------------
+
+// Point the pages covering [start, start + size) at host memory
+static void map_pages(u8 **map, u16 start, size_t size, u8 *base) {
+    for (size_t offset = 0; offset < size; offset += MMU_PAGE_SIZE)
+        map[(start + offset) >> MMU_PAGE_SHIFT] = base + offset;
+}
+
+// Point a cartridge bank window at the bank selected by the MBC, base/total being the whole image
+// Pages past the end of the image (partial trailing pages included) or of a NULL bank are left to
+// the slow path
+static void map_bank(u8 **map, u16 start, size_t size, u8 *bank, const u8 *base, size_t total) {
+    size_t len = 0;
+
+    if (bank) {
+        len = total - (size_t)(bank - base);
+        len = (len < size ? len : size) & ~(size_t)(MMU_PAGE_SIZE - 1);
+        map_pages(map, start, len, bank);
+    }
+
+    for (size_t offset = len; offset < size; offset += MMU_PAGE_SIZE)
+        map[(start + offset) >> MMU_PAGE_SHIFT] = NULL;
+}
+
+// ROM (0x0000 - 0x7FFF): read only, writes are MBC commands
+void mmu_map_rom(GameBoy *gb) {
+    const Cartridge *cart = &gb->cart;
+
+    map_bank(gb->read_map, 0x0000, MBC_ROM_BANK_SIZE, cart->mbc.rom_bank0_ptr, cart->rom,
+             cart->rom_size);
+    map_bank(gb->read_map, 0x4000, MBC_ROM_BANK_SIZE, cart->mbc.rom_bank_ptr, cart->rom,
+             cart->rom_size);
+    gb->map_gen++;
+}
+
+// Rebuild the read/write page tables
+// Only plain memory is mapped, everything with side effects (MBC control, OAM, I/O, HRAM/IE page)
+// or without backing storage stays NULL and is handled by the slow path
+void mmu_map_update(GameBoy *gb) {
+    memset(gb->read_map, 0, sizeof(gb->read_map));
+    memset(gb->write_map, 0, sizeof(gb->write_map));
+
+    // The image or RAM may have been swapped since the last bank switch
+    mbc_update_banks(gb);
+    mmu_map_rom(gb);
+
+    // VRAM (0x8000 - 0x9FFF), tile data writes go through the slow path to dirty the tile cache
+    map_pages(gb->read_map, 0x8000, sizeof(gb->vram), gb->vram);
+    map_pages(gb->write_map, 0x9800, 0x0800, gb->vram + 0x1800);
+
+    // External RAM (0xA000 - 0xBFFF), only while enabled and not showing an RTC register
+    // 2 KB carts only map the first 8 pages
+    const Cartridge *cart = &gb->cart;
+    map_bank(gb->read_map, 0xA000, MBC_RAM_BANK_SIZE, cart->mbc.ram_bank_ptr, cart->ram,
+             cart->ram_size);
+    map_bank(gb->write_map, 0xA000, MBC_RAM_BANK_SIZE, cart->mbc.ram_bank_ptr, cart->ram,
+             cart->ram_size);
+
+    // WRAM (0xC000 - 0xDFFF) and its echo (0xE000 - 0xFDFF)
+    map_pages(gb->read_map, 0xC000, sizeof(gb->wram), gb->wram);
+    map_pages(gb->write_map, 0xC000, sizeof(gb->wram), gb->wram);
+    map_pages(gb->read_map, 0xE000, 0x1E00, gb->wram);
+    map_pages(gb->write_map, 0xE000, 0x1E00, gb->wram);
+
+    // Forks read the pages they haven't written yet from their snapshot
+    if (gb->fork_base)
+        fork_map_shared(gb);
+
+    // Traps on code pages were just overwritten, and banked code may have moved
+    cpu_decode_flush(gb);
+}
+
+// ---------------------------------------------
+// Slow path
+// Only reached for unmapped pages, so regions are tested from the top of the address space down:
+// the 0xFE/0xFF pages (OAM, I/O, HRAM) are by far the most common callers
+// ---------------------------------------------
+u8 mmu_read_slow(GameBoy *gb, u16 addr) {
     // ---------------------------
-    // ROM Bank 0 (0x0000 - 0x3FFF) - Fixed
+    // Interrupt Enable (0xFFFF)
     // ---------------------------
-    if (addr < 0x4000) {
-        if (addr < gb->cart.rom_size)
-            return gb->cart.rom[addr];
-        return 0xFF; // Open bus
+    if (addr == 0xFFFF) {
+        return gb->ie_register;
     }
 
     // ---------------------------
-    // ROM Bank N (0x4000 - 0x7FFF) - Switchable
+    // HRAM 0xFF80 - 0xFFFE 127 bytes
     // ---------------------------
-    if (addr < 0x8000) {
-        // For now, just read from ROM directly
-        // TODO: MBC will handle bank switching
-        if (addr < gb->cart.rom_size)
-            return gb->cart.rom[addr];
-        return 0xFF;
+    if (addr >= 0xFF80) {
+        return gb->hram[addr - 0xFF80];
     }
 
     // ---------------------------
-    // VRAM (0x8000 - 0x9FFF) - 8 KB
+    // I/O Registers 0xFF00 - 0xFF7F
     // ---------------------------
-    if (addr < 0xA000) {
-        // TODO: Implement when the PPU is ready
-        // For now, just return from VRAM array
-        return gb->vram[addr - 0x8000];
+    if (addr >= 0xFF00) {
+        return io_read(gb, addr);
     }
 
     // ---------------------------
-    // External RAM (0xA000 - 0xBFFF) - Cartridge RAM
+    // Un-usable (0xFEA0 - 0xFEFF)
     // ---------------------------
-    if (addr < 0xC000) {
-        // TODO: Implement with MBC (bank switching, enalbe/disable)
-        // For now, direct access if RAM exists
-        u16 ram_addr = addr - 0xA000;
-        if (ram_addr < gb->cart.ram_size)
-            return gb->cart.ram[ram_addr];
-        return 0xFF;
+    if (addr >= 0xFEA0) {
+        return 0x00;
     }
 
     // ---------------------------
-    // Work RAM (0xC000 - 0xDFFF) - Cartridge RAM
+    // OAM (0xFE00 - 0xFE9F) - Sprite Attribute Table
     // ---------------------------
-    if (addr < 0xE000) {
-        return gb->wram[addr - 0xC000];
+    if (addr >= 0xFE00) {
+        // TODO: Block access while the PPU owns OAM (mode 2/3)
+        return gb->oam[addr - 0xFE00];
     }
 
     // ---------------------------
     // Echo RAM (0xE000 - 0xFDFF) - Mirror of WRAM
     // ---------------------------
-    if (addr < 0xFE00) {
+    if (addr >= 0xE000) {
         return gb->wram[addr - 0xE000];
     }
 
     // ---------------------------
-    // OAM (0xFE00 - 0xFE9F) - Sprite Attribute Table
+    // Work RAM (0xC000 - 0xDFFF)
     // ---------------------------
-    if (addr < 0xFEA0) {
-        // TODO: Implement when PPU is ready
-        return gb->oam[addr - 0xFE00];
+    if (addr >= 0xC000) {
+        return gb->wram[addr - 0xC000];
     }
 
     // ---------------------------
-    // Un-usable (0xFEA0 - 0xFEFF)
+    // External RAM (0xA000 - 0xBFFF) - Cartridge RAM
     // ---------------------------
-    if (addr < 0xFF00) {
-        // Writes ignored
-        return 0x00;
+    if (addr >= 0xA000) {
+        return mbc_ram_read(gb, addr);
     }
 
     // ---------------------------
-    // I/O Registers 0xFF00 - 0xFF7F
+    // VRAM (0x8000 - 0x9FFF) - 8 KB
     // ---------------------------
-    if (addr < 0xFF80) {
-        return io_read(gb, addr);
+    if (addr >= 0x8000) {
+        return gb->vram[addr - 0x8000];
     }
 
     // ---------------------------
-    // HRAM 0xFF80 - 0xFFFE 127 bytes
+    // ROM (0x0000 - 0x7FFF) - selected banks, past the end of short images
     // ---------------------------
-    if (addr < 0xFFFF) {
-        return gb->hram[addr - 0xFF80];
-    }
+    return mbc_rom_read(gb, addr);
+}
 
+void mmu_write_slow(GameBoy *gb, u16 addr, u8 value) {
     // ---------------------------
-    // Interrupt Enable (0xFFFF)
+    // Fork page still shared with its snapshot: copy it in, then write through the new mapping
     // ---------------------------
-    if (addr == 0xFFFF) {
-        return gb->ie_register;
+    if (gb->fork_base && fork_unshare(gb, addr)) {
+        mmu_write(gb, addr, value);
+        return;
     }
 
-    // Ideally, control must never reach here
-    return 0xFF; // Open Bus
-}
-
-// Write one Byte to memory
-void mmu_write(GameBoy *gb, u16 addr, u8 value) {
     // ---------------------------
-    // ROM (0x0000 - 0x7FFF) - MBC Control
+    // RAM page holding decoded code: drop its blocks, then write through the restored mapping
     // ---------------------------
-    if (addr < 0x8000) {
-        // TODO: Implement when MBC is ready
-        // Writes to ROM control MBC (bank switching, RAM enable, etc)
-        // Ignore writes to ROM for now
+    if (gb->decode.trapped[addr >> MMU_PAGE_SHIFT]) {
+        cpu_decode_invalidate(gb, addr);
+        mmu_write(gb, addr, value);
         return;
     }
 
     // ---------------------------
-    // VRAM (0x8000 - 0x9FFF) - 8 KB
+    // Interrupt Enable (0xFFFF)
     // ---------------------------
-    if (addr < 0xA000) {
-        // TODO: Check if VRAM is accessible (not during PPU mode 3)
-        gb->vram[addr - 0x8000] = value;
+    if (addr == 0xFFFF) {
+        gb->ie_register = value;
+        cpu_update_interrupts(&gb->cpu);
         return;
     }
 
     // ---------------------------
-    // External RAM (0xA000 - 0xBFFF) - Cartridge RAM
+    // HRAM 0xFF80 - 0xFFFE 127 bytes
     // ---------------------------
-    if (addr < 0xC000) {
-        // TODO: Implement with MBC (check if RAM is enabled)
-        u16 ram_addr = addr - 0xA000;
-        if (ram_addr < gb->cart.ram_size) {
-            gb->cart.ram[ram_addr] = value;
-        }
+    if (addr >= 0xFF80) {
+        gb->hram[addr - 0xFF80] = value;
         return;
     }
 
     // ---------------------------
-    // Work RAM (0xC000 - 0xDFFF) - Cartridge RAM
+    // I/O Registers (0xFF00 - 0xFF7F)
     // ---------------------------
-    if (addr < 0xE000) {
-        gb->wram[addr - 0xC000] = value;
+    if (addr >= 0xFF00) {
+        io_write(gb, addr, value);
         return;
     }
 
     // ---------------------------
-    // Echo RAM (0xE000 - 0xFDFF) - Mirror of WRAM
+    // Un-usable (0xFEA0 - 0xFEFF)
     // ---------------------------
-    if (addr < 0xFE00) {
-        // Write to WRAM (mirrored)
-        gb->wram[addr - 0xE000] = value;
+    if (addr >= 0xFEA0) {
+        // Writes ignored
         return;
     }
 
     // ---------------------------
     // OAM (0xFE00 - 0xFE9F) - Sprite Attribute Table
     // ---------------------------
-    if (addr < 0xFEA0) {
+    if (addr >= 0xFE00) {
         // TODO: Check if OAM is accessible (not during PPU mode 2/3)
         gb->oam[addr - 0xFE00] = value;
         return;
     }
 
     // ---------------------------
-    // Un-usable (0xFEA0 - 0xFEFF)
+    // Echo RAM (0xE000 - 0xFDFF) - Mirror of WRAM
     // ---------------------------
-    if (addr < 0xFF00) {
-        // Writes ignored
+    if (addr >= 0xE000) {
+        gb->wram[addr - 0xE000] = value;
         return;
     }
 
     // ---------------------------
-    // I/O Registers (0xFF00 - 0xFF7F)
+    // Work RAM (0xC000 - 0xDFFF)
     // ---------------------------
-    if (addr < 0xFF80) {
-        io_write(gb, addr, value);
+    if (addr >= 0xC000) {
+        gb->wram[addr - 0xC000] = value;
         return;
     }
 
     // ---------------------------
-    // HRAM 0xFF80 - 0xFFFE 127 bytes
+    // External RAM (0xA000 - 0xBFFF) - Cartridge RAM
     // ---------------------------
-    if (addr < 0xFFFF) {
-        gb->hram[addr - 0xFF80] = value;
+    if (addr >= 0xA000) {
+        mbc_ram_write(gb, addr, value);
         return;
     }
 
     // ---------------------------
-    // Interrupt Enable (0xFFFF)
+    // VRAM (0x8000 - 0x9FFF) - 8 KB
     // ---------------------------
-    if (addr == 0xFFFF) {
-        gb->ie_register = value;
+    if (addr >= 0x8000) {
+        // TODO: Check if VRAM is accessible (not during PPU mode 3)
+        u16 offset = addr - 0x8000;
+        if (offset < 0x1800 && gb->vram[offset] != value)
+            gb->tile_dirty[offset >> 4] = true;
+        gb->vram[offset] = value;
+        return;
     }
+
+    // ---------------------------
+    // ROM (0x0000 - 0x7FFF) - MBC Control
+    // ---------------------------
+    // Writes to ROM control the MBC (bank switching, RAM enable, etc)
+    mbc_write(gb, addr, value);
 }
 
 // I/O Register handlers (NOTE: stubbed for now)
 u8 io_read(GameBoy *gb, u16 addr) {
     // TODO: Implement I/O registers for each component
     // For now, return 0xFF (open bus)
-    (void)gb;
-    (void)addr;
 
     // Some registers have default values
     switch (addr) {
         case 0xFF00: // Joypad
             return 0xCF;
-        case 0xFF40: // LCD Control
-            return 0x91;
-        case 0xFF47: // BG Palette
-            return 0xFC;
+        case 0xFF04: // DIV, TIMA, TMA, TAC
+        case 0xFF05:
+        case 0xFF06:
+        case 0xFF07:
+            return timer_read(gb, addr);
+        case 0xFF0F: // Interrupt Flag, upper 3 bits read as 1
+            return gb->if_register | 0xE0;
+        case 0xFF40: // LCD registers
+        case 0xFF41:
+        case 0xFF42:
+        case 0xFF43:
+        case 0xFF44:
+        case 0xFF45:
+        case 0xFF46:
+        case 0xFF47:
+        case 0xFF48:
+        case 0xFF49:
+        case 0xFF4A:
+        case 0xFF4B:
+            return ppu_read(gb, addr);
         default:
             return 0xFF;
     }
@@ -235,9 +316,34 @@ u8 io_read(GameBoy *gb, u16 addr) {
 void io_write(GameBoy *gb, u16 addr, u8 value) {
     // TODO: Implement I/O registers for each component
     // For now, just ignore writes
-    (void)gb;
-    (void)addr;
-    (void)value;
+    switch (addr) {
+        case 0xFF04: // DIV, TIMA, TMA, TAC
+        case 0xFF05:
+        case 0xFF06:
+        case 0xFF07:
+            timer_write(gb, addr, value);
+            break;
+        case 0xFF0F: // Interrupt Flag
+            gb->if_register = value & 0x1F;
+            cpu_update_interrupts(&gb->cpu);
+            break;
+        case 0xFF40: // LCD registers
+        case 0xFF41:
+        case 0xFF42:
+        case 0xFF43:
+        case 0xFF44:
+        case 0xFF45:
+        case 0xFF46:
+        case 0xFF47:
+        case 0xFF48:
+        case 0xFF49:
+        case 0xFF4A:
+        case 0xFF4B:
+            ppu_write(gb, addr, value);
+            break;
+        default:
+            break;
+    }
 }
 
 // Debug Helper: Dump Memory Region
@@ -1,9 +1,18 @@
 // src/core/cartridge.c
 #include <stdio.h>
 #include <core/cartridge.h>
+#include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__unix__) || defined(__APPLE__)
+#define CART_HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 /*
 EXIT CODES
 return 1; -->  failed to open
@@ -14,8 +23,56 @@ return 5; -->  fread failed
 return -1; --> cart header checksum failed
 */
 
-// Load ROM from disk & parse header
-int cart_load(Cartridge *cart, const char *path) {
+// Map the image read-only, pages come straight from the page cache and are shared by everyone
+// mapping the same file. Returns false if mmap isn't available or fails
+static bool cart_map_rom(Cartridge *cart, FILE *rom_f, unsigned flags) {
+#ifdef CART_HAVE_MMAP
+    if (flags & CART_LOAD_NO_MMAP)
+        return false;
+
+    void *rom = mmap(NULL, cart->rom_size, PROT_READ, MAP_PRIVATE, fileno(rom_f), 0);
+    if (rom == MAP_FAILED)
+        return false;
+
+    // Only hints, failures are harmless
+    if (flags & CART_LOAD_WILLNEED)
+        madvise(rom, cart->rom_size, MADV_WILLNEED);
+#ifdef MADV_HUGEPAGE
+    if (flags & CART_LOAD_HUGEPAGE)
+        madvise(rom, cart->rom_size, MADV_HUGEPAGE);
+#endif
+
+    cart->rom        = rom;
+    cart->rom_mapped = true;
+    return true;
+#else
+    (void)cart;
+    (void)rom_f;
+    (void)flags;
+    return false;
+#endif
+}
+
+// Release the ROM image, however it was loaded
+static void cart_free_rom(Cartridge *cart) {
+    if (!cart->rom)
+        return;
+
+#ifdef CART_HAVE_MMAP
+    if (cart->rom_mapped)
+        munmap(cart->rom, cart->rom_size);
+    else
+        free(cart->rom);
+#else
+    free(cart->rom);
+#endif
+
+    cart->rom        = NULL;
+    cart->rom_mapped = false;
+}
+
+// Read the image (mapped or copied), parse and verify its header
+static int cart_load_image(Cartridge *cart, const char *path, unsigned flags) {
     // Open the ROM file
     FILE *rom_f = fopen(path, "rb");
     if (!rom_f) {
@@ -35,22 +92,25 @@ int cart_load(Cartridge *cart, const char *path) {
         return 2;
     }
 
-    // Allocate memory for ROM from heap
-    cart->rom = malloc(cart->rom_size);
-    if (!cart->rom) {
-        fclose(rom_f);
-        fprintf(stderr, "Failed to allocate ROM memory\n");
-        return 3;
-    }
-
-    // Read the ROM data from file into ROM buffer
-    size_t read = fread(cart->rom, 1, cart->rom_size, rom_f);
-    fclose(rom_f);
+    cart->rom_mapped = false;
+    if (!cart_map_rom(cart, rom_f, flags)) {
+        // Allocate memory for ROM from heap
+        cart->rom = malloc(cart->rom_size);
+        if (!cart->rom) {
+            fclose(rom_f);
+            fprintf(stderr, "Failed to allocate ROM memory\n");
+            return 3;
+        }
 
-    if (read != cart->rom_size) {
-        fprintf(stderr, "Failed to read ROM\n");
-        return 5;
+        // Read the ROM data from file into ROM buffer
+        size_t read = fread(cart->rom, 1, cart->rom_size, rom_f);
+        if (read != cart->rom_size) {
+            fclose(rom_f);
+            fprintf(stderr, "Failed to read ROM\n");
+            return 5;
+        }
     }
+    fclose(rom_f);
 
     // Copy raw header (located at 0x100 - 0x14F)
     memcpy(&cart->raw_header, cart->rom + 0x0100, sizeof(RawRomHeader));
@@ -64,17 +124,18 @@ int cart_load(Cartridge *cart, const char *path) {
         cart_unload(cart);
         return -1;
     }
-    printf("\nCartridge header checksum: OK\n");
 
-    // Allocate RAM if needed (based on ram_size_code)
+    return 0;
+}
+
+// Allocate RAM if needed (based on ram_size_code)
+static int cart_alloc_ram(Cartridge *cart) {
     cart->ram_size = get_ram_size(cart->header.ram_size_code);
     if (cart->ram_size > 0) {
         cart->ram = calloc(1, cart->ram_size);
         if (!cart->ram) {
             fprintf(stderr, "Failed to allocate cartridge RAM\n");
-            free(cart->rom);
-            cart->rom      = NULL;
-            cart->rom_size = 0;
+            cart_unload(cart);
             return 4;
         }
     } else {
@@ -84,22 +145,291 @@ int cart_load(Cartridge *cart, const char *path) {
     return 0;
 }
 
+// Load ROM from disk & parse header
+int cart_load(Cartridge *cart, const char *path) {
+    return cart_load_flags(cart, path, CART_LOAD_WILLNEED);
+}
+
+int cart_load_flags(Cartridge *cart, const char *path, unsigned flags) {
+    cart->image        = NULL;
+    cart->rom_borrowed = false;
+
+    int err            = cart_load_image(cart, path, flags);
+    if (err != 0)
+        return err;
+    printf("\nCartridge header checksum: OK\n");
+
+    return cart_alloc_ram(cart);
+}
+
+// ---------------------------------------------
+// Shared ROM images
+// ---------------------------------------------
+static RomImage       *rom_images;
+static pthread_mutex_t rom_images_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Identity and size of a file, without reading it
+static int cart_peek_file(const char *path, RomFileId *id, size_t *size) {
+    FILE *rom_f = fopen(path, "rb");
+    if (!rom_f) {
+        fprintf(stderr, "Failed to open ROM: %s\n", path);
+        return 1;
+    }
+
+    memset(id, 0, sizeof(*id));
+#ifdef CART_HAVE_MMAP
+    struct stat st;
+    if (fstat(fileno(rom_f), &st) == 0) {
+        id->dev   = (u64)st.st_dev;
+        id->ino   = (u64)st.st_ino;
+#ifdef __APPLE__
+        id->mtime = (u64)st.st_mtimespec.tv_sec * 1000000000u + (u64)st.st_mtimespec.tv_nsec;
+#else
+        id->mtime = (u64)st.st_mtim.tv_sec * 1000000000u + (u64)st.st_mtim.tv_nsec;
+#endif
+    }
+#endif
+
+    fseek(rom_f, 0, SEEK_END);
+    *size = ftell(rom_f);
+    fclose(rom_f);
+
+    if (*size < 0x0150) {
+        fprintf(stderr, "ROM file too small\n");
+        return 2;
+    }
+    return 0;
+}
+
+static bool same_file(const RomFileId *a, const RomFileId *b) {
+    return a->ino && a->dev == b->dev && a->ino == b->ino && a->mtime == b->mtime;
+}
+
+// Registered image loaded from the same file, or with loaded given, one with the same contents
+// Called with the registry locked
+static RomImage *find_image(const RomFileId *id, size_t size, const Cartridge *loaded) {
+    for (RomImage *image = rom_images; image; image = image->next) {
+        if (image->rom_size != size)
+            continue;
+        if (loaded ? memcmp(image->rom, loaded->rom, size) == 0 : same_file(&image->file, id))
+            return image;
+    }
+    return NULL;
+}
+
+// Registry entry for a freshly loaded image: an identical registered one (loaded is released), or
+// loaded itself, held until the last reference goes. NULL when out of memory
+static RomImage *add_image(Cartridge *loaded, const RomFileId *id) {
+    RomImage *image = find_image(id, loaded->rom_size, loaded);
+    if (image) {
+        cart_free_rom(loaded);
+        return image;
+    }
+
+    if (!(image = calloc(1, sizeof(RomImage)))) {
+        cart_free_rom(loaded);
+        return NULL;
+    }
+    image->rom        = loaded->rom;
+    image->rom_size   = loaded->rom_size;
+    image->rom_mapped = loaded->rom_mapped;
+    image->file       = *id;
+    image->raw_header = loaded->raw_header;
+    image->header     = loaded->header;
+    image->next       = rom_images;
+    rom_images        = image;
+    return image;
+}
+
+int cart_load_shared(Cartridge *cart, const char *path) {
+    RomFileId id;
+    size_t    size;
+
+    int       err = cart_peek_file(path, &id, &size);
+    if (err != 0)
+        return err;
+
+    pthread_mutex_lock(&rom_images_lock);
+
+    // Another file may hold the same image (a copy), but its header can't tell (ROM hacks,
+    // homebrew without checksums): anything but the same file is compared in full
+    RomImage *image = find_image(&id, size, NULL);
+    if (!image) {
+        Cartridge loaded = {0};
+
+        err              = cart_load_image(&loaded, path, CART_LOAD_WILLNEED);
+        if (err == 0 && !(image = add_image(&loaded, &id)))
+            err = 3;
+        if (err != 0) {
+            pthread_mutex_unlock(&rom_images_lock);
+            return err;
+        }
+    }
+    image->refs++;
+
+    pthread_mutex_unlock(&rom_images_lock);
+
+    cart->rom          = image->rom;
+    cart->rom_size     = image->rom_size;
+    cart->rom_mapped   = image->rom_mapped;
+    cart->rom_borrowed = false;
+    cart->raw_header   = image->raw_header;
+    cart->header       = image->header;
+    cart->image        = image;
+
+    return cart_alloc_ram(cart);
+}
+
+// Drop one reference, the last one frees the image
+static void cart_release_image(RomImage *image) {
+    pthread_mutex_lock(&rom_images_lock);
+
+    if (--image->refs == 0) {
+        RomImage **link = &rom_images;
+        while (*link != image)
+            link = &(*link)->next;
+        *link           = image->next;
+
+        Cartridge owner = {.rom = image->rom, .rom_size = image->rom_size,
+                           .rom_mapped = image->rom_mapped};
+        cart_free_rom(&owner);
+        free(image);
+    }
+
+    pthread_mutex_unlock(&rom_images_lock);
+}
+
+unsigned cart_shared_images(void) {
+    unsigned count = 0;
+
+    pthread_mutex_lock(&rom_images_lock);
+    for (const RomImage *image = rom_images; image; image = image->next)
+        count++;
+    pthread_mutex_unlock(&rom_images_lock);
+
+    return count;
+}
+
+void cart_share_rom(Cartridge *dst, const Cartridge *src) {
+    if (src->image) {
+        pthread_mutex_lock(&rom_images_lock);
+        src->image->refs++;
+        pthread_mutex_unlock(&rom_images_lock);
+    }
+
+    dst->rom          = src->rom;
+    dst->rom_size     = src->rom_size;
+    dst->rom_mapped   = src->rom_mapped;
+    dst->rom_borrowed = !src->image;
+    dst->image        = src->image;
+    dst->raw_header   = src->raw_header;
+    dst->header       = src->header;
+}
+
 // Unload the cart: Free the allocated memory for RAM & ROM
 void cart_unload(Cartridge *cart) {
-    if (cart->rom) {
-        free(cart->rom);
-        cart->rom = NULL;
+    if (cart->image) {
+        cart_release_image(cart->image);
+        cart->image      = NULL;
+        cart->rom        = NULL;
+        cart->rom_mapped = false;
+    } else if (cart->rom_borrowed) {
+        cart->rom          = NULL;
+        cart->rom_mapped   = false;
+        cart->rom_borrowed = false;
+    } else {
+        cart_free_rom(cart);
     }
 
     if (cart->ram) {
+#ifdef CART_HAVE_MMAP
+        if (cart->ram_mapped) {
+            cart_sync_save(cart, true);
+            munmap(cart->ram, cart->ram_size);
+        } else {
+            free(cart->ram);
+        }
+#else
         free(cart->ram);
-        cart->ram = NULL;
+#endif
+        cart->ram        = NULL;
+        cart->ram_mapped = false;
     }
 
     cart->rom_size = 0;
     cart->ram_size = 0;
 }
 
+// ---------------------------------------------
+// Battery-backed saves
+// ---------------------------------------------
+bool cart_has_battery(u8 cart_type) {
+    return strstr(get_cart_type_name(cart_type), "BATTERY") != NULL;
+}
+
+bool cart_save_path(const char *rom_path, char *out, size_t size) {
+    const char *slash = strrchr(rom_path, '/');
+    const char *dot   = strrchr(rom_path, '.');
+    size_t      stem  = (dot && (!slash || dot > slash)) ? (size_t)(dot - rom_path)
+                                                         : strlen(rom_path);
+
+    int         len   = snprintf(out, size, "%.*s.sav", (int)stem, rom_path);
+    return len >= 0 && (size_t)len < size;
+}
+
+int cart_map_save(Cartridge *cart, const char *path) {
+#ifdef CART_HAVE_MMAP
+    if (!cart->ram || cart->ram_mapped)
+        return -1;
+
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "Failed to open save file: %s\n", path);
+        return -1;
+    }
+
+    // Shorter (or new) files are zero-extended, longer ones (RTC footers) are left alone
+    struct stat st;
+    if (fstat(fd, &st) != 0 ||
+        ((size_t)st.st_size < cart->ram_size && ftruncate(fd, (off_t)cart->ram_size) != 0)) {
+        fprintf(stderr, "Failed to size save file: %s\n", path);
+        close(fd);
+        return -1;
+    }
+    bool fresh = st.st_size == 0;
+
+    u8 *ram = mmap(NULL, cart->ram_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd); // The mapping keeps the file open
+    if (ram == MAP_FAILED) {
+        fprintf(stderr, "Failed to map save file: %s\n", path);
+        return -1;
+    }
+
+    // New save: start from what the game already wrote
+    if (fresh)
+        memcpy(ram, cart->ram, cart->ram_size);
+
+    free(cart->ram);
+    cart->ram        = ram;
+    cart->ram_mapped = true;
+    return 0;
+#else
+    (void)cart;
+    (void)path;
+    return -1;
+#endif
+}
+
+void cart_sync_save(Cartridge *cart, bool wait) {
+#ifdef CART_HAVE_MMAP
+    if (cart->ram_mapped)
+        msync(cart->ram, cart->ram_size, wait ? MS_SYNC : MS_ASYNC);
+#else
+    (void)cart;
+    (void)wait;
+#endif
+}
+
 // Parse raw header into usable format
 void parse_header(const RawRomHeader *raw, CartHeader *out) {
     // Make title null terminated
@@ -1,9 +1,11 @@
 // src/core/cpu/cpu.c
 #include <core/cpu/cpu.h>
+#include <core/cpu/cpu_decode.h>
+#include <core/cpu/cpu_flags.h>
 #include <core/bus.h>
 #include <gbemu.h>
 #include <string.h>
-#include <utils.h>
+#include <core/utils.h>
 
 void cpu_init(CPU *cpu, GameBoy *gb) {
     memset(cpu, 0, sizeof(CPU));
@@ -26,73 +28,52 @@ void cpu_reset(CPU *cpu) {
     cpu->sp     = 0xFFFE;
     cpu->pc     = 0x0100; // Start after boot ROM
 
-    cpu->ime    = false;
-    cpu->halted = false;
+    cpu->ime         = false;
+    cpu->halted      = false;
+    cpu->int_pending = 0; // Neither IME nor HALT
 }
 
 // Register Pair Read Functions
 u16 cpu_read_af(const CPU *cpu) {
-    return MAKE_U16(cpu->regs.a, cpu->regs.f);
-}
-
-u16 cpu_read_bc(const CPU *cpu) {
-    return MAKE_U16(cpu->regs.b, cpu->regs.c);
-}
-
-u16 cpu_read_de(const CPU *cpu) {
-    return MAKE_U16(cpu->regs.d, cpu->regs.e);
-}
-
-u16 cpu_read_hl(const CPU *cpu) {
-    return MAKE_U16(cpu->regs.h, cpu->regs.l);
+    return MAKE_U16(cpu->regs.a, cpu->lazy.pending ? flags_from_lazy(cpu) : cpu->regs.f);
 }
 
 // Register Pair Write Functions
 void cpu_write_af(CPU *cpu, u16 value) {
     cpu->regs.a = GET_HIGH_BYTE(value);
-    cpu->regs.f = GET_LOW_BYTE(value) & 0xF0; // Lower 4 bits always zero
-}
-
-void cpu_write_bc(CPU *cpu, u16 value) {
-    cpu->regs.b = GET_HIGH_BYTE(value);
-    cpu->regs.c = GET_LOW_BYTE(value);
-}
-
-void cpu_write_de(CPU *cpu, u16 value) {
-    cpu->regs.d = GET_HIGH_BYTE(value);
-    cpu->regs.e = GET_LOW_BYTE(value);
-}
-
-void cpu_write_hl(CPU *cpu, u16 value) {
-    cpu->regs.h = GET_HIGH_BYTE(value);
-    cpu->regs.l = GET_LOW_BYTE(value);
+    flags_set(cpu, GET_LOW_BYTE(value) & 0xF0); // Lower 4 bits always zero
 }
 
 // Flag Helpers
 bool cpu_get_flag(CPU *cpu, u8 flag) {
-    return (cpu->regs.f & flag) != 0;
+    return (flags_get(cpu) & flag) != 0;
 }
 
 void cpu_set_flag(CPU *cpu, u8 flag) {
-    cpu->regs.f |= flag;
+    flags_set(cpu, flags_get(cpu) | flag);
 }
 
 void cpu_clear_flag(CPU *cpu, u8 flag) {
-    cpu->regs.f &= ~flag;
+    flags_set(cpu, flags_get(cpu) & ~flag);
+}
+
+void cpu_sync_flags(CPU *cpu) {
+    flags_get(cpu);
 }
 
 // Main execute function
 u8 cpu_step(CPU *cpu) {
-    if (cpu->halted) {
-        // TODO: Check for interrupts here
-        // If interrupt pending, unhalt
+    // An interrupt to dispatch or the end of HALT, one test for both
+    if (cpu->int_pending)
+        return cpu_service_interrupt(cpu);
+    if (cpu->halted)
         return 4;
-    }
 
     // Check if IME should be enabled (from previous EI)
     if (cpu->ime_scheduled) {
         cpu->ime           = true;
         cpu->ime_scheduled = false;
+        cpu_update_interrupts(cpu);
     }
 
     // FETCH: Read OpCode at PC, increment PC
@@ -103,3 +84,149 @@ u8 cpu_step(CPU *cpu) {
 
     return cycles;
 }
+
+// ---------------------------------------------
+// Interrupts
+// ---------------------------------------------
+void cpu_update_interrupts(CPU *cpu) {
+    u8 enabled       = (cpu->ime || cpu->halted) ? 0x1F : 0;
+    cpu->int_pending = cpu->gb->ie_register & cpu->gb->if_register & enabled;
+}
+
+// Only called with int_pending set
+u8 cpu_service_interrupt(CPU *cpu) {
+    GameBoy *gb     = cpu->gb;
+    u8       cycles = 0;
+
+    // Any enabled interrupt ends HALT, even with IME off
+    if (cpu->halted) {
+        cpu->halted = false;
+        cycles      = 4;
+    }
+
+    if (cpu->ime) {
+        // Lowest bit first: VBlank has the highest priority
+        u8 n = 0;
+        while (!CHECK_BIT(cpu->int_pending, n))
+            n++;
+
+        gb->if_register &= ~BIT(n);
+        cpu->ime         = false;
+        cpu->sp         -= 2;
+        mmu_write16(gb, cpu->sp, cpu->pc);
+        cpu->pc = INT_VECTOR_BASE + 8 * n;
+        cycles += INT_DISPATCH_CYCLES;
+    }
+
+    cpu_update_interrupts(cpu);
+    return cycles;
+}
+
+// ---------------------------------------------
+// Idle fast-forward
+// cpu_run never runs past the next scheduled event, so up to its deadline a halted CPU stays
+// halted and a polled register keeps its value
+// ---------------------------------------------
+// Same total as stepping 4 cycles at a time
+u32 cpu_halt_skip(u64 now, u64 end) {
+    if (now >= end)
+        return 0;
+    return (u32)((end - now + 3) & ~(u64)3);
+}
+
+// Registers a polling loop may wait on: IF, STAT, LY and HRAM/IE, which only change when an
+// event fires or the CPU itself writes them (DIV and TIMA advance on their own)
+static bool idle_poll_target(u8 a8) {
+    return a8 == 0x0F || a8 == 0x41 || a8 == 0x44 || a8 >= 0x80;
+}
+
+bool cpu_is_idle_loop(CPU *cpu, u16 pc) {
+    GameBoy *gb = cpu->gb;
+    u8       op_cmp, op_jr;
+
+    if (mmu_read(gb, pc) != 0xF0 || !idle_poll_target(mmu_read(gb, pc + 1)))
+        return false;
+
+    op_cmp = mmu_read(gb, pc + 2);
+    op_jr  = mmu_read(gb, pc + 4);
+
+    return (op_cmp == 0xFE || op_cmp == 0xE6) && (op_jr == 0x20 || op_jr == 0x28) &&
+           mmu_read(gb, pc + 5) == (u8)-IDLE_LOOP_LEN;
+}
+
+// Leaves the last partial iteration to be executed normally
+u32 cpu_idle_loop_skip(u64 now, u64 end) {
+    if (now >= end)
+        return 0;
+    return (u32)((end - now) / IDLE_LOOP_CYCLES * IDLE_LOOP_CYCLES);
+}
+
+// Run loop of the table-driven core, also used by lockstep.c in either build
+// Replays decoded blocks (cpu_decode.c) and single-steps whatever can't be cached
+// Stops at the first instruction boundary at or past the budget or the next scheduled event, or
+// right after HALT. A CPU that is already halted idles up to that point
+u32 cpu_run_blocks(CPU *cpu, u32 budget, DecodeCache *rom_cache) {
+    GameBoy *gb    = cpu->gb;
+    u64      start = gb->cycles;
+
+    // Budget end or next event, lowered if an instruction schedules an earlier one
+    sched_set_deadline(&gb->sched, start + budget);
+
+    // Nothing can end HALT before the deadline
+    if (cpu->halted) {
+        if (!cpu->int_pending) {
+            gb->cycles += cpu_halt_skip(gb->cycles, gb->sched.deadline);
+            return (u32)(gb->cycles - start);
+        }
+        gb->cycles += cpu_step(cpu);
+    }
+
+    while (gb->cycles < gb->sched.deadline && !cpu->halted) {
+        if (cpu->int_pending) {
+            gb->cycles += cpu_service_interrupt(cpu);
+            continue;
+        }
+
+        const DecodedBlock *blk = rom_cache ? cpu_decode_rom_block(rom_cache, gb, cpu->pc) : NULL;
+        if (!blk)
+            blk = cpu_decode_block(gb, cpu->pc);
+        if (!blk) {
+            gb->cycles += cpu_step(cpu);
+            continue;
+        }
+
+        // EI always ends a block, so IME can only become due before its first instruction
+        if (cpu->ime_scheduled) {
+            cpu->ime           = true;
+            cpu->ime_scheduled = false;
+            cpu_update_interrupts(cpu);
+        }
+
+        u32 gen      = gb->map_gen;
+        u16 block_pc = cpu->pc;
+        u8  i;
+        for (i = 0; i < blk->count; i++) {
+            cpu->pc++; // Skip the opcode, handlers fetch their own operands
+            gb->cycles += blk->handlers[i](cpu);
+
+            // Out of budget, the code under the block changed (self-modifying code, bank switch,
+            // map rebuild), or an interrupt became due (a write to IE or IF, IME turning on)
+            if (gb->cycles >= gb->sched.deadline || gb->map_gen != gen || cpu->int_pending)
+                break;
+        }
+
+        // Polling loop went around once: every further iteration until the budget is identical
+        if (i == blk->count && blk->idle_loop && cpu->pc == block_pc)
+            gb->cycles += cpu_idle_loop_skip(gb->cycles, gb->sched.deadline);
+    }
+
+    cpu_sync_flags(cpu);
+    return (u32)(gb->cycles - start);
+}
+
+#ifndef GB_THREADED_CORE
+// cpu_threaded.c provides cpu_run otherwise
+u32 cpu_run(CPU *cpu, u32 budget) {
+    return cpu_run_blocks(cpu, budget, NULL);
+}
+#endif
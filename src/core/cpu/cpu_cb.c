@@ -0,0 +1,190 @@
+// src/core/cpu/cpu_cb.c
+// CB-prefixed instructions: rotates, shifts, SWAP, BIT, RES and SET
+//
+// The 256 handlers are generated: each opcode is an operation (bits 7-3) applied to an operand
+// (bits 2-0: B, C, D, E, H, L, (HL), A), so one macro per operation expands it over the eight
+// operands, and the table lists them row by row. Every handler skips the CB opcode byte itself,
+// so the decode cache can store them directly (see cpu_get_cb_handler).
+#include <core/cpu/cpu.h>
+#include <core/cpu/cpu_exec.h>
+#include <core/cpu/cpu_flags.h>
+#include <core/bus.h>
+#include <gbemu.h>
+#include <core/utils.h>
+
+// ---------------------------------------------
+// Operations
+// Return the result and set the flags, Z from the result unless noted
+// ---------------------------------------------
+static inline u8 shift_flags(CPU *cpu, u8 result, u8 carry) {
+    flags_set(cpu, (result ? 0 : FLAG_ZERO) | (carry ? FLAG_CARRY : 0));
+    return result;
+}
+
+static inline u8 op_rlc(CPU *cpu, u8 v) {
+    return shift_flags(cpu, (u8)(v << 1) | (v >> 7), v >> 7);
+}
+
+static inline u8 op_rrc(CPU *cpu, u8 v) {
+    return shift_flags(cpu, (u8)(v >> 1) | (u8)(v << 7), v & 1);
+}
+
+static inline u8 op_rl(CPU *cpu, u8 v) {
+    return shift_flags(cpu, (u8)(v << 1) | flags_carry(cpu), v >> 7);
+}
+
+static inline u8 op_rr(CPU *cpu, u8 v) {
+    return shift_flags(cpu, (u8)(v >> 1) | (flags_carry(cpu) << 7), v & 1);
+}
+
+static inline u8 op_sla(CPU *cpu, u8 v) {
+    return shift_flags(cpu, (u8)(v << 1), v >> 7);
+}
+
+static inline u8 op_sra(CPU *cpu, u8 v) {
+    return shift_flags(cpu, (v >> 1) | (v & 0x80), v & 1);
+}
+
+static inline u8 op_swap(CPU *cpu, u8 v) {
+    return shift_flags(cpu, (u8)(v << 4) | (v >> 4), 0);
+}
+
+static inline u8 op_srl(CPU *cpu, u8 v) {
+    return shift_flags(cpu, v >> 1, v & 1);
+}
+
+// Z from the tested bit, H set, C kept
+static inline void op_bit(CPU *cpu, u8 v, u8 bit) {
+    u8 carry = flags_carry(cpu) ? FLAG_CARRY : 0;
+    flags_set(cpu, (CHECK_BIT(v, bit) ? 0 : FLAG_ZERO) | FLAG_HF_CARRY | carry);
+}
+
+// ---------------------------------------------
+// Handler generators
+// Register operands take 8 T-cycles, (HL) 16, or 12 for BIT which doesn't write it back
+// ---------------------------------------------
+#define FOR_EACH_REG(GEN, ...)                                                                     \
+    GEN(__VA_ARGS__, b)                                                                            \
+    GEN(__VA_ARGS__, c)                                                                            \
+    GEN(__VA_ARGS__, d)                                                                            \
+    GEN(__VA_ARGS__, e)                                                                            \
+    GEN(__VA_ARGS__, h)                                                                            \
+    GEN(__VA_ARGS__, l)                                                                            \
+    GEN(__VA_ARGS__, a)
+
+// Rotates, shifts and SWAP
+#define GEN_SHIFT_REG(op, r)                                                                       \
+    static u8 cb_##op##_##r(CPU *cpu) {                                                            \
+        cpu->pc++;                                                                                 \
+        cpu->regs.r = op_##op(cpu, cpu->regs.r);                                                   \
+        return 8;                                                                                  \
+    }
+
+#define GEN_SHIFT(op)                                                                              \
+    FOR_EACH_REG(GEN_SHIFT_REG, op)                                                                \
+    static u8 cb_##op##_hl(CPU *cpu) {                                                             \
+        u16 addr = cpu_read_hl(cpu);                                                               \
+        cpu->pc++;                                                                                 \
+        mmu_write(cpu->gb, addr, op_##op(cpu, mmu_read(cpu->gb, addr)));                           \
+        return 16;                                                                                 \
+    }
+
+// BIT n
+#define GEN_BIT_REG(n, r)                                                                          \
+    static u8 cb_bit##n##_##r(CPU *cpu) {                                                          \
+        cpu->pc++;                                                                                 \
+        op_bit(cpu, cpu->regs.r, n);                                                               \
+        return 8;                                                                                  \
+    }
+
+#define GEN_BIT(n)                                                                                 \
+    FOR_EACH_REG(GEN_BIT_REG, n)                                                                   \
+    static u8 cb_bit##n##_hl(CPU *cpu) {                                                           \
+        cpu->pc++;                                                                                 \
+        op_bit(cpu, mmu_read(cpu->gb, cpu_read_hl(cpu)), n);                                       \
+        return 12;                                                                                 \
+    }
+
+// RES n and SET n, no flags
+#define GEN_RES_SET_REG(n, r)                                                                      \
+    static u8 cb_res##n##_##r(CPU *cpu) {                                                          \
+        cpu->pc++;                                                                                 \
+        cpu->regs.r = CLEAR_BIT(cpu->regs.r, n);                                                   \
+        return 8;                                                                                  \
+    }                                                                                              \
+    static u8 cb_set##n##_##r(CPU *cpu) {                                                          \
+        cpu->pc++;                                                                                 \
+        cpu->regs.r = SET_BIT(cpu->regs.r, n);                                                     \
+        return 8;                                                                                  \
+    }
+
+#define GEN_RES_SET(n)                                                                             \
+    FOR_EACH_REG(GEN_RES_SET_REG, n)                                                               \
+    static u8 cb_res##n##_hl(CPU *cpu) {                                                           \
+        u16 addr = cpu_read_hl(cpu);                                                               \
+        cpu->pc++;                                                                                 \
+        mmu_write(cpu->gb, addr, CLEAR_BIT(mmu_read(cpu->gb, addr), n));                           \
+        return 16;                                                                                 \
+    }                                                                                              \
+    static u8 cb_set##n##_hl(CPU *cpu) {                                                           \
+        u16 addr = cpu_read_hl(cpu);                                                               \
+        cpu->pc++;                                                                                 \
+        mmu_write(cpu->gb, addr, SET_BIT(mmu_read(cpu->gb, addr), n));                             \
+        return 16;                                                                                 \
+    }
+
+// ---------------------------------------------
+// Handlers
+// ---------------------------------------------
+GEN_SHIFT(rlc)
+GEN_SHIFT(rrc)
+GEN_SHIFT(rl)
+GEN_SHIFT(rr)
+GEN_SHIFT(sla)
+GEN_SHIFT(sra)
+GEN_SHIFT(swap)
+GEN_SHIFT(srl)
+
+GEN_BIT(0)
+GEN_BIT(1)
+GEN_BIT(2)
+GEN_BIT(3)
+GEN_BIT(4)
+GEN_BIT(5)
+GEN_BIT(6)
+GEN_BIT(7)
+
+GEN_RES_SET(0)
+GEN_RES_SET(1)
+GEN_RES_SET(2)
+GEN_RES_SET(3)
+GEN_RES_SET(4)
+GEN_RES_SET(5)
+GEN_RES_SET(6)
+GEN_RES_SET(7)
+
+// ---------------------------------------------
+// CB instruction table (256 entries)
+// One row of eight per operation, operands in opcode order
+// ---------------------------------------------
+#define ROW(op) cb_##op##_b, cb_##op##_c, cb_##op##_d, cb_##op##_e, cb_##op##_h, cb_##op##_l,     \
+                cb_##op##_hl, cb_##op##_a
+
+static const InstrFunc cb_table[256] = {
+    ROW(rlc),  ROW(rrc),  ROW(rl),   ROW(rr),   ROW(sla),  ROW(sra),  ROW(swap), ROW(srl),  // 0x00
+    ROW(bit0), ROW(bit1), ROW(bit2), ROW(bit3), ROW(bit4), ROW(bit5), ROW(bit6), ROW(bit7), // 0x40
+    ROW(res0), ROW(res1), ROW(res2), ROW(res3), ROW(res4), ROW(res5), ROW(res6), ROW(res7), // 0x80
+    ROW(set0), ROW(set1), ROW(set2), ROW(set3), ROW(set4), ROW(set5), ROW(set6), ROW(set7), // 0xC0
+};
+
+#undef ROW
+
+InstrFunc cpu_get_cb_handler(u8 opcode) {
+    return cb_table[opcode];
+}
+
+// PREFIX CB
+// The CB opcode is left for the handler to skip, its cycles include the prefix
+u8 instr_prefix_cb(CPU *cpu) {
+    return cb_table[mmu_read(cpu->gb, cpu->pc)](cpu);
+}
@@ -0,0 +1,170 @@
+// src/core/cpu/cpu_decode.c
+#include <core/cpu/cpu_decode.h>
+#include <core/cpu/cpu.h>
+#include <core/bus.h>
+#include <gbemu.h>
+#include <stdint.h>
+#include <string.h>
+
+// ---------------------------------------------
+// Opcode layout
+// Length in bytes, DECODE_END marks instructions that close a block (jumps, calls, returns,
+// RST, HALT, STOP, EI), 0 marks illegal opcodes, which are never cached
+// ---------------------------------------------
+#define DECODE_END 0x80
+#define E DECODE_END
+
+// clang-format off
+static const u8 decode_info[256] = {
+//  x0     x1     x2     x3     x4     x5     x6     x7     x8     x9     xA     xB     xC     xD     xE     xF
+    1,     3,     1,     1,     1,     1,     2,     1,     3,     1,     1,     1,     1,     1,     2,     1,     // 0x
+    2 | E, 3,     1,     1,     1,     1,     2,     1,     2 | E, 1,     1,     1,     1,     1,     2,     1,     // 1x
+    2 | E, 3,     1,     1,     1,     1,     2,     1,     2 | E, 1,     1,     1,     1,     1,     2,     1,     // 2x
+    2 | E, 3,     1,     1,     1,     1,     2,     1,     2 | E, 1,     1,     1,     1,     1,     2,     1,     // 3x
+    1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     // 4x
+    1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     // 5x
+    1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     // 6x
+    1,     1,     1,     1,     1,     1,     1 | E, 1,     1,     1,     1,     1,     1,     1,     1,     1,     // 7x
+    1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     // 8x
+    1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     // 9x
+    1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     // Ax
+    1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     1,     // Bx
+    1 | E, 1,     3 | E, 3 | E, 3 | E, 1,     2,     1 | E, 1 | E, 1 | E, 3 | E, 2,     3 | E, 3 | E, 2,     1 | E, // Cx
+    1 | E, 1,     3 | E, 0,     3 | E, 1,     2,     1 | E, 1 | E, 1 | E, 3 | E, 0,     3 | E, 0,     2,     1 | E, // Dx
+    2,     1,     1,     0,     0,     1,     2,     1 | E, 2,     1 | E, 3,     0,     0,     0,     2,     1 | E, // Ex
+    2,     1,     1,     1,     0,     1,     2,     1 | E, 2,     1,     3,     1 | E, 0,     0,     2,     1 | E, // Fx
+};
+// clang-format on
+
+#undef E
+
+#define DECODE_LENGTH(info) ((info) & 0x03)
+
+// ---------------------------------------------
+// Lookup
+// ---------------------------------------------
+static DecodedBlock *block_slot(DecodeCache *cache, const u8 *host) {
+    uintptr_t key = (uintptr_t)host;
+    return &cache->blocks[(key ^ (key >> 9)) & (DECODE_CACHE_SIZE - 1)];
+}
+
+// Clear the write_map entries of every page aliasing this host page (WRAM and its echo)
+static void trap_page(GameBoy *gb, u8 *host_page) {
+    for (int i = 0; i < 0x100; i++) {
+        if (gb->write_map[i] == host_page) {
+            gb->decode.trapped[i] = host_page;
+            gb->write_map[i]      = NULL;
+        }
+    }
+}
+
+// Decode the block at pc up to its end or the end of the page, false if it would be empty
+static bool decode_into(DecodedBlock *blk, GameBoy *gb, const u8 *base, u16 pc) {
+    u16 offset = pc & (MMU_PAGE_SIZE - 1);
+    u8  count  = 0;
+
+    while (count < DECODE_BLOCK_MAX && offset < MMU_PAGE_SIZE) {
+        u8 opcode = base[offset];
+        u8 info   = decode_info[opcode];
+
+        if (info == 0)
+            break;
+
+        // CB instructions go straight to their own handler, unless the second byte is on the next
+        // page (the block's page is all that's trapped)
+        if (opcode == 0xCB && offset + 1 < MMU_PAGE_SIZE)
+            blk->handlers[count++] = cpu_get_cb_handler(base[offset + 1]);
+        else
+            blk->handlers[count++] = cpu_get_handler(opcode);
+        offset += DECODE_LENGTH(info);
+
+        if (info & DECODE_END)
+            break;
+    }
+
+    if (count == 0) {
+        blk->host = NULL;
+        return false;
+    }
+
+    blk->host      = base + (pc & (MMU_PAGE_SIZE - 1));
+    blk->count     = count;
+    blk->idle_loop = count == 3 && cpu_is_idle_loop(&gb->cpu, pc);
+    return true;
+}
+
+const DecodedBlock *cpu_decode_block(GameBoy *gb, u16 pc) {
+    u8  page = pc >> MMU_PAGE_SHIFT;
+    u8 *base = gb->read_map[page];
+
+    // VRAM tile data is written through the slow path without a trap, so it can't hold cached code
+    if (!base || (pc >= 0x8000 && pc < 0x9800))
+        return NULL;
+
+    const u8     *host = base + (pc & (MMU_PAGE_SIZE - 1));
+    DecodedBlock *blk  = block_slot(&gb->decode, host);
+
+    if (blk->host == host)
+        return blk;
+
+    // Miss: decode up to the end of the block or of the page
+    if (!decode_into(blk, gb, base, pc))
+        return NULL;
+
+    // Code in RAM: route writes to its page through the slow path
+    if (gb->write_map[page] == base)
+        trap_page(gb, base);
+
+    return blk;
+}
+
+// ---------------------------------------------
+// Shared ROM blocks
+// ---------------------------------------------
+const DecodedBlock *cpu_decode_rom_block(DecodeCache *cache, GameBoy *gb, u16 pc) {
+    u8 *base = gb->read_map[pc >> MMU_PAGE_SHIFT];
+
+    if (pc >= 0x8000 || !base)
+        return NULL;
+
+    const u8     *host = base + (pc & (MMU_PAGE_SIZE - 1));
+    DecodedBlock *blk  = block_slot(cache, host);
+
+    if (blk->host == host)
+        return blk;
+    return decode_into(blk, gb, base, pc) ? blk : NULL;
+}
+
+// ---------------------------------------------
+// Invalidation
+// ---------------------------------------------
+void cpu_decode_invalidate(GameBoy *gb, u16 addr) {
+    u8 *host_page = gb->decode.trapped[addr >> MMU_PAGE_SHIFT];
+
+    if (!host_page)
+        return;
+
+    for (int i = 0; i < 0x100; i++) {
+        if (gb->decode.trapped[i] == host_page) {
+            gb->write_map[i]      = host_page;
+            gb->decode.trapped[i] = NULL;
+        }
+    }
+
+    uintptr_t lo = (uintptr_t)host_page;
+    for (int i = 0; i < DECODE_CACHE_SIZE; i++) {
+        DecodedBlock *blk = &gb->decode.blocks[i];
+        if ((uintptr_t)blk->host - lo < MMU_PAGE_SIZE)
+            blk->host = NULL;
+    }
+
+    // A block running from this page stops after the current instruction
+    gb->map_gen++;
+}
+
+void cpu_decode_flush(GameBoy *gb) {
+    for (int i = 0; i < DECODE_CACHE_SIZE; i++)
+        gb->decode.blocks[i].host = NULL;
+
+    memset(gb->decode.trapped, 0, sizeof(gb->decode.trapped));
+}
@@ -1,16 +1,32 @@
 // src/core/cpu/cpu_exec.c
 #include <core/cpu/cpu.h>
 #include <core/cpu/cpu_exec.h>
+#include <core/cpu/cpu_flags.h>
 #include <core/bus.h>
 #include <gbemu.h>
 #include <core/utils.h>
 
+// ============================================================================
+// NOTE: Stack
+// Pairs go on and off the stack as one 16-bit access (see mmu_write16)
+// ============================================================================
+static inline void push16(CPU *cpu, u16 value) {
+    cpu->sp -= 2;
+    mmu_write16(cpu->gb, cpu->sp, value);
+}
+
+static inline u16 pop16(CPU *cpu) {
+    u16 value  = mmu_read16(cpu->gb, cpu->sp);
+    cpu->sp   += 2;
+    return value;
+}
+
 // ============================================================================
 // NOTE: CPU Control
 // ============================================================================
 u8 instr_nop(CPU *cpu) {
     (void)cpu;
-    return 0;
+    return 4;
 }
 
 // NOTE: Full STOP implementation requires joypad
@@ -31,30 +47,29 @@ u8 instr_stop(CPU *cpu) {
     // - Stop LCD display
     // - Wake on button press
 
-    return 0;
+    return 4;
 }
 
+// Wakes up on any enabled interrupt, even with IME off: the handler runs if IME is set, else
+// execution continues after HALT (see cpu_service_interrupt)
+// TODO: HALT bug (IME off with an interrupt already pending)
 u8 instr_halt(CPU *cpu) {
     cpu->halted = true;
-
-    // TODO: When implementing interrupts:
-    // - CPU enters low-power mode
-    // - Wakes up when interrupt occurs (even if IME is disabled)
-    // - If IME is enabled, interrupt handler runs
-    // - If IME is disabled, execution continues after HALT
-    return 0;
+    cpu_update_interrupts(cpu);
+    return 4;
 }
 
 // Disable interrupts
 u8 instr_di(CPU *cpu) {
     cpu->ime = false;
-    return 0;
+    cpu_update_interrupts(cpu);
+    return 4;
 }
 
 // Enable interrupts
 u8 instr_ei(CPU *cpu) {
     cpu->ime_scheduled = true; // Set after NEXT instruction
-    return 0;
+    return 4;
 }
 
 // TODO: When implementing extended instruction set
@@ -67,283 +82,283 @@ u8 instr_ei(CPU *cpu) {
 // Immediate loads
 u8 instr_ld_b_n(CPU *cpu) {
     cpu->regs.b = mmu_read(cpu->gb, cpu->pc++);
-    return 0;
+    return 8;
 }
 
 u8 instr_ld_c_n(CPU *cpu) {
     cpu->regs.c = mmu_read(cpu->gb, cpu->pc++);
-    return 0;
+    return 8;
 }
 
 u8 instr_ld_d_n(CPU *cpu) {
     cpu->regs.d = mmu_read(cpu->gb, cpu->pc++);
-    return 0;
+    return 8;
 }
 
 u8 instr_ld_e_n(CPU *cpu) {
     cpu->regs.e = mmu_read(cpu->gb, cpu->pc++);
-    return 0;
+    return 8;
 }
 
 u8 instr_ld_h_n(CPU *cpu) {
     cpu->regs.h = mmu_read(cpu->gb, cpu->pc++);
-    return 0;
+    return 8;
 }
 
 u8 instr_ld_l_n(CPU *cpu) {
     cpu->regs.l = mmu_read(cpu->gb, cpu->pc++);
-    return 0;
+    return 8;
 }
 
 u8 instr_ld_a_n(CPU *cpu) {
     cpu->regs.a = mmu_read(cpu->gb, cpu->pc++);
-    return 0;
+    return 8;
 }
 
 // Register <-> Register
 u8 instr_ld_b_b(CPU *cpu) {
     cpu->regs.b = cpu->regs.b;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_b_c(CPU *cpu) {
     cpu->regs.b = cpu->regs.c;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_b_d(CPU *cpu) {
     cpu->regs.b = cpu->regs.d;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_b_e(CPU *cpu) {
     cpu->regs.b = cpu->regs.e;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_b_h(CPU *cpu) {
     cpu->regs.b = cpu->regs.h;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_b_l(CPU *cpu) {
     cpu->regs.b = cpu->regs.l;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_b_a(CPU *cpu) {
     cpu->regs.b = cpu->regs.a;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_c_b(CPU *cpu) {
     cpu->regs.c = cpu->regs.b;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_c_c(CPU *cpu) {
     cpu->regs.c = cpu->regs.c;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_c_d(CPU *cpu) {
     cpu->regs.c = cpu->regs.d;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_c_e(CPU *cpu) {
     cpu->regs.c = cpu->regs.e;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_c_h(CPU *cpu) {
     cpu->regs.c = cpu->regs.h;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_c_l(CPU *cpu) {
     cpu->regs.c = cpu->regs.l;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_c_a(CPU *cpu) {
     cpu->regs.c = cpu->regs.a;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_d_b(CPU *cpu) {
     cpu->regs.d = cpu->regs.b;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_d_c(CPU *cpu) {
     cpu->regs.d = cpu->regs.c;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_d_d(CPU *cpu) {
     cpu->regs.d = cpu->regs.d;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_d_e(CPU *cpu) {
     cpu->regs.d = cpu->regs.e;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_d_h(CPU *cpu) {
     cpu->regs.d = cpu->regs.h;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_d_l(CPU *cpu) {
     cpu->regs.d = cpu->regs.l;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_d_a(CPU *cpu) {
     cpu->regs.d = cpu->regs.a;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_e_b(CPU *cpu) {
     cpu->regs.e = cpu->regs.b;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_e_c(CPU *cpu) {
     cpu->regs.e = cpu->regs.c;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_e_d(CPU *cpu) {
     cpu->regs.e = cpu->regs.d;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_e_e(CPU *cpu) {
     cpu->regs.e = cpu->regs.e;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_e_h(CPU *cpu) {
     cpu->regs.e = cpu->regs.h;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_e_l(CPU *cpu) {
     cpu->regs.e = cpu->regs.l;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_e_a(CPU *cpu) {
     cpu->regs.e = cpu->regs.a;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_h_b(CPU *cpu) {
     cpu->regs.h = cpu->regs.b;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_h_c(CPU *cpu) {
     cpu->regs.h = cpu->regs.c;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_h_d(CPU *cpu) {
     cpu->regs.h = cpu->regs.d;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_h_e(CPU *cpu) {
     cpu->regs.h = cpu->regs.e;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_h_h(CPU *cpu) {
     cpu->regs.h = cpu->regs.h;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_h_l(CPU *cpu) {
     cpu->regs.h = cpu->regs.l;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_h_a(CPU *cpu) {
     cpu->regs.h = cpu->regs.a;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_l_b(CPU *cpu) {
     cpu->regs.l = cpu->regs.b;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_l_c(CPU *cpu) {
     cpu->regs.l = cpu->regs.c;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_l_d(CPU *cpu) {
     cpu->regs.l = cpu->regs.d;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_l_e(CPU *cpu) {
     cpu->regs.l = cpu->regs.e;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_l_h(CPU *cpu) {
     cpu->regs.l = cpu->regs.h;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_l_l(CPU *cpu) {
     cpu->regs.l = cpu->regs.l;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_l_a(CPU *cpu) {
     cpu->regs.l = cpu->regs.a;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_a_b(CPU *cpu) {
     cpu->regs.a = cpu->regs.b;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_a_c(CPU *cpu) {
     cpu->regs.a = cpu->regs.c;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_a_d(CPU *cpu) {
     cpu->regs.a = cpu->regs.d;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_a_e(CPU *cpu) {
     cpu->regs.a = cpu->regs.e;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_a_h(CPU *cpu) {
     cpu->regs.a = cpu->regs.h;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_a_l(CPU *cpu) {
     cpu->regs.a = cpu->regs.l;
-    return 0;
+    return 4;
 }
 
 u8 instr_ld_a_a(CPU *cpu) {
     cpu->regs.a = cpu->regs.a;
-    return 0;
+    return 4;
 }
 
 // =================================
@@ -354,86 +369,86 @@ u8 instr_ld_a_a(CPU *cpu) {
 u8 instr_ld_b_mem_hl(CPU *cpu) {
     u16 addr    = cpu_read_hl(cpu);
     cpu->regs.b = mmu_read(cpu->gb, addr);
-    return 0;
+    return 8;
 }
 
 u8 instr_ld_c_mem_hl(CPU *cpu) {
     u16 addr    = cpu_read_hl(cpu);
     cpu->regs.c = mmu_read(cpu->gb, addr);
-    return 0;
+    return 8;
 }
 
 u8 instr_ld_d_mem_hl(CPU *cpu) {
     u16 addr    = cpu_read_hl(cpu);
     cpu->regs.d = mmu_read(cpu->gb, addr);
-    return 0;
+    return 8;
 }
 
 u8 instr_ld_e_mem_hl(CPU *cpu) {
     u16 addr    = cpu_read_hl(cpu);
     cpu->regs.e = mmu_read(cpu->gb, addr);
-    return 0;
+    return 8;
 }
 
 u8 instr_ld_h_mem_hl(CPU *cpu) {
     u16 addr    = cpu_read_hl(cpu);
     cpu->regs.h = mmu_read(cpu->gb, addr);
-    return 0;
+    return 8;
 }
 
 u8 instr_ld_l_mem_hl(CPU *cpu) {
     u16 addr    = cpu_read_hl(cpu);
     cpu->regs.l = mmu_read(cpu->gb, addr);
-    return 0;
+    return 8;
 }
 
 u8 instr_ld_a_mem_hl(CPU *cpu) {
     u16 addr    = cpu_read_hl(cpu);
     cpu->regs.a = mmu_read(cpu->gb, addr);
-    return 0;
+    return 8;
 }
 
 // [hl] <- register
 u8 instr_ld_mem_hl_b(CPU *cpu) {
     u16 addr = cpu_read_hl(cpu);
     mmu_write(cpu->gb, addr, cpu->regs.b);
-    return 0;
+    return 8;
 }
 
 u8 instr_ld_mem_hl_c(CPU *cpu) {
     u16 addr = cpu_read_hl(cpu);
     mmu_write(cpu->gb, addr, cpu->regs.c);
-    return 0;
+    return 8;
 }
 
 u8 instr_ld_mem_hl_d(CPU *cpu) {
     u16 addr = cpu_read_hl(cpu);
     mmu_write(cpu->gb, addr, cpu->regs.d);
-    return 0;
+    return 8;
 }
 
 u8 instr_ld_mem_hl_e(CPU *cpu) {
     u16 addr = cpu_read_hl(cpu);
     mmu_write(cpu->gb, addr, cpu->regs.e);
-    return 0;
+    return 8;
 }
 
 u8 instr_ld_mem_hl_h(CPU *cpu) {
     u16 addr = cpu_read_hl(cpu);
     mmu_write(cpu->gb, addr, cpu->regs.h);
-    return 0;
+    return 8;
 }
 
 u8 instr_ld_mem_hl_l(CPU *cpu) {
     u16 addr = cpu_read_hl(cpu);
     mmu_write(cpu->gb, addr, cpu->regs.l);
-    return 0;
+    return 8;
 }
 
 u8 instr_ld_mem_hl_a(CPU *cpu) {
     u16 addr = cpu_read_hl(cpu);
     mmu_write(cpu->gb, addr, cpu->regs.a);
-    return 0;
+    return 8;
 }
 
 // [hl] <- immediate (n)
@@ -441,7 +456,7 @@ u8 instr_ld_mem_hl_n(CPU *cpu) {
     u16 addr  = cpu_read_hl(cpu);
     u8  value = mmu_read(cpu->gb, cpu->pc++); // Read immediate value
     mmu_write(cpu->gb, addr, value);
-    return 0;
+    return 12;
 }
 
 // ld hl, sp+e8
@@ -453,22 +468,23 @@ u8 instr_ld_hl_sp_e8(CPU *cpu) {
     u8  sp_low  = sp & 0xFF;
     u8  val     = (u8)e8;
 
-    cpu->regs.f = 0; // Z=0, N=0
+    u8  f       = 0; // Z=0, N=0
 
     if (check_half_carry_add(sp_low, val))
-        cpu->regs.f |= FLAG_HF_CARRY;
+        f |= FLAG_HF_CARRY;
 
     if (check_carry_add(sp_low, val))
-        cpu->regs.f |= FLAG_CARRY;
+        f |= FLAG_CARRY;
 
+    flags_set(cpu, f);
     cpu_write_hl(cpu, result);
-    return 0;
+    return 12;
 }
 
 // ld sp, hl
 u8 instr_ld_sp_hl(CPU *cpu) {
     cpu->sp = cpu_read_hl(cpu);
-    return 0;
+    return 8;
 }
 
 // =================================
@@ -477,58 +493,50 @@ u8 instr_ld_sp_hl(CPU *cpu) {
 u8 instr_ld_mem_bc_a(CPU *cpu) {
     u16 addr = cpu_read_bc(cpu);
     mmu_write(cpu->gb, addr, cpu->regs.a);
-    return 0;
+    return 8;
 }
 
 u8 instr_ld_mem_de_a(CPU *cpu) {
     u16 addr = cpu_read_de(cpu);
     mmu_write(cpu->gb, addr, cpu->regs.a);
-    return 0;
+    return 8;
 }
 
 u8 instr_ld_a_mem_bc(CPU *cpu) {
     u16 addr    = cpu_read_bc(cpu);
     cpu->regs.a = mmu_read(cpu->gb, addr);
-    return 0;
+    return 8;
 }
 
 u8 instr_ld_a_mem_de(CPU *cpu) {
     u16 addr    = cpu_read_de(cpu);
     cpu->regs.a = mmu_read(cpu->gb, addr);
-    return 0;
+    return 8;
 }
 
 // https://rgbds.gbdev.io/docs/v1.0.1/gbz80.7#LD__HLI_,A
 // [hl] <- a and then increment hl
 u8 instr_ld_mem_hli_a(CPU *cpu) {
-    u16 addr = cpu_read_hl(cpu);
-    mmu_write(cpu->gb, addr, cpu->regs.a);
-    cpu_write_hl(cpu, addr + 1); // Increment hl
-    return 0;
+    mmu_write(cpu->gb, cpu->regs.hl++, cpu->regs.a);
+    return 8;
 }
 
 // [hl] <- a and then decrement hl
 u8 instr_ld_mem_hld_a(CPU *cpu) {
-    u16 addr = cpu_read_hl(cpu);
-    mmu_write(cpu->gb, addr, cpu->regs.a);
-    cpu_write_hl(cpu, addr - 1); // Decrement hl
-    return 0;
+    mmu_write(cpu->gb, cpu->regs.hl--, cpu->regs.a);
+    return 8;
 }
 
 // a <- [hl] and then decrement hl
 u8 instr_ld_a_mem_hld(CPU *cpu) {
-    u8 value    = cpu_read_hl(cpu);
-    cpu->regs.a = value;
-    cpu_write_hl(cpu, value - 1); // Decrement hl
-    return 0;
+    cpu->regs.a = mmu_read(cpu->gb, cpu->regs.hl--);
+    return 8;
 }
 
 // a <- [hl] and then increment hl
 u8 instr_ld_a_mem_hli(CPU *cpu) {
-    u8 value    = cpu_read_hl(cpu);
-    cpu->regs.a = value;
-    cpu_write_hl(cpu, value + 1); // Increment hl
-    return 0;
+    cpu->regs.a = mmu_read(cpu->gb, cpu->regs.hl++);
+    return 8;
 }
 
 // [0xFF00 + a8] <- a
@@ -536,7 +544,7 @@ u8 instr_ldh_mem_a8_a(CPU *cpu) {
     u8  offset = mmu_read(cpu->gb, cpu->pc++);
     u16 addr   = 0xFF00 + offset;
     mmu_write(cpu->gb, addr, cpu->regs.a);
-    return 0;
+    return 12;
 }
 
 // [0xFF00 + c] <- a
@@ -544,7 +552,7 @@ u8 instr_ldh_mem_c_a(CPU *cpu) {
     u8  offset = cpu->regs.c;
     u16 addr   = 0xFF00 + offset;
     mmu_write(cpu->gb, addr, cpu->regs.a);
-    return 0;
+    return 8;
 }
 
 // a <- [0xFF00 + a8]
@@ -552,7 +560,7 @@ u8 instr_ldh_a_mem_a8(CPU *cpu) {
     u8  offset  = mmu_read(cpu->gb, cpu->pc++);
     u16 addr    = 0xFF00 + offset;
     cpu->regs.a = mmu_read(cpu->gb, addr);
-    return 0;
+    return 12;
 }
 
 // a <- [0xFF00 + c]
@@ -560,7 +568,7 @@ u8 instr_ldh_a_mem_c(CPU *cpu) {
     u8  offset  = cpu->regs.c;
     u16 addr    = 0xFF00 + offset;
     cpu->regs.a = mmu_read(cpu->gb, addr);
-    return 0;
+    return 8;
 }
 
 // [a16] <- a
@@ -569,7 +577,7 @@ u8 instr_ld_mem_a16_a(CPU *cpu) {
     u8  hi   = mmu_read(cpu->gb, cpu->pc++);
     u16 addr = MAKE_U16(hi, lo);
     mmu_write(cpu->gb, addr, cpu->regs.a);
-    return 0;
+    return 16;
 }
 
 // a <- [a16]
@@ -578,7 +586,7 @@ u8 instr_ld_a_mem_a16(CPU *cpu) {
     u8  hi      = mmu_read(cpu->gb, cpu->pc++);
     u16 addr    = MAKE_U16(hi, lo);
     cpu->regs.a = mmu_read(cpu->gb, addr);
-    return 0;
+    return 16;
 }
 
 // [a16] <- SP
@@ -592,7 +600,7 @@ u8 instr_ld_mem_a16_sp(CPU *cpu) {
     mmu_write(cpu->gb, addr, GET_LOW_BYTE(sp));
     mmu_write(cpu->gb, addr + 1, GET_HIGH_BYTE(sp));
 
-    return 0;
+    return 20;
 }
 
 // ============================================================================
@@ -603,28 +611,28 @@ u8 instr_ld_bc_nn(CPU *cpu) {
     u8 lo = mmu_read(cpu->gb, cpu->pc++);
     u8 hi = mmu_read(cpu->gb, cpu->pc++);
     cpu_write_bc(cpu, MAKE_U16(hi, lo));
-    return 0;
+    return 12;
 }
 
 u8 instr_ld_de_nn(CPU *cpu) {
     u8 lo = mmu_read(cpu->gb, cpu->pc++);
     u8 hi = mmu_read(cpu->gb, cpu->pc++);
     cpu_write_de(cpu, MAKE_U16(hi, lo));
-    return 0;
+    return 12;
 }
 
 u8 instr_ld_hl_nn(CPU *cpu) {
     u8 lo = mmu_read(cpu->gb, cpu->pc++);
     u8 hi = mmu_read(cpu->gb, cpu->pc++);
     cpu_write_hl(cpu, MAKE_U16(hi, lo));
-    return 0;
+    return 12;
 }
 
 u8 instr_ld_sp_nn(CPU *cpu) {
     u8 lo   = mmu_read(cpu->gb, cpu->pc++);
     u8 hi   = mmu_read(cpu->gb, cpu->pc++);
     cpu->sp = MAKE_U16(hi, lo);
-    return 0;
+    return 12;
 }
 
 // ============================================================================
@@ -640,150 +648,44 @@ u8 instr_ld_sp_nn(CPU *cpu) {
 // H - Set if overflow from 3rd bit
 // ----------------------------------------------
 u8 instr_inc_b(CPU *cpu) {
-    u8   result    = cpu->regs.b + 1;
-
-    // Preserve carry flag
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = 0;
-
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;     // Set Z if result = 0
-    if ((cpu->regs.b & 0x0F) == 0x0F) // Set H if lower nibble overlfows
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY; // Restore C (if it was set)
-
-    cpu->regs.b = result;
-    return 0;
+    cpu->regs.b = alu_inc(cpu, cpu->regs.b);
+    return 4;
 }
 
 u8 instr_inc_c(CPU *cpu) {
-    u8   result    = cpu->regs.c + 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.c & 0x0F) == 0x0F)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.c = result;
-    return 0;
+    cpu->regs.c = alu_inc(cpu, cpu->regs.c);
+    return 4;
 }
 
 u8 instr_inc_d(CPU *cpu) {
-    u8   result    = cpu->regs.d + 1;
-
-    // Preserve carry flag
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = 0;
-
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.d & 0x0F) == 0x0F)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.d = result;
-    return 0;
+    cpu->regs.d = alu_inc(cpu, cpu->regs.d);
+    return 4;
 }
 
 u8 instr_inc_e(CPU *cpu) {
-    u8   result    = cpu->regs.e + 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = 0;
-
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.e & 0x0F) == 0x0F)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.e = result;
-    return 0;
+    cpu->regs.e = alu_inc(cpu, cpu->regs.e);
+    return 4;
 }
 
 u8 instr_inc_h(CPU *cpu) {
-    u8   result    = cpu->regs.h + 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = 0;
-
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.h & 0x0F) == 0x0F)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.h = result;
-    return 0;
+    cpu->regs.h = alu_inc(cpu, cpu->regs.h);
+    return 4;
 }
 
 u8 instr_inc_l(CPU *cpu) {
-    u8   result    = cpu->regs.l + 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = 0;
-
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.l & 0x0F) == 0x0F)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.l = result;
-    return 0;
+    cpu->regs.l = alu_inc(cpu, cpu->regs.l);
+    return 4;
 }
 
 u8 instr_inc_a(CPU *cpu) {
-    u8   result    = cpu->regs.a + 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = 0;
-
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.a & 0x0F) == 0x0F)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_inc(cpu, cpu->regs.a);
+    return 4;
 }
 
 u8 instr_inc_mem_hl(CPU *cpu) {
-    u16  addr      = cpu_read_hl(cpu);
-    u8   value     = mmu_read(cpu->gb, addr);
-    u8   result    = value + 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = 0;
-
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((value & 0x0F) == 0x0F)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    mmu_write(cpu->gb, addr, result);
-    return 0;
+    u16 addr = cpu_read_hl(cpu);
+    mmu_write(cpu->gb, addr, alu_inc(cpu, mmu_read(cpu->gb, addr)));
+    return 12;
 }
 
 // DEC r8
@@ -794,142 +696,44 @@ u8 instr_inc_mem_hl(CPU *cpu) {
 // H - Set if borrow from 4th bit
 // ----------------------------------------------
 u8 instr_dec_b(CPU *cpu) {
-    u8   result    = cpu->regs.b - 1;
-
-    // Preserve carry flag
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;  // Set Z if result is zero
-    if ((cpu->regs.b & 0x0F) == 0) // Set H if lower nibble underflows
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY; // Restore the carry flag
-
-    cpu->regs.b = result;
-    return 0;
+    cpu->regs.b = alu_dec(cpu, cpu->regs.b);
+    return 4;
 }
 
 u8 instr_dec_c(CPU *cpu) {
-    u8   result    = cpu->regs.c - 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.c & 0x0F) == 0)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.c = result;
-    return 0;
+    cpu->regs.c = alu_dec(cpu, cpu->regs.c);
+    return 4;
 }
 
 u8 instr_dec_d(CPU *cpu) {
-    u8   result    = cpu->regs.d - 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.d & 0x0F) == 0)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.d = result;
-    return 0;
+    cpu->regs.d = alu_dec(cpu, cpu->regs.d);
+    return 4;
 }
 
 u8 instr_dec_e(CPU *cpu) {
-    u8   result    = cpu->regs.e - 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.e & 0x0F) == 0)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.e = result;
-    return 0;
+    cpu->regs.e = alu_dec(cpu, cpu->regs.e);
+    return 4;
 }
 
 u8 instr_dec_h(CPU *cpu) {
-    u8   result    = cpu->regs.h - 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.h & 0x0F) == 0)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.h = result;
-    return 0;
+    cpu->regs.h = alu_dec(cpu, cpu->regs.h);
+    return 4;
 }
 
 u8 instr_dec_l(CPU *cpu) {
-    u8   result    = cpu->regs.l - 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.l & 0x0F) == 0)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.l = result;
-    return 0;
+    cpu->regs.l = alu_dec(cpu, cpu->regs.l);
+    return 4;
 }
 
 u8 instr_dec_a(CPU *cpu) {
-    u8   result    = cpu->regs.a - 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((cpu->regs.a & 0x0F) == 0)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_dec(cpu, cpu->regs.a);
+    return 4;
 }
 
 u8 instr_dec_mem_hl(CPU *cpu) {
-    u16  addr      = cpu_read_hl(cpu);
-    u8   value     = mmu_read(cpu->gb, addr);
-    u8   result    = value - 1;
-
-    bool old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-
-    cpu->regs.f    = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if ((value & 0x0F) == 0)
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (old_carry)
-        cpu->regs.f |= FLAG_CARRY;
-
-    mmu_write(cpu->gb, addr, result);
-    return 0;
+    u16 addr = cpu_read_hl(cpu);
+    mmu_write(cpu->gb, addr, alu_dec(cpu, mmu_read(cpu->gb, addr)));
+    return 12;
 }
 
 // ADD A, r8
@@ -941,156 +745,50 @@ u8 instr_dec_mem_hl(CPU *cpu) {
 // C - Set if overflow from bit 7
 // ----------------------------------------------
 u8 instr_add_a_b(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 b        = cpu->regs.b;
-    u8 result   = a + b;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_add(a, b))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_add(a, b))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.b, 0);
+    return 4;
 }
 
 u8 instr_add_a_c(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 c        = cpu->regs.c;
-    u8 result   = a + c;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_add(a, c))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_add(a, c))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.c, 0);
+    return 4;
 }
 
 u8 instr_add_a_d(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 d        = cpu->regs.d;
-    u8 result   = a + d;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_add(a, d))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_add(a, d))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.d, 0);
+    return 4;
 }
 
 u8 instr_add_a_e(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 e        = cpu->regs.e;
-    u8 result   = a + e;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_add(a, e))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_add(a, e))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.e, 0);
+    return 4;
 }
 
 u8 instr_add_a_h(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 h        = cpu->regs.h;
-    u8 result   = a + h;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_add(a, h))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_add(a, h))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.h, 0);
+    return 4;
 }
 
 u8 instr_add_a_l(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 l        = cpu->regs.l;
-    u8 result   = a + l;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_add(a, l))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_add(a, l))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.l, 0);
+    return 4;
 }
 
 u8 instr_add_a_a(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 result   = a + a;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_add(a, a))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_add(a, a))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.a, 0);
+    return 4;
 }
 
 u8 instr_add_a_mem_hl(CPU *cpu) {
-    u8  a       = cpu->regs.a;
-    u16 address = cpu_read_hl(cpu);
-    u8  value   = mmu_read(cpu->gb, address);
-    u8  result  = a + value;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_add(a, a))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_add(a, a))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    u8 value = mmu_read(cpu->gb, cpu_read_hl(cpu));
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, value, 0);
+    return 8;
 }
 
 u8 instr_add_a_n(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 n        = mmu_read(cpu->gb, cpu->pc++);
-    u8 result   = a + n;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_add(a, n))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_add(a, n))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    u8 value = mmu_read(cpu->gb, cpu->pc++);
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, value, 0);
+    return 8;
 }
 
 // ADC A, r8
@@ -1102,165 +800,50 @@ u8 instr_add_a_n(CPU *cpu) {
 // C - Set if overflow from bit 7
 // ----------------------------------------------
 u8 instr_adc_a_b(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 b        = cpu->regs.b;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY) ? 1 : 0;
-    u8 result   = a + b + carry;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_adc(a, b, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_adc(a, b, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.b, flags_carry(cpu));
+    return 4;
 }
 
 u8 instr_adc_a_c(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 c        = cpu->regs.c;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY) ? 1 : 0;
-    u8 result   = a + c + carry;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_adc(a, c, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_adc(a, c, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.c, flags_carry(cpu));
+    return 4;
 }
 
 u8 instr_adc_a_d(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 d        = cpu->regs.d;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY) ? 1 : 0;
-    u8 result   = a + d + carry;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_adc(a, d, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_adc(a, d, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.d, flags_carry(cpu));
+    return 4;
 }
 
 u8 instr_adc_a_e(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 e        = cpu->regs.e;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY) ? 1 : 0;
-    u8 result   = a + e + carry;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_adc(a, e, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_adc(a, e, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.e, flags_carry(cpu));
+    return 4;
 }
 
 u8 instr_adc_a_h(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 h        = cpu->regs.h;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY) ? 1 : 0;
-    u8 result   = a + h + carry;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_adc(a, h, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_adc(a, h, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.h, flags_carry(cpu));
+    return 4;
 }
 
 u8 instr_adc_a_l(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 l        = cpu->regs.l;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY) ? 1 : 0;
-    u8 result   = a + l + carry;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_adc(a, l, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_adc(a, l, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.l, flags_carry(cpu));
+    return 4;
 }
 
 u8 instr_adc_a_a(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY) ? 1 : 0;
-    u8 result   = a + a + carry;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_adc(a, a, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_adc(a, a, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, cpu->regs.a, flags_carry(cpu));
+    return 4;
 }
 
 u8 instr_adc_a_mem_hl(CPU *cpu) {
-    u8  a       = cpu->regs.a;
-    u8  carry   = cpu_get_flag(cpu, FLAG_CARRY) ? 1 : 0;
-    u16 addr    = cpu_read_hl(cpu);
-    u8  value   = mmu_read(cpu->gb, addr);
-    u8  result  = a + value + carry;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_adc(a, value, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_adc(a, value, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    u8 value = mmu_read(cpu->gb, cpu_read_hl(cpu));
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, value, flags_carry(cpu));
+    return 8;
 }
 
 u8 instr_adc_a_n(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY) ? 1 : 0;
-    u8 value    = mmu_read(cpu->gb, cpu->pc++);
-    u8 result   = a + value + carry;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_adc(a, value, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_adc(a, value, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    u8 value = mmu_read(cpu->gb, cpu->pc++);
+    cpu->regs.a = alu_add(cpu, cpu->regs.a, value, flags_carry(cpu));
+    return 8;
 }
 
 // SUB A, r8
@@ -1272,146 +855,51 @@ u8 instr_adc_a_n(CPU *cpu) {
 // C - Set if borrow (r8 > A)
 // ----------------------------------------------
 u8 instr_sub_a_b(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 b        = cpu->regs.b;
-    u8 result   = a - b;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, b))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, b))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.b, 0);
+    return 4;
 }
 
 u8 instr_sub_a_c(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 c        = cpu->regs.c;
-    u8 result   = a - c;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, c))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, c))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.c, 0);
+    return 4;
 }
 
 u8 instr_sub_a_d(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 d        = cpu->regs.d;
-    u8 result   = a - d;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, d))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, d))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.d, 0);
+    return 4;
 }
 
 u8 instr_sub_a_e(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 e        = cpu->regs.e;
-    u8 result   = a - e;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, e))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, e))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.e, 0);
+    return 4;
 }
 
 u8 instr_sub_a_h(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 h        = cpu->regs.h;
-    u8 result   = a - h;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, h))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, h))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.h, 0);
+    return 4;
 }
 
 u8 instr_sub_a_l(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 l        = cpu->regs.l;
-    u8 result   = a - l;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, l))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, l))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.l, 0);
+    return 4;
 }
 
 u8 instr_sub_a_a(CPU *cpu) {
     cpu->regs.a = 0;
-    cpu->regs.f = FLAG_ZERO | FLAG_SUBT; // Z=1, N=1, H=0, C=0
-    return 0;
+    flags_set(cpu, FLAG_ZERO | FLAG_SUBT); // Z=1, N=1, H=0, C=0
+    return 4;
 }
 
 u8 instr_sub_a_mem_hl(CPU *cpu) {
-    u8  a       = cpu->regs.a;
-    u16 address = cpu_read_hl(cpu);
-    u8  value   = mmu_read(cpu->gb, address);
-    u8  result  = a - value;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, value))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, value))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    u8 value = mmu_read(cpu->gb, cpu_read_hl(cpu));
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, value, 0);
+    return 8;
 }
 
 u8 instr_sub_a_n(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 n        = mmu_read(cpu->gb, cpu->pc++);
-    u8 result   = a - n;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, n))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, n))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    u8 value = mmu_read(cpu->gb, cpu->pc++);
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, value, 0);
+    return 8;
 }
 
 // SBC A, r8
@@ -1423,165 +911,50 @@ u8 instr_sub_a_n(CPU *cpu) {
 // C - Set if borrow (r8 + carry > A)
 // ----------------------------------------------
 u8 instr_sbc_a_b(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 b        = cpu->regs.b;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY);
-    u8 result   = a - b - carry;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sbc(a, b, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sbc(a, b, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.b, flags_carry(cpu));
+    return 4;
 }
 
 u8 instr_sbc_a_c(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 c        = cpu->regs.c;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY);
-    u8 result   = a - c - carry;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sbc(a, c, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sbc(a, c, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.c, flags_carry(cpu));
+    return 4;
 }
 
 u8 instr_sbc_a_d(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 d        = cpu->regs.d;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY);
-    u8 result   = a - d - carry;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sbc(a, d, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sbc(a, d, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.d, flags_carry(cpu));
+    return 4;
 }
 
 u8 instr_sbc_a_e(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 e        = cpu->regs.e;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY);
-    u8 result   = a - e - carry;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sbc(a, e, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sbc(a, e, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.e, flags_carry(cpu));
+    return 4;
 }
 
 u8 instr_sbc_a_h(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 h        = cpu->regs.h;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY);
-    u8 result   = a - h - carry;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sbc(a, h, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sbc(a, h, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.h, flags_carry(cpu));
+    return 4;
 }
 
 u8 instr_sbc_a_l(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 l        = cpu->regs.l;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY);
-    u8 result   = a - l - carry;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sbc(a, l, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sbc(a, l, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.l, flags_carry(cpu));
+    return 4;
 }
 
 u8 instr_sbc_a_a(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY);
-    u8 result   = a - a - carry;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (carry) {
-        cpu->regs.f |= FLAG_HF_CARRY;
-        cpu->regs.f |= FLAG_CARRY;
-    }
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, cpu->regs.a, flags_carry(cpu));
+    return 4;
 }
 
 u8 instr_sbc_a_mem_hl(CPU *cpu) {
-    u8  a       = cpu->regs.a;
-    u8  carry   = cpu_get_flag(cpu, FLAG_CARRY);
-    u16 addr    = cpu_read_hl(cpu);
-    u8  value   = mmu_read(cpu->gb, addr);
-    u8  result  = a - value - carry;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sbc(a, value, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sbc(a, value, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    u8 value = mmu_read(cpu->gb, cpu_read_hl(cpu));
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, value, flags_carry(cpu));
+    return 8;
 }
 
 u8 instr_sbc_a_n(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 carry    = cpu_get_flag(cpu, FLAG_CARRY);
-    u8 n        = mmu_read(cpu->gb, cpu->pc++);
-    u8 result   = a - n - carry;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sbc(a, n, carry))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sbc(a, n, carry))
-        cpu->regs.f |= FLAG_CARRY;
-
-    cpu->regs.a = result;
-    return 0;
+    u8 value = mmu_read(cpu->gb, cpu->pc++);
+    cpu->regs.a = alu_sub(cpu, cpu->regs.a, value, flags_carry(cpu));
+    return 8;
 }
 
 // ============================================================================
@@ -1598,102 +971,56 @@ u8 instr_sbc_a_n(CPU *cpu) {
 // C - 0
 // ----------------------------------------------
 u8 instr_and_a_b(CPU *cpu) {
-    u8 result   = cpu->regs.a & cpu->regs.b;
-
-    cpu->regs.f = FLAG_HF_CARRY;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a &= cpu->regs.b;
+    flags_set(cpu, (cpu->regs.a ? 0 : FLAG_ZERO) | FLAG_HF_CARRY);
+    return 4;
 }
 
 u8 instr_and_a_c(CPU *cpu) {
-    u8 result   = cpu->regs.a & cpu->regs.c;
-
-    cpu->regs.f = FLAG_HF_CARRY;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a &= cpu->regs.c;
+    flags_set(cpu, (cpu->regs.a ? 0 : FLAG_ZERO) | FLAG_HF_CARRY);
+    return 4;
 }
 
 u8 instr_and_a_d(CPU *cpu) {
-    u8 result   = cpu->regs.a & cpu->regs.d;
-
-    cpu->regs.f = FLAG_HF_CARRY;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a &= cpu->regs.d;
+    flags_set(cpu, (cpu->regs.a ? 0 : FLAG_ZERO) | FLAG_HF_CARRY);
+    return 4;
 }
 
 u8 instr_and_a_e(CPU *cpu) {
-    u8 result   = cpu->regs.a & cpu->regs.e;
-
-    cpu->regs.f = FLAG_HF_CARRY;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a &= cpu->regs.e;
+    flags_set(cpu, (cpu->regs.a ? 0 : FLAG_ZERO) | FLAG_HF_CARRY);
+    return 4;
 }
 
 u8 instr_and_a_h(CPU *cpu) {
-    u8 result   = cpu->regs.a & cpu->regs.h;
-
-    cpu->regs.f = FLAG_HF_CARRY;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a &= cpu->regs.h;
+    flags_set(cpu, (cpu->regs.a ? 0 : FLAG_ZERO) | FLAG_HF_CARRY);
+    return 4;
 }
 
 u8 instr_and_a_l(CPU *cpu) {
-    u8 result   = cpu->regs.a & cpu->regs.l;
-
-    cpu->regs.f = FLAG_HF_CARRY;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a &= cpu->regs.l;
+    flags_set(cpu, (cpu->regs.a ? 0 : FLAG_ZERO) | FLAG_HF_CARRY);
+    return 4;
 }
 
 u8 instr_and_a_a(CPU *cpu) {
-    cpu->regs.f = FLAG_HF_CARRY;
-    if (cpu->regs.a == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    return 0;
+    flags_set(cpu, (cpu->regs.a ? 0 : FLAG_ZERO) | FLAG_HF_CARRY);
+    return 4;
 }
 
 u8 instr_and_a_mem_hl(CPU *cpu) {
-    u16 addr    = cpu_read_hl(cpu);
-    u8  value   = mmu_read(cpu->gb, addr);
-    u8  result  = cpu->regs.a & value;
-
-    cpu->regs.f = FLAG_HF_CARRY;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a &= mmu_read(cpu->gb, cpu_read_hl(cpu));
+    flags_set(cpu, (cpu->regs.a ? 0 : FLAG_ZERO) | FLAG_HF_CARRY);
+    return 8;
 }
 
 u8 instr_and_a_n(CPU *cpu) {
-    u8 n        = mmu_read(cpu->gb, cpu->pc++);
-    u8 result   = cpu->regs.a & n;
-
-    cpu->regs.f = FLAG_HF_CARRY;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a &= mmu_read(cpu->gb, cpu->pc++);
+    flags_set(cpu, (cpu->regs.a ? 0 : FLAG_ZERO) | FLAG_HF_CARRY);
+    return 8;
 }
 
 // OR A, r8
@@ -1705,102 +1032,56 @@ u8 instr_and_a_n(CPU *cpu) {
 // C - 0
 // ----------------------------------------------
 u8 instr_or_a_b(CPU *cpu) {
-    u8 result   = cpu->regs.a | cpu->regs.b;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a |= cpu->regs.b;
+    flags_set(cpu, cpu->regs.a ? 0 : FLAG_ZERO);
+    return 4;
 }
 
 u8 instr_or_a_c(CPU *cpu) {
-    u8 result   = cpu->regs.a | cpu->regs.c;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a |= cpu->regs.c;
+    flags_set(cpu, cpu->regs.a ? 0 : FLAG_ZERO);
+    return 4;
 }
 
 u8 instr_or_a_d(CPU *cpu) {
-    u8 result   = cpu->regs.a | cpu->regs.d;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a |= cpu->regs.d;
+    flags_set(cpu, cpu->regs.a ? 0 : FLAG_ZERO);
+    return 4;
 }
 
 u8 instr_or_a_e(CPU *cpu) {
-    u8 result   = cpu->regs.a | cpu->regs.e;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a |= cpu->regs.e;
+    flags_set(cpu, cpu->regs.a ? 0 : FLAG_ZERO);
+    return 4;
 }
 
 u8 instr_or_a_h(CPU *cpu) {
-    u8 result   = cpu->regs.a | cpu->regs.h;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a |= cpu->regs.h;
+    flags_set(cpu, cpu->regs.a ? 0 : FLAG_ZERO);
+    return 4;
 }
 
 u8 instr_or_a_l(CPU *cpu) {
-    u8 result   = cpu->regs.a | cpu->regs.l;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a |= cpu->regs.l;
+    flags_set(cpu, cpu->regs.a ? 0 : FLAG_ZERO);
+    return 4;
 }
 
 u8 instr_or_a_a(CPU *cpu) {
-    cpu->regs.f = 0;
-    if (cpu->regs.a == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    return 0;
+    flags_set(cpu, cpu->regs.a ? 0 : FLAG_ZERO);
+    return 4;
 }
 
 u8 instr_or_a_mem_hl(CPU *cpu) {
-    u16 addr    = cpu_read_hl(cpu);
-    u8  value   = mmu_read(cpu->gb, addr);
-    u8  result  = cpu->regs.a | value;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a |= mmu_read(cpu->gb, cpu_read_hl(cpu));
+    flags_set(cpu, cpu->regs.a ? 0 : FLAG_ZERO);
+    return 8;
 }
 
 u8 instr_or_a_n(CPU *cpu) {
-    u8 value    = mmu_read(cpu->gb, cpu->pc++);
-    u8 result   = cpu->regs.a | value;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a |= mmu_read(cpu->gb, cpu->pc++);
+    flags_set(cpu, cpu->regs.a ? 0 : FLAG_ZERO);
+    return 8;
 }
 
 // XOR A, r8
@@ -1812,100 +1093,57 @@ u8 instr_or_a_n(CPU *cpu) {
 // C - 0
 // ----------------------------------------------
 u8 instr_xor_a_b(CPU *cpu) {
-    u8 result   = cpu->regs.a ^ cpu->regs.b;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a ^= cpu->regs.b;
+    flags_set(cpu, cpu->regs.a ? 0 : FLAG_ZERO);
+    return 4;
 }
 
 u8 instr_xor_a_c(CPU *cpu) {
-    u8 result   = cpu->regs.a ^ cpu->regs.c;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a ^= cpu->regs.c;
+    flags_set(cpu, cpu->regs.a ? 0 : FLAG_ZERO);
+    return 4;
 }
 
 u8 instr_xor_a_d(CPU *cpu) {
-    u8 result   = cpu->regs.a ^ cpu->regs.d;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a ^= cpu->regs.d;
+    flags_set(cpu, cpu->regs.a ? 0 : FLAG_ZERO);
+    return 4;
 }
 
 u8 instr_xor_a_e(CPU *cpu) {
-    u8 result   = cpu->regs.a ^ cpu->regs.e;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a ^= cpu->regs.e;
+    flags_set(cpu, cpu->regs.a ? 0 : FLAG_ZERO);
+    return 4;
 }
 
 u8 instr_xor_a_h(CPU *cpu) {
-    u8 result   = cpu->regs.a ^ cpu->regs.h;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a ^= cpu->regs.h;
+    flags_set(cpu, cpu->regs.a ? 0 : FLAG_ZERO);
+    return 4;
 }
 
 u8 instr_xor_a_l(CPU *cpu) {
-    u8 result   = cpu->regs.a ^ cpu->regs.l;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a ^= cpu->regs.l;
+    flags_set(cpu, cpu->regs.a ? 0 : FLAG_ZERO);
+    return 4;
 }
 
 u8 instr_xor_a_a(CPU *cpu) {
-    cpu->regs.f = FLAG_ZERO;
     cpu->regs.a = 0;
-    return 0;
+    flags_set(cpu, FLAG_ZERO);
+    return 4;
 }
 
 u8 instr_xor_a_mem_hl(CPU *cpu) {
-    u16 addr    = cpu_read_hl(cpu);
-    u8  value   = mmu_read(cpu->gb, addr);
-    u8  result  = cpu->regs.a ^ value;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a ^= mmu_read(cpu->gb, cpu_read_hl(cpu));
+    flags_set(cpu, cpu->regs.a ? 0 : FLAG_ZERO);
+    return 8;
 }
 
 u8 instr_xor_a_n(CPU *cpu) {
-    u8 value    = mmu_read(cpu->gb, cpu->pc++);
-    u8 result   = cpu->regs.a ^ value;
-
-    cpu->regs.f = 0;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-
-    cpu->regs.a = result;
-    return 0;
+    cpu->regs.a ^= mmu_read(cpu->gb, cpu->pc++);
+    flags_set(cpu, cpu->regs.a ? 0 : FLAG_ZERO);
+    return 8;
 }
 
 // CP A, r8
@@ -1918,137 +1156,50 @@ u8 instr_xor_a_n(CPU *cpu) {
 // C - Set if borrow (r8 > A)
 // ----------------------------------------------
 u8 instr_cp_a_b(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 b        = cpu->regs.b;
-    u8 result   = a - b;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, b))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, b))
-        cpu->regs.f |= FLAG_CARRY;
-
-    return 0;
+    alu_sub(cpu, cpu->regs.a, cpu->regs.b, 0);
+    return 4;
 }
 
 u8 instr_cp_a_c(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 c        = cpu->regs.c;
-    u8 result   = a - c;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, c))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, c))
-        cpu->regs.f |= FLAG_CARRY;
-
-    return 0;
+    alu_sub(cpu, cpu->regs.a, cpu->regs.c, 0);
+    return 4;
 }
 
 u8 instr_cp_a_d(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 d        = cpu->regs.d;
-    u8 result   = a - d;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, d))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, d))
-        cpu->regs.f |= FLAG_CARRY;
-
-    return 0;
+    alu_sub(cpu, cpu->regs.a, cpu->regs.d, 0);
+    return 4;
 }
 
 u8 instr_cp_a_e(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 e        = cpu->regs.e;
-    u8 result   = a - e;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, e))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, e))
-        cpu->regs.f |= FLAG_CARRY;
-
-    return 0;
+    alu_sub(cpu, cpu->regs.a, cpu->regs.e, 0);
+    return 4;
 }
 
 u8 instr_cp_a_h(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 h        = cpu->regs.h;
-    u8 result   = a - h;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, h))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, h))
-        cpu->regs.f |= FLAG_CARRY;
-
-    return 0;
+    alu_sub(cpu, cpu->regs.a, cpu->regs.h, 0);
+    return 4;
 }
 
 u8 instr_cp_a_l(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 l        = cpu->regs.l;
-    u8 result   = a - l;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, l))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, l))
-        cpu->regs.f |= FLAG_CARRY;
-
-    return 0;
+    alu_sub(cpu, cpu->regs.a, cpu->regs.l, 0);
+    return 4;
 }
 
 u8 instr_cp_a_a(CPU *cpu) {
-    cpu->regs.f = FLAG_SUBT | FLAG_ZERO;
-    return 0;
+    flags_set(cpu, FLAG_SUBT | FLAG_ZERO);
+    return 4;
 }
 
 u8 instr_cp_a_mem_hl(CPU *cpu) {
-    u8  a       = cpu->regs.a;
-    u16 addr    = cpu_read_hl(cpu);
-    u8  value   = mmu_read(cpu->gb, addr);
-    u8  result  = a - value;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, value))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, value))
-        cpu->regs.f |= FLAG_CARRY;
-
-    return 0;
+    u8 value = mmu_read(cpu->gb, cpu_read_hl(cpu));
+    alu_sub(cpu, cpu->regs.a, value, 0);
+    return 8;
 }
 
 u8 instr_cp_a_n(CPU *cpu) {
-    u8 a        = cpu->regs.a;
-    u8 n        = mmu_read(cpu->gb, cpu->pc++);
-    u8 result   = a - n;
-
-    cpu->regs.f = FLAG_SUBT;
-    if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
-    if (check_half_carry_sub(a, n))
-        cpu->regs.f |= FLAG_HF_CARRY;
-    if (check_carry_sub(a, n))
-        cpu->regs.f |= FLAG_CARRY;
-
-    return 0;
+    u8 value = mmu_read(cpu->gb, cpu->pc++);
+    alu_sub(cpu, cpu->regs.a, value, 0);
+    return 8;
 }
 
 // ============================================================================
@@ -2064,78 +1215,70 @@ u8 instr_cp_a_n(CPU *cpu) {
 // C - Set if overflow from bit 15
 // ----------------------------------------------
 u8 instr_add_hl_bc(CPU *cpu) {
-    u16 hl       = cpu_read_hl(cpu);
-    u16 bc       = cpu_read_bc(cpu);
-    u16 result   = hl + bc;
+    u16 hl     = cpu_read_hl(cpu);
+    u16 bc     = cpu_read_bc(cpu);
+    u16 result = hl + bc;
 
     // Preserve Z flag
-    u8  old_flag = cpu_get_flag(cpu, FLAG_ZERO);
-
-    cpu->regs.f  = 0;
+    u8  f      = flags_zero(cpu) ? FLAG_ZERO : 0;
     if (check_half_carry_add_u16(hl, bc))
-        cpu->regs.f |= FLAG_HF_CARRY;
+        f |= FLAG_HF_CARRY;
     if (check_carry_add_u16(hl, bc))
-        cpu->regs.f |= FLAG_CARRY;
+        f |= FLAG_CARRY;
 
-    cpu->regs.f |= old_flag; // Restore Z flag
+    flags_set(cpu, f);
     cpu_write_hl(cpu, result);
-    return 0;
+    return 8;
 }
 
 u8 instr_add_hl_de(CPU *cpu) {
-    u16 hl       = cpu_read_hl(cpu);
-    u16 de       = cpu_read_de(cpu);
-    u16 result   = hl + de;
+    u16 hl     = cpu_read_hl(cpu);
+    u16 de     = cpu_read_de(cpu);
+    u16 result = hl + de;
 
     // Preserve Z flag
-    u8  old_flag = cpu_get_flag(cpu, FLAG_ZERO);
-
-    cpu->regs.f  = 0;
+    u8  f      = flags_zero(cpu) ? FLAG_ZERO : 0;
     if (check_half_carry_add_u16(hl, de))
-        cpu->regs.f |= FLAG_HF_CARRY;
+        f |= FLAG_HF_CARRY;
     if (check_carry_add_u16(hl, de))
-        cpu->regs.f |= FLAG_CARRY;
+        f |= FLAG_CARRY;
 
-    cpu->regs.f |= old_flag; // Restore Z flag
+    flags_set(cpu, f);
     cpu_write_hl(cpu, result);
-    return 0;
+    return 8;
 }
 
 u8 instr_add_hl_hl(CPU *cpu) {
-    u16 hl       = cpu_read_hl(cpu);
-    u16 result   = hl + hl;
+    u16 hl     = cpu_read_hl(cpu);
+    u16 result = hl + hl;
 
     // Preserve Z flag
-    u8  old_flag = cpu_get_flag(cpu, FLAG_ZERO);
-
-    cpu->regs.f  = 0;
+    u8  f      = flags_zero(cpu) ? FLAG_ZERO : 0;
     if (check_half_carry_add_u16(hl, hl))
-        cpu->regs.f |= FLAG_HF_CARRY;
+        f |= FLAG_HF_CARRY;
     if (check_carry_add_u16(hl, hl))
-        cpu->regs.f |= FLAG_CARRY;
+        f |= FLAG_CARRY;
 
-    cpu->regs.f |= old_flag; // Restore Z flag
+    flags_set(cpu, f);
     cpu_write_hl(cpu, result);
-    return 0;
+    return 8;
 }
 
 u8 instr_add_hl_sp(CPU *cpu) {
-    u16 hl       = cpu_read_hl(cpu);
-    u16 sp       = cpu->sp;
-    u16 result   = hl + sp;
+    u16 hl     = cpu_read_hl(cpu);
+    u16 sp     = cpu->sp;
+    u16 result = hl + sp;
 
     // Preserve Z flag
-    u8  old_flag = cpu_get_flag(cpu, FLAG_ZERO);
-
-    cpu->regs.f  = 0;
+    u8  f      = flags_zero(cpu) ? FLAG_ZERO : 0;
     if (check_half_carry_add_u16(hl, sp))
-        cpu->regs.f |= FLAG_HF_CARRY;
+        f |= FLAG_HF_CARRY;
     if (check_carry_add_u16(hl, sp))
-        cpu->regs.f |= FLAG_CARRY;
+        f |= FLAG_CARRY;
 
-    cpu->regs.f |= old_flag; // Restore Z flag
+    flags_set(cpu, f);
     cpu_write_hl(cpu, result);
-    return 0;
+    return 8;
 }
 
 // add sp, e8
@@ -2153,15 +1296,16 @@ u8 instr_add_sp_e8(CPU *cpu) {
     u8  sp_low  = sp & 0xFF;
     u8  val     = (u8)e8;
 
-    cpu->regs.f = 0;
+    u8  f       = 0;
 
     if (check_half_carry_add(sp_low, val))
-        cpu->regs.f |= FLAG_HF_CARRY;
+        f |= FLAG_HF_CARRY;
     if (check_carry_add(sp_low, val))
-        cpu->regs.f |= FLAG_CARRY;
+        f |= FLAG_CARRY;
 
+    flags_set(cpu, f);
     cpu->sp = result;
-    return 0;
+    return 16;
 }
 
 // INC r16
@@ -2169,26 +1313,23 @@ u8 instr_add_sp_e8(CPU *cpu) {
 // None Affected
 // ----------------------------------------------
 u8 instr_inc_bc(CPU *cpu) {
-    u16 bc = cpu_read_bc(cpu);
-    cpu_write_bc(cpu, ++bc);
-    return 0;
+    cpu->regs.bc++;
+    return 8;
 }
 
 u8 instr_inc_de(CPU *cpu) {
-    u16 de = cpu_read_de(cpu);
-    cpu_write_bc(cpu, ++de);
-    return 0;
+    cpu->regs.de++;
+    return 8;
 }
 
 u8 instr_inc_hl(CPU *cpu) {
-    u16 hl = cpu_read_hl(cpu);
-    cpu_write_bc(cpu, ++hl);
-    return 0;
+    cpu->regs.hl++;
+    return 8;
 }
 
 u8 instr_inc_sp(CPU *cpu) {
     cpu->sp++;
-    return 0;
+    return 8;
 }
 
 // DEC r16
@@ -2196,26 +1337,23 @@ u8 instr_inc_sp(CPU *cpu) {
 // None Affected
 // ----------------------------------------------
 u8 instr_dec_bc(CPU *cpu) {
-    u16 bc = cpu_read_bc(cpu);
-    cpu_write_bc(cpu, --bc);
-    return 0;
+    cpu->regs.bc--;
+    return 8;
 }
 
 u8 instr_dec_de(CPU *cpu) {
-    u16 de = cpu_read_de(cpu);
-    cpu_write_bc(cpu, --de);
-    return 0;
+    cpu->regs.de--;
+    return 8;
 }
 
 u8 instr_dec_hl(CPU *cpu) {
-    u16 hl = cpu_read_hl(cpu);
-    cpu_write_bc(cpu, --hl);
-    return 0;
+    cpu->regs.hl--;
+    return 8;
 }
 
 u8 instr_dec_sp(CPU *cpu) {
     cpu->sp--;
-    return 0;
+    return 8;
 }
 
 // ============================================================================
@@ -2229,35 +1367,23 @@ u8 instr_dec_sp(CPU *cpu) {
 // None affected
 // ----------------------------------------------
 u8 instr_push_bc(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, cpu->regs.b);
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, cpu->regs.c);
-    return 0;
+    push16(cpu, cpu->regs.bc);
+    return 16;
 }
 
 u8 instr_push_de(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, cpu->regs.d);
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, cpu->regs.e);
-    return 0;
+    push16(cpu, cpu->regs.de);
+    return 16;
 }
 
 u8 instr_push_hl(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, cpu->regs.h);
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, cpu->regs.l);
-    return 0;
+    push16(cpu, cpu->regs.hl);
+    return 16;
 }
 
 u8 instr_push_af(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, cpu->regs.a);
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, cpu->regs.f);
-    return 0;
+    push16(cpu, MAKE_U16(cpu->regs.a, flags_get(cpu)));
+    return 16;
 }
 
 // POP r16
@@ -2266,100 +1392,74 @@ u8 instr_push_af(CPU *cpu) {
 // None affected
 // ----------------------------------------------
 u8 instr_pop_bc(CPU *cpu) {
-    cpu->regs.c = mmu_read(cpu->gb, cpu->sp++);
-    cpu->regs.b = mmu_read(cpu->gb, cpu->sp++);
-    return 0;
+    cpu->regs.bc = pop16(cpu);
+    return 12;
 }
 
 u8 instr_pop_de(CPU *cpu) {
-    cpu->regs.e = mmu_read(cpu->gb, cpu->sp++);
-    cpu->regs.d = mmu_read(cpu->gb, cpu->sp++);
-    return 0;
+    cpu->regs.de = pop16(cpu);
+    return 12;
 }
 
 u8 instr_pop_hl(CPU *cpu) {
-    cpu->regs.l = mmu_read(cpu->gb, cpu->sp++);
-    cpu->regs.h = mmu_read(cpu->gb, cpu->sp++);
-    return 0;
+    cpu->regs.hl = pop16(cpu);
+    return 12;
 }
 
 u8 instr_pop_af(CPU *cpu) {
-    cpu->regs.f = mmu_read(cpu->gb, cpu->sp++);
-    cpu->regs.a = mmu_read(cpu->gb, cpu->sp++);
-    return 0;
+    u16 af      = pop16(cpu);
+    cpu->regs.a = GET_HIGH_BYTE(af);
+    flags_set(cpu, GET_LOW_BYTE(af) & 0xF0); // Lower 4 bits always zero
+    return 12;
 }
 
 // Restart Vectors
 u8 instr_rst_00(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    push16(cpu, cpu->pc);
     cpu->pc = 0x00;
-    return 0;
+    return 16;
 }
 
 u8 instr_rst_08(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    push16(cpu, cpu->pc);
     cpu->pc = 0x08;
-    return 0;
+    return 16;
 }
 
 u8 instr_rst_10(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    push16(cpu, cpu->pc);
     cpu->pc = 0x10;
-    return 0;
+    return 16;
 }
 
 u8 instr_rst_18(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    push16(cpu, cpu->pc);
     cpu->pc = 0x18;
-    return 0;
+    return 16;
 }
 
 u8 instr_rst_20(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    push16(cpu, cpu->pc);
     cpu->pc = 0x20;
-    return 0;
+    return 16;
 }
 
 u8 instr_rst_28(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    push16(cpu, cpu->pc);
     cpu->pc = 0x28;
-    return 0;
+    return 16;
 }
 
 u8 instr_rst_30(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    push16(cpu, cpu->pc);
     cpu->pc = 0x30;
-    return 0;
+    return 16;
 }
 
 u8 instr_rst_38(CPU *cpu) {
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    push16(cpu, cpu->pc);
     cpu->pc = 0x38;
-    return 0;
+    return 16;
 }
 
 // ============================================================================
@@ -2376,7 +1476,7 @@ u8 instr_jp_a16(CPU *cpu) {
     u8 lo   = mmu_read(cpu->gb, cpu->pc++);
     u8 hi   = mmu_read(cpu->gb, cpu->pc++);
     cpu->pc = MAKE_U16(hi, lo);
-    return 0;
+    return 16;
 }
 
 // JP HL
@@ -2386,7 +1486,7 @@ u8 instr_jp_a16(CPU *cpu) {
 // ----------------------------------------------
 u8 instr_jp_hl(CPU *cpu) {
     cpu->pc = cpu_read_hl(cpu);
-    return 0;
+    return 4;
 }
 
 // JP cc a16
@@ -2400,9 +1500,9 @@ u8 instr_jp_nz_a16(CPU *cpu) {
     u8 lo = mmu_read(cpu->gb, cpu->pc++);
     u8 hi = mmu_read(cpu->gb, cpu->pc++);
 
-    if (!cpu_get_flag(cpu, FLAG_ZERO)) {
+    if (!flags_zero(cpu)) {
         cpu->pc = MAKE_U16(hi, lo);
-        return 0;
+        return 16;
     }
 
     return 12;
@@ -2412,9 +1512,9 @@ u8 instr_jp_z_a16(CPU *cpu) {
     u8 lo = mmu_read(cpu->gb, cpu->pc++);
     u8 hi = mmu_read(cpu->gb, cpu->pc++);
 
-    if (cpu_get_flag(cpu, FLAG_ZERO)) {
+    if (flags_zero(cpu)) {
         cpu->pc = MAKE_U16(hi, lo);
-        return 0;
+        return 16;
     }
     return 12;
 }
@@ -2423,9 +1523,9 @@ u8 instr_jp_nc_a16(CPU *cpu) {
     u8 lo = mmu_read(cpu->gb, cpu->pc++);
     u8 hi = mmu_read(cpu->gb, cpu->pc++);
 
-    if (!cpu_get_flag(cpu, FLAG_CARRY)) {
+    if (!flags_carry(cpu)) {
         cpu->pc = MAKE_U16(hi, lo);
-        return 0;
+        return 16;
     }
     return 12;
 }
@@ -2434,9 +1534,9 @@ u8 instr_jp_c_a16(CPU *cpu) {
     u8 lo = mmu_read(cpu->gb, cpu->pc++);
     u8 hi = mmu_read(cpu->gb, cpu->pc++);
 
-    if (cpu_get_flag(cpu, FLAG_CARRY)) {
+    if (flags_carry(cpu)) {
         cpu->pc = MAKE_U16(hi, lo);
-        return 0;
+        return 16;
     }
     return 12;
 }
@@ -2449,7 +1549,7 @@ u8 instr_jp_c_a16(CPU *cpu) {
 u8 instr_jr_e8(CPU *cpu) {
     i8 offset = (i8)mmu_read(cpu->gb, cpu->pc++);
     cpu->pc += offset;
-    return 0;
+    return 12;
 }
 
 // JR cc e8
@@ -2462,9 +1562,9 @@ u8 instr_jr_e8(CPU *cpu) {
 u8 instr_jr_nz_e8(CPU *cpu) {
     i8 offset = (i8)mmu_read(cpu->gb, cpu->pc++);
 
-    if (!cpu_get_flag(cpu, FLAG_ZERO)) {
+    if (!flags_zero(cpu)) {
         cpu->pc += offset;
-        return 0;
+        return 12;
     }
 
     return 8;
@@ -2473,9 +1573,9 @@ u8 instr_jr_nz_e8(CPU *cpu) {
 u8 instr_jr_z_e8(CPU *cpu) {
     i8 offset = (i8)mmu_read(cpu->gb, cpu->pc++);
 
-    if (cpu_get_flag(cpu, FLAG_ZERO)) {
+    if (flags_zero(cpu)) {
         cpu->pc += offset;
-        return 0;
+        return 12;
     }
 
     return 8;
@@ -2484,9 +1584,9 @@ u8 instr_jr_z_e8(CPU *cpu) {
 u8 instr_jr_nc_e8(CPU *cpu) {
     i8 offset = (i8)mmu_read(cpu->gb, cpu->pc++);
 
-    if (!cpu_get_flag(cpu, FLAG_CARRY)) {
+    if (!flags_carry(cpu)) {
         cpu->pc += offset;
-        return 0;
+        return 12;
     }
 
     return 8;
@@ -2495,9 +1595,9 @@ u8 instr_jr_nc_e8(CPU *cpu) {
 u8 instr_jr_c_e8(CPU *cpu) {
     i8 offset = (i8)mmu_read(cpu->gb, cpu->pc++);
 
-    if (cpu_get_flag(cpu, FLAG_CARRY)) {
+    if (flags_carry(cpu)) {
         cpu->pc += offset;
-        return 0;
+        return 12;
     }
 
     return 8;
@@ -2514,13 +1614,11 @@ u8 instr_call_a16(CPU *cpu) {
     u16 addr = MAKE_U16(hi, lo);
 
     // Push return address onto stack
-    cpu->sp--;
-    mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-    mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    push16(cpu, cpu->pc);
 
     // Update the pc
     cpu->pc = addr;
-    return 0;
+    return 24;
 }
 
 // JP cc a16
@@ -2535,14 +1633,11 @@ u8 instr_call_nz_a16(CPU *cpu) {
     u8  hi   = mmu_read(cpu->gb, cpu->pc++);
     u16 addr = MAKE_U16(hi, lo);
 
-    if (!cpu_get_flag(cpu, FLAG_ZERO)) {
-        cpu->sp--;
-        mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-        cpu->sp--;
-        mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    if (!flags_zero(cpu)) {
+        push16(cpu, cpu->pc);
 
         cpu->pc = addr;
-        return 0;
+        return 24;
     }
     return 12;
 }
@@ -2552,14 +1647,11 @@ u8 instr_call_z_a16(CPU *cpu) {
     u8  hi   = mmu_read(cpu->gb, cpu->pc++);
     u16 addr = MAKE_U16(hi, lo);
 
-    if (cpu_get_flag(cpu, FLAG_ZERO)) {
-        cpu->sp--;
-        mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-        cpu->sp--;
-        mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    if (flags_zero(cpu)) {
+        push16(cpu, cpu->pc);
 
         cpu->pc = addr;
-        return 0;
+        return 24;
     }
     return 12;
 }
@@ -2569,14 +1661,11 @@ u8 instr_call_nc_a16(CPU *cpu) {
     u8  hi   = mmu_read(cpu->gb, cpu->pc++);
     u16 addr = MAKE_U16(hi, lo);
 
-    if (!cpu_get_flag(cpu, FLAG_CARRY)) {
-        cpu->sp--;
-        mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-        cpu->sp--;
-        mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    if (!flags_carry(cpu)) {
+        push16(cpu, cpu->pc);
 
         cpu->pc = addr;
-        return 0;
+        return 24;
     }
     return 12;
 }
@@ -2586,14 +1675,11 @@ u8 instr_call_c_a16(CPU *cpu) {
     u8  hi   = mmu_read(cpu->gb, cpu->pc++);
     u16 addr = MAKE_U16(hi, lo);
 
-    if (cpu_get_flag(cpu, FLAG_CARRY)) {
-        cpu->sp--;
-        mmu_write(cpu->gb, cpu->sp, GET_HIGH_BYTE(cpu->pc));
-        cpu->sp--;
-        mmu_write(cpu->gb, cpu->sp, GET_LOW_BYTE(cpu->pc));
+    if (flags_carry(cpu)) {
+        push16(cpu, cpu->pc);
 
         cpu->pc = addr;
-        return 0;
+        return 24;
     }
     return 12;
 }
@@ -2604,11 +1690,8 @@ u8 instr_call_c_a16(CPU *cpu) {
 // None affected
 // ----------------------------------------------
 u8 instr_ret(CPU *cpu) {
-    u8 lo   = mmu_read(cpu->gb, cpu->pc++);
-    u8 hi   = mmu_read(cpu->gb, cpu->pc++);
-
-    cpu->pc = MAKE_U16(hi, lo);
-    return 0;
+    cpu->pc = pop16(cpu);
+    return 16;
 }
 
 // RET cc
@@ -2619,52 +1702,43 @@ u8 instr_ret(CPU *cpu) {
 // None affected
 // ----------------------------------------------
 u8 instr_ret_nz(CPU *cpu) {
-    if (!cpu_get_flag(cpu, FLAG_ZERO)) {
-        u8 lo   = mmu_read(cpu->gb, cpu->sp++);
-        u8 hi   = mmu_read(cpu->gb, cpu->sp++);
-        cpu->pc = MAKE_U16(hi, lo);
-        return 0;
+    if (!flags_zero(cpu)) {
+        cpu->pc = pop16(cpu);
+        return 20;
     }
     return 8;
 }
 
 u8 instr_ret_z(CPU *cpu) {
-    if (cpu_get_flag(cpu, FLAG_ZERO)) {
-        u8 lo   = mmu_read(cpu->gb, cpu->sp++);
-        u8 hi   = mmu_read(cpu->gb, cpu->sp++);
-        cpu->pc = MAKE_U16(hi, lo);
-        return 0;
+    if (flags_zero(cpu)) {
+        cpu->pc = pop16(cpu);
+        return 20;
     }
     return 8;
 }
 
 u8 instr_ret_nc(CPU *cpu) {
-    if (!cpu_get_flag(cpu, FLAG_CARRY)) {
-        u8 lo   = mmu_read(cpu->gb, cpu->sp++);
-        u8 hi   = mmu_read(cpu->gb, cpu->sp++);
-        cpu->pc = MAKE_U16(hi, lo);
-        return 0;
+    if (!flags_carry(cpu)) {
+        cpu->pc = pop16(cpu);
+        return 20;
     }
     return 8;
 }
 
 u8 instr_ret_c(CPU *cpu) {
-    if (cpu_get_flag(cpu, FLAG_CARRY)) {
-        u8 lo   = mmu_read(cpu->gb, cpu->sp++);
-        u8 hi   = mmu_read(cpu->gb, cpu->sp++);
-        cpu->pc = MAKE_U16(hi, lo);
-        return 0;
+    if (flags_carry(cpu)) {
+        cpu->pc = pop16(cpu);
+        return 20;
     }
     return 8;
 }
 
 // Return from subroutine & enable interrupts
 u8 instr_reti(CPU *cpu) {
-    u8 lo    = mmu_read(cpu->gb, cpu->sp++);
-    u8 hi    = mmu_read(cpu->gb, cpu->sp++);
-    cpu->pc  = MAKE_U16(hi, lo);
+    cpu->pc  = pop16(cpu);
     cpu->ime = true;
-    return 0;
+    cpu_update_interrupts(cpu);
+    return 16;
 }
 
 // ============================================================================
@@ -2684,11 +1758,9 @@ u8 instr_rlca(CPU *cpu) {
 
     cpu->regs.a = (a << 1) | carry;
 
-    cpu->regs.f = 0;
-    if (carry)
-        cpu->regs.f |= FLAG_CARRY;
+    flags_set(cpu, carry ? FLAG_CARRY : 0);
 
-    return 0;
+    return 4;
 }
 
 // RRCA
@@ -2699,15 +1771,13 @@ u8 instr_rlca(CPU *cpu) {
 // ----------------------------------------------
 u8 instr_rrca(CPU *cpu) {
     u8 a        = cpu->regs.a;
-    u8 carry    = CHECK_BIT(a, 7);
+    u8 carry    = CHECK_BIT(a, 0);
 
     cpu->regs.a = (a >> 1) | (carry << 7);
 
-    cpu->regs.f = 0;
-    if (carry)
-        cpu->regs.f |= FLAG_CARRY;
+    flags_set(cpu, carry ? FLAG_CARRY : 0);
 
-    return 0;
+    return 4;
 }
 
 // RLA
@@ -2718,16 +1788,14 @@ u8 instr_rrca(CPU *cpu) {
 // ----------------------------------------------
 u8 instr_rla(CPU *cpu) {
     u8 a         = cpu->regs.a;
-    u8 old_carry = cpu_get_flag(cpu, FLAG_CARRY);
+    u8 old_carry = flags_carry(cpu);
     u8 new_carry = CHECK_BIT(a, 7);
 
     cpu->regs.a  = (a << 1) | old_carry;
 
-    cpu->regs.f  = 0;
-    if (new_carry)
-        cpu->regs.f |= FLAG_CARRY;
+    flags_set(cpu, new_carry ? FLAG_CARRY : 0);
 
-    return 0;
+    return 4;
 }
 
 // RRA
@@ -2738,16 +1806,14 @@ u8 instr_rla(CPU *cpu) {
 // ----------------------------------------------
 u8 instr_rra(CPU *cpu) {
     u8 a         = cpu->regs.a;
-    u8 old_carry = cpu_get_flag(cpu, FLAG_CARRY);
-    u8 new_carry = CHECK_BIT(a, 7);
+    u8 old_carry = flags_carry(cpu);
+    u8 new_carry = CHECK_BIT(a, 0);
 
     cpu->regs.a  = (a >> 1) | (old_carry << 7);
 
-    cpu->regs.f  = 0;
-    if (new_carry)
-        cpu->regs.f |= FLAG_CARRY;
+    flags_set(cpu, new_carry ? FLAG_CARRY : 0);
 
-    return 0;
+    return 4;
 }
 
 // CPL
@@ -2756,8 +1822,8 @@ u8 instr_rra(CPU *cpu) {
 // N = H = 1
 u8 instr_cpl(CPU *cpu) {
     cpu->regs.a ^= 0xFF;
-    cpu->regs.f |= FLAG_SUBT | FLAG_HF_CARRY;
-    return 0;
+    flags_set(cpu, flags_get(cpu) | FLAG_SUBT | FLAG_HF_CARRY);
+    return 4;
 }
 
 // SCF
@@ -2765,9 +1831,8 @@ u8 instr_cpl(CPU *cpu) {
 // N = H = 0
 // C = 1
 u8 instr_scf(CPU *cpu) {
-    cpu->regs.f &= FLAG_ZERO;  // Preserve Z
-    cpu->regs.f |= FLAG_CARRY; // Set C
-    return 0;
+    flags_set(cpu, (flags_get(cpu) & FLAG_ZERO) | FLAG_CARRY); // Preserve Z, set C
+    return 4;
 }
 
 // CCF
@@ -2776,13 +1841,11 @@ u8 instr_scf(CPU *cpu) {
 // N = H = 0
 // C = inverted
 u8 instr_ccf(CPU *cpu) {
-    bool carry = cpu_get_flag(cpu, FLAG_CARRY);
+    bool carry = flags_carry(cpu);
 
-    cpu->regs.f &= FLAG_ZERO;
-    if (!carry)
-        cpu->regs.f |= FLAG_CARRY; // Set C
+    flags_set(cpu, (flags_get(cpu) & FLAG_ZERO) | (carry ? 0 : FLAG_CARRY));
 
-    return 0;
+    return 4;
 }
 
 // DAA
@@ -2793,26 +1856,29 @@ u8 instr_ccf(CPU *cpu) {
 // https://rgbds.gbdev.io/docs/v1.0.1/gbz80.7#DAA
 u8 instr_daa(CPU *cpu) {
     u8   a      = cpu->regs.a;
+    u8   f      = flags_get(cpu);
 
-    bool sub    = cpu_get_flag(cpu, FLAG_SUBT);
-    bool half   = cpu_get_flag(cpu, FLAG_HF_CARRY);
-    bool carry  = cpu_get_flag(cpu, FLAG_CARRY);
+    bool sub    = f & FLAG_SUBT;
+    bool half   = f & FLAG_HF_CARRY;
+    bool carry  = f & FLAG_CARRY;
 
     u8   result = adjust_bcd(a, sub, carry, half);
 
     // Update flags
-    cpu->regs.f = 0;
+    f           = 0;
     if (result == 0)
-        cpu->regs.f |= FLAG_ZERO;
+        f |= FLAG_ZERO;
     if (sub)
-        cpu->regs.f |= FLAG_SUBT;
+        f |= FLAG_SUBT;
 
     // Carry is set if we corrected with 0x60
     if (!sub && (carry || a > 0x99))
-        cpu->regs.f |= FLAG_CARRY;
+        f |= FLAG_CARRY;
     if (sub && carry)
-        cpu->regs.f |= FLAG_CARRY;
+        f |= FLAG_CARRY;
+
+    flags_set(cpu, f);
 
     cpu->regs.a = result;
-    return 0;
+    return 4;
 }
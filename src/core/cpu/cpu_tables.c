@@ -238,7 +238,7 @@ static const InstrFunc instr_table[256] = {
     [0xC8] = instr_ret_z,
     [0xC9] = instr_ret,
     [0xCA] = instr_jp_z_a16,
-    [0xCB] = NULL, // TODO: instr_prefix_cb
+    [0xCB] = instr_prefix_cb,
     [0xCC] = instr_call_z_a16,
     [0xCD] = instr_call_a16,
     [0xCE] = instr_adc_a_n,
@@ -299,110 +299,9 @@ static const InstrFunc instr_table[256] = {
     [0xFF] = instr_rst_38,
 };
 
-// ---------------------------------------------
-// Cycle counts for each instruction
-// ---------------------------------------------
-static const u8 instr_cycles[256] = {
-    [0x00] = 4,       [0x01] = 12,      [0x02] = 8,  [0x03] = 8,
-    [0x04] = 4,       [0x05] = 4,       [0x06] = 8,  [0x07] = 4,
-    [0x08] = 20,      [0x09] = 8,       [0x0A] = 8,  [0x0B] = 8,
-    [0x0C] = 4,       [0x0D] = 4,       [0x0E] = 8,  [0x0F] = 4,
-
-    [0x10] = 4,       [0x11] = 12,      [0x12] = 8,  [0x13] = 8,
-    [0x14] = 4,       [0x15] = 4,       [0x16] = 8,  [0x17] = 4,
-    [0x18] = 12,      [0x19] = 8,       [0x1A] = 8,  [0x1B] = 8,
-    [0x1C] = 4,       [0x1D] = 4,       [0x1E] = 8,  [0x1F] = 4,
-
-    [0x20] = 12, // NOTE: 8 if Z flag set
-    [0x21] = 12,      [0x22] = 8,       [0x23] = 8,  [0x24] = 4,
-    [0x25] = 4,       [0x26] = 8,       [0x27] = 4,
-    [0x28] = 12, // NOTE: 8 if Z flag not set
-    [0x29] = 8,       [0x2A] = 8,       [0x2B] = 8,  [0x2C] = 4,
-    [0x2D] = 4,       [0x2E] = 8,       [0x2F] = 4,
-
-    [0x30] = 12, // NOTE: 8 if C flag set
-    [0x31] = 12,      [0x32] = 8,       [0x33] = 8,  [0x34] = 12,
-    [0x35] = 12,      [0x36] = 12,      [0x37] = 4,
-    [0x38] = 12, // NOTE: 8 if C flag not set
-    [0x39] = 8,       [0x3A] = 8,       [0x3B] = 8,  [0x3C] = 4,
-    [0x3D] = 4,       [0x3E] = 8,       [0x3F] = 4,
-
-    [0x40] = 4,       [0x41] = 4,       [0x42] = 4,  [0x43] = 4,
-    [0x44] = 4,       [0x45] = 4,       [0x46] = 8,  [0x47] = 4,
-    [0x48] = 4,       [0x49] = 4,       [0x4A] = 4,  [0x4B] = 4,
-    [0x4C] = 4,       [0x4D] = 4,       [0x4E] = 8,  [0x4F] = 4,
-
-    [0x50] = 4,       [0x51] = 4,       [0x52] = 4,  [0x53] = 4,
-    [0x54] = 4,       [0x55] = 4,       [0x56] = 8,  [0x57] = 4,
-    [0x58] = 4,       [0x59] = 4,       [0x5A] = 4,  [0x5B] = 4,
-    [0x5C] = 4,       [0x5D] = 4,       [0x5E] = 8,  [0x5F] = 4,
-
-    [0x60] = 4,       [0x61] = 4,       [0x62] = 4,  [0x63] = 4,
-    [0x64] = 4,       [0x65] = 4,       [0x66] = 8,  [0x67] = 4,
-    [0x68] = 4,       [0x69] = 4,       [0x6A] = 4,  [0x6B] = 4,
-    [0x6C] = 4,       [0x6D] = 4,       [0x6E] = 8,  [0x6F] = 4,
-
-    [0x70] = 8,       [0x71] = 8,       [0x72] = 8,  [0x73] = 8,
-    [0x74] = 8,       [0x75] = 8,       [0x76] = 4,  [0x77] = 8,
-    [0x78] = 4,       [0x79] = 4,       [0x7A] = 4,  [0x7B] = 4,
-    [0x7C] = 4,       [0x7D] = 4,       [0x7E] = 8,  [0x7F] = 4,
-
-    [0x80] = 4,       [0x81] = 4,       [0x82] = 4,  [0x83] = 4,
-    [0x84] = 4,       [0x85] = 4,       [0x86] = 8,  [0x87] = 4,
-    [0x88] = 4,       [0x89] = 4,       [0x8A] = 4,  [0x8B] = 4,
-    [0x8C] = 4,       [0x8D] = 4,       [0x8E] = 8,  [0x8F] = 4,
-
-    [0x90] = 4,       [0x91] = 4,       [0x92] = 4,  [0x93] = 4,
-    [0x94] = 4,       [0x95] = 4,       [0x96] = 8,  [0x97] = 4,
-    [0x98] = 4,       [0x99] = 4,       [0x9A] = 4,  [0x9B] = 4,
-    [0x9C] = 4,       [0x9D] = 4,       [0x9E] = 8,  [0x9F] = 4,
-
-    [0xA0] = 4,       [0xA1] = 4,       [0xA2] = 4,  [0xA3] = 4,
-    [0xA4] = 4,       [0xA5] = 4,       [0xA6] = 8,  [0xA7] = 4,
-    [0xA8] = 4,       [0xA9] = 4,       [0xAA] = 4,  [0xAB] = 4,
-    [0xAC] = 4,       [0xAD] = 4,       [0xAE] = 8,  [0xAF] = 4,
-
-    [0xB0] = 4,       [0xB1] = 4,       [0xB2] = 4,  [0xB3] = 4,
-    [0xB4] = 4,       [0xB5] = 4,       [0xB6] = 8,  [0xB7] = 4,
-    [0xB8] = 4,       [0xB9] = 4,       [0xBA] = 4,  [0xBB] = 4,
-    [0xBC] = 4,       [0xBD] = 4,       [0xBE] = 8,  [0xBF] = 4,
-
-    [0xC0] = 20, // NOTE: 8 if Z flag is set
-    [0xC1] = 12,
-    [0xC2] = 16, // NOTE: 12 if Z flag is set
-    [0xC3] = 16,
-    [0xC4] = 24, // NOTE: 12 if Z set
-    [0xC5] = 16,      [0xC6] = 8,       [0xC7] = 16,
-    [0xC8] = 20, // NOTE: 8 if Z flag not set
-    [0xC9] = 16,
-    [0xCA] = 16, // NOTE: 12 if Z is not set
-    [0xCB] = 4,
-    [0xCC] = 24, // NOTE: 12 if Z is not set
-    [0xCD] = 24,      [0xCE] = 8,       [0xCF] = 16,
-
-    [0xD0] = 20, // NOTE: 8 if C is set
-    [0xD1] = 12,
-    [0xD2] = 16, // NOTE: 12 if C is set
-    [0xD3] = ILLEGAL,
-    [0xD4] = 24, // NOTE: 12 if C is set
-    [0xD5] = 16,      [0xD6] = 8,       [0xD7] = 16,
-    [0xD8] = 20, // NOTE: 8 if C is not set
-    [0xD9] = 16,
-    [0xDA] = 16, // NOTE: 12 if C not set
-    [0xDB] = ILLEGAL,
-    [0xDC] = 24, // NOTE: 12 if C not set
-    [0xDD] = ILLEGAL, [0xDE] = 8,       [0xDF] = 16,
-
-    [0xE0] = 12,      [0xE1] = 12,      [0xE2] = 8,  [0xE3] = ILLEGAL,
-    [0xE4] = ILLEGAL, [0xE5] = 16,      [0xE6] = 8,  [0xE7] = 16,
-    [0xE8] = 16,      [0xE9] = 4,       [0xEA] = 16, [0xEB] = ILLEGAL,
-    [0xEC] = ILLEGAL, [0xED] = ILLEGAL, [0xEE] = 8,  [0xEF] = 16,
-
-    [0xF0] = 12,      [0xF1] = 12,      [0xF2] = 8,  [0xF3] = 4,
-    [0xF4] = ILLEGAL, [0xF5] = 16,      [0xF6] = 8,  [0xF7] = 16,
-    [0xF8] = 12,      [0xF9] = 8,       [0xFA] = 16, [0xFB] = 4,
-    [0xFC] = ILLEGAL, [0xFD] = ILLEGAL, [0xFE] = 8,  [0xFF] = 16,
-};
+InstrFunc cpu_get_handler(u8 opcode) {
+    return instr_table[opcode];
+}
 
 // ---------------------------------------------
 // Execute an instruction
@@ -415,15 +314,10 @@ u8 cpu_execute(CPU *cpu, u8 opcode) {
         return ILLEGAL;
     }
 
-    // If the returned val is not 0
-    // Cycle count is returned
-    u8 cycle_count = instr_table[opcode](cpu);
-    if (!cycle_count) {
-        return cycle_count;
-    }
-
-    // Otherwise, use the val from the table above
-    return instr_cycles[opcode];
+    // Every handler returns its exact T-cycle count,
+    // including the taken/not-taken variants of conditional branches
+    u8 cycles = instr_table[opcode](cpu);
 
-    // TODO: Might remove the table above and keep return cycle count from functions
+    cpu_sync_flags(cpu);
+    return cycles;
 }
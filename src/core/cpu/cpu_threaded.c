@@ -0,0 +1,1168 @@
+// src/core/cpu/cpu_threaded.c
+// Threaded interpreter, built instead of the instr_table run loop when THREADED_CORE is ON
+//
+// cpu_run() is one function: registers live in locals for the whole call and every handler ends
+// by fetching the next opcode and jumping straight to its handler (labels-as-values on GCC and
+// Clang, a switch elsewhere). CPU state is written back only when the budget runs out or the CPU
+// halts. Instruction semantics and cycle counts match the handlers in cpu_exec.c.
+#include <core/cpu/cpu.h>
+#include <core/cpu/cpu_exec.h>
+#include <core/bus.h>
+#include <gbemu.h>
+#include <stdio.h>
+
+#if defined(__GNUC__) && !defined(GB_NO_COMPUTED_GOTO)
+#define USE_COMPUTED_GOTO 1
+// &&label and goto *ptr are GNU extensions
+#pragma GCC diagnostic ignored "-Wpedantic"
+#else
+#define USE_COMPUTED_GOTO 0
+#endif
+
+// ---------------------------------------------
+// Dispatch
+// NEXT() retires the current instruction and jumps to the next one unless the budget is spent
+// ---------------------------------------------
+#if USE_COMPUTED_GOTO
+#define OP(n) op_##n:
+#define OP_ILLEGAL op_illegal:
+#define DISPATCH() goto *dispatch_table[opcode]
+#else
+#define OP(n) case 0x##n:
+#define OP_ILLEGAL default:
+#define DISPATCH() goto dispatch
+#endif
+
+#define NEXT(t)                                                                                    \
+    do {                                                                                           \
+        gb->cycles += (t);                                                                         \
+        if (gb->cycles >= gb->sched.deadline)                                                      \
+            goto done;                                                                             \
+        if (cpu->int_pending)                                                                      \
+            goto interrupt;                                                                        \
+        opcode = FETCH8();                                                                         \
+        DISPATCH();                                                                                \
+    } while (0)
+#define READ8(addr) mmu_read(gb, (addr))
+#define WRITE8(addr, value) mmu_write(gb, (addr), (value))
+#define FETCH8() mmu_read(gb, pc++)
+#define FETCH16() (pc += 2, MAKE_U16(mmu_read(gb, pc - 1), mmu_read(gb, pc - 2)))
+#define PAIR(hi, lo) MAKE_U16(hi, lo)
+#define CARRY_IN() ((f & FLAG_CARRY) ? 1 : 0)
+#define ZERO_IF(value) ((value) ? 0 : FLAG_ZERO)
+#define INC16(hi, lo)                                                                              \
+    do {                                                                                           \
+        if (++(lo) == 0)                                                                           \
+            (hi)++;                                                                                \
+    } while (0)
+#define DEC16(hi, lo)                                                                              \
+    do {                                                                                           \
+        if ((lo)-- == 0)                                                                           \
+            (hi)--;                                                                                \
+    } while (0)
+
+// ---------------------------------------------
+// Stack
+// ---------------------------------------------
+// One 16-bit access per pair, as in cpu_exec.c
+#define PUSH16(value) mmu_write16(gb, sp -= 2, (value))
+#define POP16() (sp += 2, mmu_read16(gb, sp - 2))
+
+// ---------------------------------------------
+// ALU (flags computed exactly as in cpu_exec.c)
+// ---------------------------------------------
+#define INC8(r)                                                                                    \
+    do {                                                                                           \
+        f = (f & FLAG_CARRY) | ((((r) & 0x0F) == 0x0F) ? FLAG_HF_CARRY : 0);                       \
+        (r)++;                                                                                     \
+        f |= ZERO_IF(r);                                                                           \
+    } while (0)
+#define DEC8(r)                                                                                    \
+    do {                                                                                           \
+        f = (f & FLAG_CARRY) | FLAG_SUBT | ((((r) & 0x0F) == 0x00) ? FLAG_HF_CARRY : 0);           \
+        (r)--;                                                                                     \
+        f |= ZERO_IF(r);                                                                           \
+    } while (0)
+#define ALU_ADD(value) ALU_ADC_IN(value, 0)
+#define ALU_ADC(value) ALU_ADC_IN(value, CARRY_IN())
+#define ALU_ADC_IN(value, carry)                                                                   \
+    do {                                                                                           \
+        u8  v_ = (value);                                                                          \
+        u8  c_ = (carry);                                                                          \
+        u16 r_ = a + v_ + c_;                                                                      \
+        f      = ZERO_IF((u8)r_) | (((a & 0x0F) + (v_ & 0x0F) + c_ > 0x0F) ? FLAG_HF_CARRY : 0) |  \
+            ((r_ > 0xFF) ? FLAG_CARRY : 0);                                                        \
+        a = (u8)r_;                                                                                \
+    } while (0)
+#define ALU_SUB(value) ALU_SBC_IN(value, 0, true)
+#define ALU_SBC(value) ALU_SBC_IN(value, CARRY_IN(), true)
+#define ALU_CP(value) ALU_SBC_IN(value, 0, false)
+#define ALU_SBC_IN(value, carry, store)                                                            \
+    do {                                                                                           \
+        u8  v_ = (value);                                                                          \
+        u8  c_ = (carry);                                                                          \
+        int r_ = a - v_ - c_;                                                                      \
+        f      = FLAG_SUBT | ZERO_IF((u8)r_) |                                                     \
+            (((a & 0x0F) < (v_ & 0x0F) + c_) ? FLAG_HF_CARRY : 0) | ((r_ < 0) ? FLAG_CARRY : 0);   \
+        if (store)                                                                                 \
+            a = (u8)r_;                                                                            \
+    } while (0)
+#define ALU_AND(value)                                                                             \
+    do {                                                                                           \
+        a &= (value);                                                                              \
+        f = ZERO_IF(a) | FLAG_HF_CARRY;                                                            \
+    } while (0)
+#define ALU_XOR(value)                                                                             \
+    do {                                                                                           \
+        a ^= (value);                                                                              \
+        f = ZERO_IF(a);                                                                            \
+    } while (0)
+#define ALU_OR(value)                                                                              \
+    do {                                                                                           \
+        a |= (value);                                                                              \
+        f = ZERO_IF(a);                                                                            \
+    } while (0)
+#define ADD_HL(value)                                                                              \
+    do {                                                                                           \
+        u16 hl_ = PAIR(h, l);                                                                      \
+        u16 v_  = (value);                                                                         \
+        u32 r_  = (u32)hl_ + v_;                                                                   \
+        f       = (f & FLAG_ZERO) |                                                                \
+            (((hl_ & 0x0FFF) + (v_ & 0x0FFF) > 0x0FFF) ? FLAG_HF_CARRY : 0) |                      \
+            ((r_ > 0xFFFF) ? FLAG_CARRY : 0);                                                      \
+        h = GET_HIGH_BYTE(r_);                                                                     \
+        l = GET_LOW_BYTE(r_);                                                                      \
+    } while (0)
+#define ADD_SP_E8(dst)                                                                             \
+    do {                                                                                           \
+        u8 e_ = FETCH8();                                                                          \
+        f     = (((sp & 0x0F) + (e_ & 0x0F) > 0x0F) ? FLAG_HF_CARRY : 0) |                         \
+            (((sp & 0xFF) + e_ > 0xFF) ? FLAG_CARRY : 0);                                          \
+        (dst) = (u16)(sp + (i8)e_);                                                                \
+    } while (0)
+#define DAA()                                                                                      \
+    do {                                                                                           \
+        u8 corr_  = 0;                                                                             \
+        u8 carry_ = f & FLAG_CARRY;                                                                \
+        if (f & FLAG_SUBT) {                                                                       \
+            if (f & FLAG_HF_CARRY)                                                                 \
+                corr_ |= 0x06;                                                                     \
+            if (carry_)                                                                            \
+                corr_ |= 0x60;                                                                     \
+            a -= corr_;                                                                            \
+        } else {                                                                                   \
+            if ((f & FLAG_HF_CARRY) || (a & 0x0F) > 0x09)                                          \
+                corr_ |= 0x06;                                                                     \
+            if (carry_ || a > 0x99) {                                                              \
+                corr_ |= 0x60;                                                                     \
+                carry_ = FLAG_CARRY;                                                               \
+            }                                                                                      \
+            a += corr_;                                                                            \
+        }                                                                                          \
+        f = (f & FLAG_SUBT) | carry_ | ZERO_IF(a);                                                 \
+    } while (0)
+
+// ---------------------------------------------
+// Control flow (taken / not taken T-cycles)
+// A JR taken back onto a polling loop skips the iterations that can't see a change, once a whole
+// iteration ran in this call: an earlier read may predate the event that ended the last one
+// ---------------------------------------------
+#define JR(cond)                                                                                   \
+    do {                                                                                           \
+        i8 e_ = (i8)FETCH8();                                                                      \
+        if (cond) {                                                                                \
+            pc += e_;                                                                              \
+            if (e_ == -IDLE_LOOP_LEN && gb->cycles + 12 >= start + IDLE_LOOP_CYCLES &&             \
+                cpu_is_idle_loop(cpu, pc))                                                         \
+                gb->cycles += cpu_idle_loop_skip(gb->cycles + 12, gb->sched.deadline);             \
+            NEXT(12);                                                                              \
+        }                                                                                          \
+        NEXT(8);                                                                                   \
+    } while (0)
+#define JP_IF(cond)                                                                                \
+    do {                                                                                           \
+        tmp16 = FETCH16();                                                                         \
+        if (cond) {                                                                                \
+            pc = tmp16;                                                                            \
+            NEXT(16);                                                                              \
+        }                                                                                          \
+        NEXT(12);                                                                                  \
+    } while (0)
+#define CALL_IF(cond)                                                                              \
+    do {                                                                                           \
+        tmp16 = FETCH16();                                                                         \
+        if (cond) {                                                                                \
+            PUSH16(pc);                                                                            \
+            pc = tmp16;                                                                            \
+            NEXT(24);                                                                              \
+        }                                                                                          \
+        NEXT(12);                                                                                  \
+    } while (0)
+#define RET_IF(cond)                                                                               \
+    do {                                                                                           \
+        if (cond) {                                                                                \
+            pc = POP16();                                                                          \
+            NEXT(20);                                                                              \
+        }                                                                                          \
+        NEXT(8);                                                                                   \
+    } while (0)
+#define RST(vector)                                                                                \
+    do {                                                                                           \
+        PUSH16(pc);                                                                                \
+        pc = (vector);                                                                             \
+        NEXT(16);                                                                                  \
+    } while (0)
+
+// ---------------------------------------------
+// CB prefix (flags computed exactly as in cpu_cb.c)
+// Applies the operation in bits 7-3 of opcode to value; BIT only sets the flags
+// ---------------------------------------------
+static inline u8 cb_apply(u8 opcode, u8 value, u8 *f) {
+    u8 bit = (opcode >> 3) & 7;
+    u8 r;
+
+    switch (opcode >> 6) {
+    case 1: // BIT
+        *f = (CHECK_BIT(value, bit) ? 0 : FLAG_ZERO) | FLAG_HF_CARRY | (*f & FLAG_CARRY);
+        return value;
+    case 2: // RES
+        return CLEAR_BIT(value, bit);
+    case 3: // SET
+        return SET_BIT(value, bit);
+    }
+
+    switch (bit) {
+    case 0: // RLC
+        r = (u8)(value << 1) | (value >> 7);
+        break;
+    case 1: // RRC
+        r = (u8)(value >> 1) | (u8)(value << 7);
+        break;
+    case 2: // RL
+        r = (u8)(value << 1) | ((*f & FLAG_CARRY) ? 0x01 : 0);
+        break;
+    case 3: // RR
+        r = (u8)(value >> 1) | ((*f & FLAG_CARRY) ? 0x80 : 0);
+        break;
+    case 4: // SLA
+        r = (u8)(value << 1);
+        break;
+    case 5: // SRA
+        r = (value >> 1) | (value & 0x80);
+        break;
+    case 6: // SWAP
+        r = (u8)(value << 4) | (value >> 4);
+        break;
+    default: // SRL
+        r = value >> 1;
+        break;
+    }
+
+    // Left shifts carry out bit 7, right shifts bit 0, SWAP clears C
+    u8 carry = (bit == 6) ? 0 : (bit & 1) ? (value & 1) : (value >> 7);
+    *f       = (r ? 0 : FLAG_ZERO) | (carry ? FLAG_CARRY : 0);
+    return r;
+}
+
+// ---------------------------------------------
+// Run loop
+// ---------------------------------------------
+u32 cpu_run(CPU *cpu, u32 budget) {
+    GameBoy *gb    = cpu->gb;
+    u64      start = gb->cycles;
+
+    // Budget end or next event, lowered if an instruction schedules an earlier one
+    sched_set_deadline(&gb->sched, start + budget);
+
+    u8       a = cpu->regs.a, f = cpu->regs.f;
+    u8       b = cpu->regs.b, c = cpu->regs.c;
+    u8       d = cpu->regs.d, e = cpu->regs.e;
+    u8       h = cpu->regs.h, l = cpu->regs.l;
+    u16      pc = cpu->pc, sp = cpu->sp;
+    u8       opcode = 0, tmp8;
+    u16      tmp16;
+
+#if USE_COMPUTED_GOTO
+    // clang-format off
+    static const void *const dispatch_table[256] = {
+        &&op_00, &&op_01, &&op_02, &&op_03, &&op_04, &&op_05, &&op_06, &&op_07,
+        &&op_08, &&op_09, &&op_0A, &&op_0B, &&op_0C, &&op_0D, &&op_0E, &&op_0F,
+        &&op_10, &&op_11, &&op_12, &&op_13, &&op_14, &&op_15, &&op_16, &&op_17,
+        &&op_18, &&op_19, &&op_1A, &&op_1B, &&op_1C, &&op_1D, &&op_1E, &&op_1F,
+        &&op_20, &&op_21, &&op_22, &&op_23, &&op_24, &&op_25, &&op_26, &&op_27,
+        &&op_28, &&op_29, &&op_2A, &&op_2B, &&op_2C, &&op_2D, &&op_2E, &&op_2F,
+        &&op_30, &&op_31, &&op_32, &&op_33, &&op_34, &&op_35, &&op_36, &&op_37,
+        &&op_38, &&op_39, &&op_3A, &&op_3B, &&op_3C, &&op_3D, &&op_3E, &&op_3F,
+        &&op_40, &&op_41, &&op_42, &&op_43, &&op_44, &&op_45, &&op_46, &&op_47,
+        &&op_48, &&op_49, &&op_4A, &&op_4B, &&op_4C, &&op_4D, &&op_4E, &&op_4F,
+        &&op_50, &&op_51, &&op_52, &&op_53, &&op_54, &&op_55, &&op_56, &&op_57,
+        &&op_58, &&op_59, &&op_5A, &&op_5B, &&op_5C, &&op_5D, &&op_5E, &&op_5F,
+        &&op_60, &&op_61, &&op_62, &&op_63, &&op_64, &&op_65, &&op_66, &&op_67,
+        &&op_68, &&op_69, &&op_6A, &&op_6B, &&op_6C, &&op_6D, &&op_6E, &&op_6F,
+        &&op_70, &&op_71, &&op_72, &&op_73, &&op_74, &&op_75, &&op_76, &&op_77,
+        &&op_78, &&op_79, &&op_7A, &&op_7B, &&op_7C, &&op_7D, &&op_7E, &&op_7F,
+        &&op_80, &&op_81, &&op_82, &&op_83, &&op_84, &&op_85, &&op_86, &&op_87,
+        &&op_88, &&op_89, &&op_8A, &&op_8B, &&op_8C, &&op_8D, &&op_8E, &&op_8F,
+        &&op_90, &&op_91, &&op_92, &&op_93, &&op_94, &&op_95, &&op_96, &&op_97,
+        &&op_98, &&op_99, &&op_9A, &&op_9B, &&op_9C, &&op_9D, &&op_9E, &&op_9F,
+        &&op_A0, &&op_A1, &&op_A2, &&op_A3, &&op_A4, &&op_A5, &&op_A6, &&op_A7,
+        &&op_A8, &&op_A9, &&op_AA, &&op_AB, &&op_AC, &&op_AD, &&op_AE, &&op_AF,
+        &&op_B0, &&op_B1, &&op_B2, &&op_B3, &&op_B4, &&op_B5, &&op_B6, &&op_B7,
+        &&op_B8, &&op_B9, &&op_BA, &&op_BB, &&op_BC, &&op_BD, &&op_BE, &&op_BF,
+        &&op_C0, &&op_C1, &&op_C2, &&op_C3, &&op_C4, &&op_C5, &&op_C6, &&op_C7,
+        &&op_C8, &&op_C9, &&op_CA, &&op_CB, &&op_CC, &&op_CD, &&op_CE, &&op_CF,
+        &&op_D0, &&op_D1, &&op_D2, &&op_illegal, &&op_D4, &&op_D5, &&op_D6, &&op_D7,
+        &&op_D8, &&op_D9, &&op_DA, &&op_illegal, &&op_DC, &&op_illegal, &&op_DE, &&op_DF,
+        &&op_E0, &&op_E1, &&op_E2, &&op_illegal, &&op_illegal, &&op_E5, &&op_E6, &&op_E7,
+        &&op_E8, &&op_E9, &&op_EA, &&op_illegal, &&op_illegal, &&op_illegal, &&op_EE, &&op_EF,
+        &&op_F0, &&op_F1, &&op_F2, &&op_F3, &&op_illegal, &&op_F5, &&op_F6, &&op_F7,
+        &&op_F8, &&op_F9, &&op_FA, &&op_FB, &&op_illegal, &&op_illegal, &&op_FE, &&op_FF,
+    };
+    // clang-format on
+#endif
+
+    // Nothing can end HALT before the deadline
+    if (cpu->halted && !cpu->int_pending) {
+        gb->cycles += cpu_halt_skip(gb->cycles, gb->sched.deadline);
+        return (u32)(gb->cycles - start);
+    }
+
+    if (gb->cycles >= gb->sched.deadline)
+        goto done;
+
+    // IME from an EI executed at the end of the previous call
+    if (cpu->ime_scheduled) {
+        cpu->ime           = true;
+        cpu->ime_scheduled = false;
+        cpu_update_interrupts(cpu);
+    }
+
+    // Wakes a halted CPU too
+    if (cpu->int_pending)
+        goto interrupt;
+
+    opcode = FETCH8();
+
+#if USE_COMPUTED_GOTO
+    DISPATCH();
+    {
+#else
+dispatch:
+    switch (opcode) {
+#endif
+        OP(00) // NOP
+            NEXT(4);
+        OP(01) // LD BC, n16
+            c = FETCH8();
+            b = FETCH8();
+            NEXT(12);
+        OP(02) // LD (BC), A
+            WRITE8(PAIR(b, c), a);
+            NEXT(8);
+        OP(03) // INC BC
+            INC16(b, c);
+            NEXT(8);
+        OP(04) // INC B
+            INC8(b);
+            NEXT(4);
+        OP(05) // DEC B
+            DEC8(b);
+            NEXT(4);
+        OP(06) // LD B, n8
+            b = FETCH8();
+            NEXT(8);
+        OP(07) // RLCA
+            f = (a >> 7) ? FLAG_CARRY : 0;
+            a = (u8)(a << 1) | (a >> 7);
+            NEXT(4);
+        OP(08) // LD (a16), SP
+            tmp16 = FETCH16();
+            WRITE8(tmp16, GET_LOW_BYTE(sp));
+            WRITE8(tmp16 + 1, GET_HIGH_BYTE(sp));
+            NEXT(20);
+        OP(09) // ADD HL, BC
+            ADD_HL(PAIR(b, c));
+            NEXT(8);
+        OP(0A) // LD A, (BC)
+            a = READ8(PAIR(b, c));
+            NEXT(8);
+        OP(0B) // DEC BC
+            DEC16(b, c);
+            NEXT(8);
+        OP(0C) // INC C
+            INC8(c);
+            NEXT(4);
+        OP(0D) // DEC C
+            DEC8(c);
+            NEXT(4);
+        OP(0E) // LD C, n8
+            c = FETCH8();
+            NEXT(8);
+        OP(0F) // RRCA
+            f = (a & 1) ? FLAG_CARRY : 0;
+            a = (u8)(a >> 1) | (u8)(a << 7);
+            NEXT(4);
+        OP(10) // STOP (treated as a 2-byte NOP, see instr_stop)
+            pc++;
+            NEXT(4);
+        OP(11) // LD DE, n16
+            e = FETCH8();
+            d = FETCH8();
+            NEXT(12);
+        OP(12) // LD (DE), A
+            WRITE8(PAIR(d, e), a);
+            NEXT(8);
+        OP(13) // INC DE
+            INC16(d, e);
+            NEXT(8);
+        OP(14) // INC D
+            INC8(d);
+            NEXT(4);
+        OP(15) // DEC D
+            DEC8(d);
+            NEXT(4);
+        OP(16) // LD D, n8
+            d = FETCH8();
+            NEXT(8);
+        OP(17) // RLA
+            tmp8 = CARRY_IN();
+            f = (a >> 7) ? FLAG_CARRY : 0;
+            a = (u8)(a << 1) | tmp8;
+            NEXT(4);
+        OP(18) // JR e8
+            JR(true);
+        OP(19) // ADD HL, DE
+            ADD_HL(PAIR(d, e));
+            NEXT(8);
+        OP(1A) // LD A, (DE)
+            a = READ8(PAIR(d, e));
+            NEXT(8);
+        OP(1B) // DEC DE
+            DEC16(d, e);
+            NEXT(8);
+        OP(1C) // INC E
+            INC8(e);
+            NEXT(4);
+        OP(1D) // DEC E
+            DEC8(e);
+            NEXT(4);
+        OP(1E) // LD E, n8
+            e = FETCH8();
+            NEXT(8);
+        OP(1F) // RRA
+            tmp8 = CARRY_IN();
+            f = (a & 1) ? FLAG_CARRY : 0;
+            a = (a >> 1) | (u8)(tmp8 << 7);
+            NEXT(4);
+        OP(20) // JR NZ, e8
+            JR(!(f & FLAG_ZERO));
+        OP(21) // LD HL, n16
+            l = FETCH8();
+            h = FETCH8();
+            NEXT(12);
+        OP(22) // LD (HL+), A
+            WRITE8(PAIR(h, l), a);
+            INC16(h, l);
+            NEXT(8);
+        OP(23) // INC HL
+            INC16(h, l);
+            NEXT(8);
+        OP(24) // INC H
+            INC8(h);
+            NEXT(4);
+        OP(25) // DEC H
+            DEC8(h);
+            NEXT(4);
+        OP(26) // LD H, n8
+            h = FETCH8();
+            NEXT(8);
+        OP(27) // DAA
+            DAA();
+            NEXT(4);
+        OP(28) // JR Z, e8
+            JR(f & FLAG_ZERO);
+        OP(29) // ADD HL, HL
+            ADD_HL(PAIR(h, l));
+            NEXT(8);
+        OP(2A) // LD A, (HL+)
+            a = READ8(PAIR(h, l));
+            INC16(h, l);
+            NEXT(8);
+        OP(2B) // DEC HL
+            DEC16(h, l);
+            NEXT(8);
+        OP(2C) // INC L
+            INC8(l);
+            NEXT(4);
+        OP(2D) // DEC L
+            DEC8(l);
+            NEXT(4);
+        OP(2E) // LD L, n8
+            l = FETCH8();
+            NEXT(8);
+        OP(2F) // CPL
+            a = ~a;
+            f |= FLAG_SUBT | FLAG_HF_CARRY;
+            NEXT(4);
+        OP(30) // JR NC, e8
+            JR(!(f & FLAG_CARRY));
+        OP(31) // LD SP, n16
+            sp = FETCH16();
+            NEXT(12);
+        OP(32) // LD (HL-), A
+            WRITE8(PAIR(h, l), a);
+            DEC16(h, l);
+            NEXT(8);
+        OP(33) // INC SP
+            sp++;
+            NEXT(8);
+        OP(34) // INC (HL)
+            tmp8 = READ8(PAIR(h, l));
+            INC8(tmp8);
+            WRITE8(PAIR(h, l), tmp8);
+            NEXT(12);
+        OP(35) // DEC (HL)
+            tmp8 = READ8(PAIR(h, l));
+            DEC8(tmp8);
+            WRITE8(PAIR(h, l), tmp8);
+            NEXT(12);
+        OP(36) // LD (HL), n8
+            tmp8 = FETCH8();
+            WRITE8(PAIR(h, l), tmp8);
+            NEXT(12);
+        OP(37) // SCF
+            f = (f & FLAG_ZERO) | FLAG_CARRY;
+            NEXT(4);
+        OP(38) // JR C, e8
+            JR(f & FLAG_CARRY);
+        OP(39) // ADD HL, SP
+            ADD_HL(sp);
+            NEXT(8);
+        OP(3A) // LD A, (HL-)
+            a = READ8(PAIR(h, l));
+            DEC16(h, l);
+            NEXT(8);
+        OP(3B) // DEC SP
+            sp--;
+            NEXT(8);
+        OP(3C) // INC A
+            INC8(a);
+            NEXT(4);
+        OP(3D) // DEC A
+            DEC8(a);
+            NEXT(4);
+        OP(3E) // LD A, n8
+            a = FETCH8();
+            NEXT(8);
+        OP(3F) // CCF
+            f = (f & (FLAG_ZERO | FLAG_CARRY)) ^ FLAG_CARRY;
+            NEXT(4);
+        OP(40) // LD B, B
+            NEXT(4);
+        OP(41) // LD B, C
+            b = c;
+            NEXT(4);
+        OP(42) // LD B, D
+            b = d;
+            NEXT(4);
+        OP(43) // LD B, E
+            b = e;
+            NEXT(4);
+        OP(44) // LD B, H
+            b = h;
+            NEXT(4);
+        OP(45) // LD B, L
+            b = l;
+            NEXT(4);
+        OP(46) // LD B, (HL)
+            b = READ8(PAIR(h, l));
+            NEXT(8);
+        OP(47) // LD B, A
+            b = a;
+            NEXT(4);
+        OP(48) // LD C, B
+            c = b;
+            NEXT(4);
+        OP(49) // LD C, C
+            NEXT(4);
+        OP(4A) // LD C, D
+            c = d;
+            NEXT(4);
+        OP(4B) // LD C, E
+            c = e;
+            NEXT(4);
+        OP(4C) // LD C, H
+            c = h;
+            NEXT(4);
+        OP(4D) // LD C, L
+            c = l;
+            NEXT(4);
+        OP(4E) // LD C, (HL)
+            c = READ8(PAIR(h, l));
+            NEXT(8);
+        OP(4F) // LD C, A
+            c = a;
+            NEXT(4);
+        OP(50) // LD D, B
+            d = b;
+            NEXT(4);
+        OP(51) // LD D, C
+            d = c;
+            NEXT(4);
+        OP(52) // LD D, D
+            NEXT(4);
+        OP(53) // LD D, E
+            d = e;
+            NEXT(4);
+        OP(54) // LD D, H
+            d = h;
+            NEXT(4);
+        OP(55) // LD D, L
+            d = l;
+            NEXT(4);
+        OP(56) // LD D, (HL)
+            d = READ8(PAIR(h, l));
+            NEXT(8);
+        OP(57) // LD D, A
+            d = a;
+            NEXT(4);
+        OP(58) // LD E, B
+            e = b;
+            NEXT(4);
+        OP(59) // LD E, C
+            e = c;
+            NEXT(4);
+        OP(5A) // LD E, D
+            e = d;
+            NEXT(4);
+        OP(5B) // LD E, E
+            NEXT(4);
+        OP(5C) // LD E, H
+            e = h;
+            NEXT(4);
+        OP(5D) // LD E, L
+            e = l;
+            NEXT(4);
+        OP(5E) // LD E, (HL)
+            e = READ8(PAIR(h, l));
+            NEXT(8);
+        OP(5F) // LD E, A
+            e = a;
+            NEXT(4);
+        OP(60) // LD H, B
+            h = b;
+            NEXT(4);
+        OP(61) // LD H, C
+            h = c;
+            NEXT(4);
+        OP(62) // LD H, D
+            h = d;
+            NEXT(4);
+        OP(63) // LD H, E
+            h = e;
+            NEXT(4);
+        OP(64) // LD H, H
+            NEXT(4);
+        OP(65) // LD H, L
+            h = l;
+            NEXT(4);
+        OP(66) // LD H, (HL)
+            h = READ8(PAIR(h, l));
+            NEXT(8);
+        OP(67) // LD H, A
+            h = a;
+            NEXT(4);
+        OP(68) // LD L, B
+            l = b;
+            NEXT(4);
+        OP(69) // LD L, C
+            l = c;
+            NEXT(4);
+        OP(6A) // LD L, D
+            l = d;
+            NEXT(4);
+        OP(6B) // LD L, E
+            l = e;
+            NEXT(4);
+        OP(6C) // LD L, H
+            l = h;
+            NEXT(4);
+        OP(6D) // LD L, L
+            NEXT(4);
+        OP(6E) // LD L, (HL)
+            l = READ8(PAIR(h, l));
+            NEXT(8);
+        OP(6F) // LD L, A
+            l = a;
+            NEXT(4);
+        OP(70) // LD (HL), B
+            WRITE8(PAIR(h, l), b);
+            NEXT(8);
+        OP(71) // LD (HL), C
+            WRITE8(PAIR(h, l), c);
+            NEXT(8);
+        OP(72) // LD (HL), D
+            WRITE8(PAIR(h, l), d);
+            NEXT(8);
+        OP(73) // LD (HL), E
+            WRITE8(PAIR(h, l), e);
+            NEXT(8);
+        OP(74) // LD (HL), H
+            WRITE8(PAIR(h, l), h);
+            NEXT(8);
+        OP(75) // LD (HL), L
+            WRITE8(PAIR(h, l), l);
+            NEXT(8);
+        OP(76) // HALT
+            goto halt;
+        OP(77) // LD (HL), A
+            WRITE8(PAIR(h, l), a);
+            NEXT(8);
+        OP(78) // LD A, B
+            a = b;
+            NEXT(4);
+        OP(79) // LD A, C
+            a = c;
+            NEXT(4);
+        OP(7A) // LD A, D
+            a = d;
+            NEXT(4);
+        OP(7B) // LD A, E
+            a = e;
+            NEXT(4);
+        OP(7C) // LD A, H
+            a = h;
+            NEXT(4);
+        OP(7D) // LD A, L
+            a = l;
+            NEXT(4);
+        OP(7E) // LD A, (HL)
+            a = READ8(PAIR(h, l));
+            NEXT(8);
+        OP(7F) // LD A, A
+            NEXT(4);
+        OP(80) // ADD A, B
+            ALU_ADD(b);
+            NEXT(4);
+        OP(81) // ADD A, C
+            ALU_ADD(c);
+            NEXT(4);
+        OP(82) // ADD A, D
+            ALU_ADD(d);
+            NEXT(4);
+        OP(83) // ADD A, E
+            ALU_ADD(e);
+            NEXT(4);
+        OP(84) // ADD A, H
+            ALU_ADD(h);
+            NEXT(4);
+        OP(85) // ADD A, L
+            ALU_ADD(l);
+            NEXT(4);
+        OP(86) // ADD A, (HL)
+            ALU_ADD(READ8(PAIR(h, l)));
+            NEXT(8);
+        OP(87) // ADD A, A
+            ALU_ADD(a);
+            NEXT(4);
+        OP(88) // ADC A, B
+            ALU_ADC(b);
+            NEXT(4);
+        OP(89) // ADC A, C
+            ALU_ADC(c);
+            NEXT(4);
+        OP(8A) // ADC A, D
+            ALU_ADC(d);
+            NEXT(4);
+        OP(8B) // ADC A, E
+            ALU_ADC(e);
+            NEXT(4);
+        OP(8C) // ADC A, H
+            ALU_ADC(h);
+            NEXT(4);
+        OP(8D) // ADC A, L
+            ALU_ADC(l);
+            NEXT(4);
+        OP(8E) // ADC A, (HL)
+            ALU_ADC(READ8(PAIR(h, l)));
+            NEXT(8);
+        OP(8F) // ADC A, A
+            ALU_ADC(a);
+            NEXT(4);
+        OP(90) // SUB A, B
+            ALU_SUB(b);
+            NEXT(4);
+        OP(91) // SUB A, C
+            ALU_SUB(c);
+            NEXT(4);
+        OP(92) // SUB A, D
+            ALU_SUB(d);
+            NEXT(4);
+        OP(93) // SUB A, E
+            ALU_SUB(e);
+            NEXT(4);
+        OP(94) // SUB A, H
+            ALU_SUB(h);
+            NEXT(4);
+        OP(95) // SUB A, L
+            ALU_SUB(l);
+            NEXT(4);
+        OP(96) // SUB A, (HL)
+            ALU_SUB(READ8(PAIR(h, l)));
+            NEXT(8);
+        OP(97) // SUB A, A
+            ALU_SUB(a);
+            NEXT(4);
+        OP(98) // SBC A, B
+            ALU_SBC(b);
+            NEXT(4);
+        OP(99) // SBC A, C
+            ALU_SBC(c);
+            NEXT(4);
+        OP(9A) // SBC A, D
+            ALU_SBC(d);
+            NEXT(4);
+        OP(9B) // SBC A, E
+            ALU_SBC(e);
+            NEXT(4);
+        OP(9C) // SBC A, H
+            ALU_SBC(h);
+            NEXT(4);
+        OP(9D) // SBC A, L
+            ALU_SBC(l);
+            NEXT(4);
+        OP(9E) // SBC A, (HL)
+            ALU_SBC(READ8(PAIR(h, l)));
+            NEXT(8);
+        OP(9F) // SBC A, A
+            ALU_SBC(a);
+            NEXT(4);
+        OP(A0) // AND A, B
+            ALU_AND(b);
+            NEXT(4);
+        OP(A1) // AND A, C
+            ALU_AND(c);
+            NEXT(4);
+        OP(A2) // AND A, D
+            ALU_AND(d);
+            NEXT(4);
+        OP(A3) // AND A, E
+            ALU_AND(e);
+            NEXT(4);
+        OP(A4) // AND A, H
+            ALU_AND(h);
+            NEXT(4);
+        OP(A5) // AND A, L
+            ALU_AND(l);
+            NEXT(4);
+        OP(A6) // AND A, (HL)
+            ALU_AND(READ8(PAIR(h, l)));
+            NEXT(8);
+        OP(A7) // AND A, A
+            ALU_AND(a);
+            NEXT(4);
+        OP(A8) // XOR A, B
+            ALU_XOR(b);
+            NEXT(4);
+        OP(A9) // XOR A, C
+            ALU_XOR(c);
+            NEXT(4);
+        OP(AA) // XOR A, D
+            ALU_XOR(d);
+            NEXT(4);
+        OP(AB) // XOR A, E
+            ALU_XOR(e);
+            NEXT(4);
+        OP(AC) // XOR A, H
+            ALU_XOR(h);
+            NEXT(4);
+        OP(AD) // XOR A, L
+            ALU_XOR(l);
+            NEXT(4);
+        OP(AE) // XOR A, (HL)
+            ALU_XOR(READ8(PAIR(h, l)));
+            NEXT(8);
+        OP(AF) // XOR A, A
+            ALU_XOR(a);
+            NEXT(4);
+        OP(B0) // OR A, B
+            ALU_OR(b);
+            NEXT(4);
+        OP(B1) // OR A, C
+            ALU_OR(c);
+            NEXT(4);
+        OP(B2) // OR A, D
+            ALU_OR(d);
+            NEXT(4);
+        OP(B3) // OR A, E
+            ALU_OR(e);
+            NEXT(4);
+        OP(B4) // OR A, H
+            ALU_OR(h);
+            NEXT(4);
+        OP(B5) // OR A, L
+            ALU_OR(l);
+            NEXT(4);
+        OP(B6) // OR A, (HL)
+            ALU_OR(READ8(PAIR(h, l)));
+            NEXT(8);
+        OP(B7) // OR A, A
+            ALU_OR(a);
+            NEXT(4);
+        OP(B8) // CP A, B
+            ALU_CP(b);
+            NEXT(4);
+        OP(B9) // CP A, C
+            ALU_CP(c);
+            NEXT(4);
+        OP(BA) // CP A, D
+            ALU_CP(d);
+            NEXT(4);
+        OP(BB) // CP A, E
+            ALU_CP(e);
+            NEXT(4);
+        OP(BC) // CP A, H
+            ALU_CP(h);
+            NEXT(4);
+        OP(BD) // CP A, L
+            ALU_CP(l);
+            NEXT(4);
+        OP(BE) // CP A, (HL)
+            ALU_CP(READ8(PAIR(h, l)));
+            NEXT(8);
+        OP(BF) // CP A, A
+            ALU_CP(a);
+            NEXT(4);
+        OP(C0) // RET NZ
+            RET_IF(!(f & FLAG_ZERO));
+        OP(C1) // POP BC
+            tmp16 = POP16();
+            b = GET_HIGH_BYTE(tmp16);
+            c = GET_LOW_BYTE(tmp16);
+            NEXT(12);
+        OP(C2) // JP NZ, a16
+            JP_IF(!(f & FLAG_ZERO));
+        OP(C3) // JP a16
+            JP_IF(true);
+        OP(C4) // CALL NZ, a16
+            CALL_IF(!(f & FLAG_ZERO));
+        OP(C5) // PUSH BC
+            PUSH16(PAIR(b, c));
+            NEXT(16);
+        OP(C6) // ADD A, n8
+            ALU_ADD(FETCH8());
+            NEXT(8);
+        OP(C7) // RST 0x00
+            RST(0x00);
+        OP(C8) // RET Z
+            RET_IF(f & FLAG_ZERO);
+        OP(C9) // RET
+            pc = POP16();
+            NEXT(16);
+        OP(CA) // JP Z, a16
+            JP_IF(f & FLAG_ZERO);
+        OP(CB) // PREFIX CB, operand from bits 2-0 of the CB opcode
+            opcode = FETCH8();
+            switch (opcode & 7) {
+            case 0:
+                b = cb_apply(opcode, b, &f);
+                break;
+            case 1:
+                c = cb_apply(opcode, c, &f);
+                break;
+            case 2:
+                d = cb_apply(opcode, d, &f);
+                break;
+            case 3:
+                e = cb_apply(opcode, e, &f);
+                break;
+            case 4:
+                h = cb_apply(opcode, h, &f);
+                break;
+            case 5:
+                l = cb_apply(opcode, l, &f);
+                break;
+            case 7:
+                a = cb_apply(opcode, a, &f);
+                break;
+            default: // (HL): BIT only reads it
+                tmp16 = PAIR(h, l);
+                tmp8  = cb_apply(opcode, READ8(tmp16), &f);
+                if ((opcode >> 6) == 1)
+                    NEXT(12);
+                WRITE8(tmp16, tmp8);
+                NEXT(16);
+            }
+            NEXT(8);
+        OP(CC) // CALL Z, a16
+            CALL_IF(f & FLAG_ZERO);
+        OP(CD) // CALL a16
+            CALL_IF(true);
+        OP(CE) // ADC A, n8
+            ALU_ADC(FETCH8());
+            NEXT(8);
+        OP(CF) // RST 0x08
+            RST(0x08);
+        OP(D0) // RET NC
+            RET_IF(!(f & FLAG_CARRY));
+        OP(D1) // POP DE
+            tmp16 = POP16();
+            d = GET_HIGH_BYTE(tmp16);
+            e = GET_LOW_BYTE(tmp16);
+            NEXT(12);
+        OP(D2) // JP NC, a16
+            JP_IF(!(f & FLAG_CARRY));
+        OP(D4) // CALL NC, a16
+            CALL_IF(!(f & FLAG_CARRY));
+        OP(D5) // PUSH DE
+            PUSH16(PAIR(d, e));
+            NEXT(16);
+        OP(D6) // SUB A, n8
+            ALU_SUB(FETCH8());
+            NEXT(8);
+        OP(D7) // RST 0x10
+            RST(0x10);
+        OP(D8) // RET C
+            RET_IF(f & FLAG_CARRY);
+        OP(D9) // RETI
+            pc = POP16();
+            cpu->ime = true;
+            cpu_update_interrupts(cpu);
+            NEXT(16);
+        OP(DA) // JP C, a16
+            JP_IF(f & FLAG_CARRY);
+        OP(DC) // CALL C, a16
+            CALL_IF(f & FLAG_CARRY);
+        OP(DE) // SBC A, n8
+            ALU_SBC(FETCH8());
+            NEXT(8);
+        OP(DF) // RST 0x18
+            RST(0x18);
+        OP(E0) // LDH (a8), A
+            tmp8 = FETCH8();
+            WRITE8(0xFF00 + tmp8, a);
+            NEXT(12);
+        OP(E1) // POP HL
+            tmp16 = POP16();
+            h = GET_HIGH_BYTE(tmp16);
+            l = GET_LOW_BYTE(tmp16);
+            NEXT(12);
+        OP(E2) // LDH (C), A
+            WRITE8(0xFF00 + c, a);
+            NEXT(8);
+        OP(E5) // PUSH HL
+            PUSH16(PAIR(h, l));
+            NEXT(16);
+        OP(E6) // AND A, n8
+            ALU_AND(FETCH8());
+            NEXT(8);
+        OP(E7) // RST 0x20
+            RST(0x20);
+        OP(E8) // ADD SP, e8
+            ADD_SP_E8(sp);
+            NEXT(16);
+        OP(E9) // JP HL
+            pc = PAIR(h, l);
+            NEXT(4);
+        OP(EA) // LD (a16), A
+            tmp16 = FETCH16();
+            WRITE8(tmp16, a);
+            NEXT(16);
+        OP(EE) // XOR A, n8
+            ALU_XOR(FETCH8());
+            NEXT(8);
+        OP(EF) // RST 0x28
+            RST(0x28);
+        OP(F0) // LDH A, (a8)
+            tmp8 = FETCH8();
+            a = READ8(0xFF00 + tmp8);
+            NEXT(12);
+        OP(F1) // POP AF
+            tmp16 = POP16();
+            a = GET_HIGH_BYTE(tmp16);
+            f = GET_LOW_BYTE(tmp16) & 0xF0;
+            NEXT(12);
+        OP(F2) // LDH A, (C)
+            a = READ8(0xFF00 + c);
+            NEXT(8);
+        OP(F3) // DI
+            cpu->ime = false;
+            cpu_update_interrupts(cpu);
+            NEXT(4);
+        OP(F5) // PUSH AF
+            PUSH16(PAIR(a, f));
+            NEXT(16);
+        OP(F6) // OR A, n8
+            ALU_OR(FETCH8());
+            NEXT(8);
+        OP(F7) // RST 0x30
+            RST(0x30);
+        OP(F8) // LD HL, SP + e8
+            ADD_SP_E8(tmp16);
+            h = GET_HIGH_BYTE(tmp16);
+            l = GET_LOW_BYTE(tmp16);
+            NEXT(12);
+        OP(F9) // LD SP, HL
+            sp = PAIR(h, l);
+            NEXT(8);
+        OP(FA) // LD A, (a16)
+            tmp16 = FETCH16();
+            a = READ8(tmp16);
+            NEXT(16);
+        OP(FB) // EI
+            goto ei;
+        OP(FE) // CP A, n8
+            ALU_CP(FETCH8());
+            NEXT(8);
+        OP(FF) // RST 0x38
+            RST(0x38);
+
+    OP_ILLEGAL
+        fprintf(stderr, "Illegal Operation Code: 0x%02x at PC = 0x%04x\n", opcode, (u16)(pc - 1));
+        NEXT(ILLEGAL);
+    }
+
+halt:
+    cpu->halted = true;
+    cpu_update_interrupts(cpu);
+    gb->cycles += 4;
+    goto done;
+
+ei:
+    // IME turns on once the instruction after EI starts (see cpu_step)
+    cpu->ime_scheduled = true;
+    gb->cycles += 4;
+    if (gb->cycles >= gb->sched.deadline)
+        goto done;
+    cpu->ime           = true;
+    cpu->ime_scheduled = false;
+    cpu_update_interrupts(cpu);
+    opcode = FETCH8();
+    DISPATCH();
+
+interrupt:
+    // Dispatch (or end HALT) with PC and SP in the CPU, where cpu_service_interrupt pushes from
+    cpu->pc     = pc;
+    cpu->sp     = sp;
+    gb->cycles += cpu_service_interrupt(cpu);
+    pc          = cpu->pc;
+    sp          = cpu->sp;
+    if (gb->cycles >= gb->sched.deadline)
+        goto done;
+    opcode = FETCH8();
+    DISPATCH();
+
+done:
+    cpu->regs.a = a;
+    cpu->regs.f = f;
+    cpu->regs.b = b;
+    cpu->regs.c = c;
+    cpu->regs.d = d;
+    cpu->regs.e = e;
+    cpu->regs.h = h;
+    cpu->regs.l = l;
+    cpu->pc     = pc;
+    cpu->sp     = sp;
+
+    return (u32)(gb->cycles - start);
+}
@@ -0,0 +1,216 @@
+// src/core/fork.c
+#include <core/fork.h>
+#include <core/bus.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WRAM_PAGES (0x2000 >> MMU_PAGE_SHIFT)
+
+// WRAM and cart RAM as they were when the first fork was taken, never written afterwards
+// Released by the last instance sharing a page of it, possibly on another thread
+struct ForkSnapshot {
+    unsigned refs;
+    size_t   ram_size;
+    u8       wram[0x2000];
+    u8       ram[];
+};
+
+// ---------------------------------------------
+// Pages
+// Tracked pages are numbered WRAM first (0 - 31), then cart RAM
+// ---------------------------------------------
+static inline bool page_shared(const GameBoy *gb, unsigned page) {
+    return (gb->fork_shared[page / 64] >> (page % 64)) & 1;
+}
+
+static inline unsigned tracked_pages(const ForkSnapshot *base) {
+    return WRAM_PAGES + (unsigned)(base->ram_size >> MMU_PAGE_SHIFT);
+}
+
+static inline const u8 *source_page(const GameBoy *gb, unsigned page) {
+    return page < WRAM_PAGES ? gb->wram + page * MMU_PAGE_SIZE
+                             : gb->cart.ram + (page - WRAM_PAGES) * MMU_PAGE_SIZE;
+}
+
+static inline u8 *own_page(GameBoy *gb, unsigned page) {
+    return (u8 *)source_page(gb, page);
+}
+
+static inline u8 *base_page(ForkSnapshot *base, unsigned page) {
+    return page < WRAM_PAGES ? base->wram + page * MMU_PAGE_SIZE
+                             : base->ram + (page - WRAM_PAGES) * MMU_PAGE_SIZE;
+}
+
+// Page of the snapshot host points into, -1 if it's elsewhere
+static int base_page_index(const ForkSnapshot *base, const u8 *host) {
+    if (host >= base->wram && host < base->wram + sizeof(base->wram))
+        return (int)((host - base->wram) >> MMU_PAGE_SHIFT);
+    if (host >= base->ram && host < base->ram + base->ram_size)
+        return WRAM_PAGES + (int)((host - base->ram) >> MMU_PAGE_SHIFT);
+    return -1;
+}
+
+// ---------------------------------------------
+// Snapshots
+// ---------------------------------------------
+static ForkSnapshot *snapshot_take(const GameBoy *gb) {
+    size_t ram_size = gb->cart.ram ? gb->cart.ram_size : 0;
+
+    // Cart RAM past what the page bitmap covers can't be shared
+    if (ram_size > ((size_t)(GB_FORK_PAGES - WRAM_PAGES) << MMU_PAGE_SHIFT))
+        return NULL;
+
+    ForkSnapshot *base = malloc(sizeof(ForkSnapshot) + ram_size);
+    if (!base)
+        return NULL;
+
+    base->refs     = 1;
+    base->ram_size = ram_size;
+    memcpy(base->wram, gb->wram, sizeof(base->wram));
+    if (ram_size)
+        memcpy(base->ram, gb->cart.ram, ram_size);
+    return base;
+}
+
+static void snapshot_release(ForkSnapshot *base) {
+    if (base && __atomic_sub_fetch(&base->refs, 1, __ATOMIC_ACQ_REL) == 0)
+        free(base);
+}
+
+// ---------------------------------------------
+// Fork / Free
+// ---------------------------------------------
+GameBoy *gb_fork(const GameBoy *gb) {
+    GameBoy      *fork = malloc(sizeof(GameBoy));
+    u8           *ram  = gb->cart.ram ? malloc(gb->cart.ram_size) : NULL;
+    ForkSnapshot *base = gb->fork_base;
+
+    if (base)
+        __atomic_add_fetch(&base->refs, 1, __ATOMIC_RELAXED);
+    else
+        base = snapshot_take(gb);
+
+    if (!fork || (gb->cart.ram && !ram) || !base) {
+        snapshot_release(base);
+        free(ram);
+        free(fork);
+        return NULL;
+    }
+
+    // Everything but WRAM (shared) and the decode cache (refilled on demand)
+    memcpy(fork, gb, offsetof(GameBoy, wram));
+    memcpy(&fork->oam, &gb->oam, offsetof(GameBoy, decode) - offsetof(GameBoy, oam));
+    memcpy(&fork->breakpoints, &gb->breakpoints,
+           sizeof(GameBoy) - offsetof(GameBoy, breakpoints));
+
+    fork->cpu.gb          = fork;
+    cart_share_rom(&fork->cart, &gb->cart);
+    fork->cart.ram        = ram;
+    fork->cart.ram_mapped = false;
+
+    // The .sav file stays with the source
+    fork->save_sync_cycles = 0;
+    sched_cancel(&fork->sched, SCHED_SAVE);
+
+    // Pages the source already wrote are its own, copy them now. The rest stay shared
+    fork->fork_base = base;
+    memset(fork->fork_shared, 0, sizeof(fork->fork_shared));
+
+    for (unsigned page = 0; page < tracked_pages(base); page++) {
+        if (gb->fork_base && !page_shared(gb, page))
+            memcpy(own_page(fork, page), source_page(gb, page), MMU_PAGE_SIZE);
+        else
+            fork->fork_shared[page / 64] |= 1ULL << (page % 64);
+    }
+
+    mmu_map_update(fork);
+    return fork;
+}
+
+void gb_fork_free(GameBoy *gb) {
+    if (!gb)
+        return;
+
+    snapshot_release(gb->fork_base);
+    cart_unload(&gb->cart);
+    free(gb);
+}
+
+// ---------------------------------------------
+// Page table hooks
+// ---------------------------------------------
+void fork_map_shared(GameBoy *gb) {
+    ForkSnapshot *base = gb->fork_base;
+
+    // WRAM pages and their echo
+    for (unsigned page = 0; page < WRAM_PAGES; page++) {
+        if (!page_shared(gb, page))
+            continue;
+
+        for (unsigned at = 0xC0 + page; at < 0xFE; at += WRAM_PAGES) {
+            gb->read_map[at]  = base_page(base, page);
+            gb->write_map[at] = NULL;
+        }
+    }
+
+    // Cart RAM pages of the selected bank, if mapped at all
+    for (unsigned at = 0xA0; at < 0xC0; at++) {
+        if (!gb->read_map[at])
+            continue;
+
+        size_t   offset = (size_t)(gb->read_map[at] - gb->cart.ram);
+        unsigned page   = WRAM_PAGES + (unsigned)(offset >> MMU_PAGE_SHIFT);
+        if (page_shared(gb, page)) {
+            gb->read_map[at]  = base_page(base, page);
+            gb->write_map[at] = NULL;
+        }
+    }
+}
+
+bool fork_unshare(GameBoy *gb, u16 addr) {
+    ForkSnapshot *base = gb->fork_base;
+    u8           *host = gb->read_map[addr >> MMU_PAGE_SHIFT];
+    int           page = host ? base_page_index(base, host) : -1;
+
+    if (page < 0)
+        return false;
+
+    u8 *own = own_page(gb, (unsigned)page);
+    memcpy(own, host, MMU_PAGE_SIZE);
+    gb->fork_shared[page / 64] &= ~(1ULL << (page % 64));
+
+    // Every alias of the page (WRAM echo). Decoded blocks keyed by the snapshot page are never
+    // looked up again, and the snapshot outlives them (fork_detach flushes them)
+    for (int at = 0; at < 0x100; at++) {
+        if (gb->read_map[at] == host) {
+            gb->read_map[at]  = own;
+            gb->write_map[at] = own;
+        }
+    }
+
+    // Snapshot pages aren't trapped, so a block running from this one (code writing into its own
+    // page) only learns of the copy here, and stops after the current instruction
+    gb->map_gen++;
+    return true;
+}
+
+void fork_detach(GameBoy *gb, bool keep) {
+    ForkSnapshot *base = gb->fork_base;
+
+    if (!base)
+        return;
+
+    if (keep) {
+        for (unsigned page = 0; page < tracked_pages(base); page++) {
+            if (page_shared(gb, page))
+                memcpy(own_page(gb, page), base_page(base, page), MMU_PAGE_SIZE);
+        }
+    }
+
+    memset(gb->fork_shared, 0, sizeof(gb->fork_shared));
+    gb->fork_base = NULL;
+    snapshot_release(base);
+
+    mmu_map_update(gb);
+}
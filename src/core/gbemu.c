@@ -4,30 +4,56 @@
 #include <string.h>
 #include <stdio.h>
 
+static void save_sync_event(GameBoy *gb, u64 when) {
+    cart_sync_save(&gb->cart, false);
+    sched_schedule(&gb->sched, SCHED_SAVE, when + gb->save_sync_cycles);
+}
+
 // Initialize the GameBoy instance
 void gb_init(GameBoy *gb) {
     memset(gb, 0, sizeof(GameBoy));
+    sched_init(&gb->sched);
+    sched_set_handler(&gb->sched, SCHED_SAVE, save_sync_event);
     cpu_init(&gb->cpu, gb);
+    timer_init(gb);
+    ppu_init(gb);
+    mbc_init(gb);
+    mmu_map_update(gb);
 }
 
 // Load a cartridge into GameBoy
 void gb_load_rom(GameBoy *gb, const char *path) {
     // Try to load the cartridge
     // TODO: Might print details about the error (using error codes)
-    if (cart_load(&gb->cart, path) != 0) {
+    if (cart_load_shared(&gb->cart, path) != 0) {
         /* fprintf(stderr, "Failed to load ROM\n"); */
         gb->running = false;
         return;
     }
 
-    printf("\n");
+    printf("\nCartridge header checksum: OK\n\n");
     cart_print_header(&gb->cart.header);
     printf("\n");
 
+    mbc_init(gb);
+    mmu_map_update(gb);
     cpu_reset(&gb->cpu);
     gb->running = true;
 }
 
+int gb_attach_save(GameBoy *gb, const char *path, u32 sync_frames) {
+    if (cart_map_save(&gb->cart, path) != 0)
+        return -1;
+
+    // cart.ram moved
+    mmu_map_update(gb);
+
+    gb->save_sync_cycles = (u64)sync_frames * GB_FRAME_CYCLES;
+    if (gb->save_sync_cycles)
+        sched_schedule(&gb->sched, SCHED_SAVE, gb->cycles + gb->save_sync_cycles);
+    return 0;
+}
+
 // Exeucte a single CPU instruction step
 void gb_step(GameBoy *gb) {
     if (!gb->running)
@@ -35,20 +61,121 @@ void gb_step(GameBoy *gb) {
 
     u8 cycles = cpu_step(&gb->cpu);
     gb->cycles += cycles;
+    sched_run_due(gb);
 }
 
-// Run the emulator for the duration of one video frame
+// Run the emulator up to the end of the current video frame
 void gb_run_frame(GameBoy *gb) {
-    if (!gb->running)
-        return;
-
     // GameBoy runs at ~4.19 MHz
     // 1 frame @ 60 Hz = 70224 cycles
-    u32 frame_cycles = 0;
+    GbFrame frame = {0, false};
+    gb_frame_run(gb, &frame, UINT64_MAX, NULL);
+}
+
+// ---------------------------------------------
+// Batched Execution
+// ---------------------------------------------
+
+static bool at_breakpoint(const GameBoy *gb) {
+    for (u8 i = 0; i < gb->breakpoint_count; i++) {
+        if (gb->breakpoints[i] == gb->cpu.pc)
+            return true;
+    }
+    return false;
+}
+
+static u64 frame_end(u64 cycles) {
+    return (cycles / GB_FRAME_CYCLES + 1) * GB_FRAME_CYCLES;
+}
+
+// The slices of a gb_run_cycles call ending at end, paused before the first one to start at or
+// past until. Returns false when paused, else true with the reason the call stopped
+static bool run_call(GameBoy *gb, u64 end, u64 until, DecodeCache *rom_cache,
+                     GbStopReason *reason) {
+    while (gb->cycles < end) {
+        if (gb->cycles >= until)
+            return false;
+
+        bool was_halted = gb->cpu.halted;
+
+        // With breakpoints set, run one instruction at a time so every PC is seen
+        u32  slice      = gb->breakpoint_count ? 1 : (u32)(end - gb->cycles);
+
+        // Returns early at the next scheduled event, which is then caught up on
+        if (rom_cache)
+            cpu_run_blocks(&gb->cpu, slice, rom_cache);
+        else
+            cpu_run(&gb->cpu, slice);
+        sched_run_due(gb);
 
-    while (frame_cycles < 70224) {
-        u8 cycles = cpu_step(&gb->cpu);
-        frame_cycles += cycles;
-        gb->cycles += cycles;
+        if (gb->cpu.halted && !was_halted) {
+            *reason = GB_STOP_HALT;
+            return true;
+        }
+        if (gb->breakpoint_count && at_breakpoint(gb)) {
+            *reason = GB_STOP_BREAKPOINT;
+            return true;
+        }
     }
+
+    *reason = GB_STOP_BUDGET;
+    return true;
+}
+
+GbRunResult gb_run_cycles(GameBoy *gb, u32 budget) {
+    GbRunResult result = {GB_STOP_BUDGET, 0, 0};
+
+    if (!gb->running)
+        return result;
+
+    u64 start      = gb->cycles;
+    u64 budget_end = start + budget;
+    u64 frame      = frame_end(gb->cycles);
+    u64 end        = (frame <= budget_end) ? frame : budget_end;
+
+    run_call(gb, end, UINT64_MAX, NULL, &result.reason);
+    if (result.reason == GB_STOP_BUDGET && end == frame)
+        result.reason = GB_STOP_FRAME;
+
+    result.cycles    = (u32)(gb->cycles - start);
+    result.overshoot = (gb->cycles > end) ? (u32)(gb->cycles - end) : 0;
+    return result;
+}
+
+bool gb_frame_run(GameBoy *gb, GbFrame *frame, u64 until, DecodeCache *rom_cache) {
+    // The end is fixed when the frame starts: a HALT or breakpoint stop landing on it ends the
+    // frame too, instead of the next call picking the following boundary
+    if (!frame->end)
+        frame->end = frame_end(gb->cycles);
+
+    // HALT and breakpoints only stop gb_run_cycles, keep calling it until the frame is over
+    while (!frame->done) {
+        if (!gb->running || gb->cycles >= frame->end) {
+            frame->done = true;
+            break;
+        }
+
+        GbStopReason reason;
+        if (!run_call(gb, frame->end, until, rom_cache, &reason))
+            return true;
+    }
+    return false;
+}
+
+// Returns false when all breakpoint slots are in use
+bool gb_add_breakpoint(GameBoy *gb, u16 addr) {
+    if (gb->breakpoint_count >= GB_MAX_BREAKPOINTS)
+        return false;
+
+    gb->breakpoints[gb->breakpoint_count++] = addr;
+    return true;
+}
+
+void gb_clear_breakpoints(GameBoy *gb) {
+    gb->breakpoint_count = 0;
+}
+
+void gb_request_interrupt(GameBoy *gb, u8 mask) {
+    gb->if_register |= mask & 0x1F;
+    cpu_update_interrupts(&gb->cpu);
 }
@@ -0,0 +1,54 @@
+// src/core/lockstep.c
+#include <core/lockstep.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ---------------------------------------------
+// Init / Free
+// ---------------------------------------------
+bool lockstep_init(Lockstep *ls, GameBoy **lanes, u32 count) {
+    memset(ls, 0, sizeof(Lockstep));
+    ls->lanes  = lanes;
+    ls->count  = count;
+    ls->frames = calloc(count, sizeof(GbFrame));
+
+    if (!ls->frames) {
+        lockstep_free(ls);
+        return false;
+    }
+    return true;
+}
+
+void lockstep_free(Lockstep *ls) {
+    free(ls->frames);
+    memset(ls, 0, sizeof(Lockstep));
+}
+
+// ---------------------------------------------
+// Rounds
+// ---------------------------------------------
+
+// Every lane that isn't done runs whole slices until it reaches cycle until
+// Returns the number of lanes whose frame isn't complete yet
+static u32 run_round(Lockstep *ls, u64 until) {
+    u32 active = 0;
+
+    for (u32 lane = 0; lane < ls->count; lane++)
+        active += gb_frame_run(ls->lanes[lane], &ls->frames[lane], until, &ls->decode);
+    return active;
+}
+
+void lockstep_run_frame(Lockstep *ls) {
+    u64 until = 0;
+
+    // Rounds count from the lane furthest ahead, lanes behind it catch up in the first
+    memset(ls->frames, 0, ls->count * sizeof(GbFrame));
+    for (u32 lane = 0; lane < ls->count; lane++) {
+        if (ls->lanes[lane]->cycles > until)
+            until = ls->lanes[lane]->cycles;
+    }
+
+    do
+        until += LOCKSTEP_ROUND_CYCLES;
+    while (run_round(ls, until));
+}
@@ -0,0 +1,231 @@
+// src/core/mbc.c
+#include <core/mbc.h>
+#include <core/bus.h>
+#include <gbemu.h>
+#include <stdio.h>
+#include <string.h>
+
+// ---------------------------------------------
+// Helpers
+// ---------------------------------------------
+
+// Controller from the cartridge type byte (0x0147), see get_cart_type_name
+static MbcType mbc_type_from_header(u8 cart_type) {
+    switch (cart_type) {
+        case 0x01: // MBC1
+        case 0x02: // MBC1+RAM
+        case 0x03: // MBC1+RAM+BATTERY
+            return MBC_1;
+        case 0x0F: // MBC3+TIMER+BATTERY
+        case 0x10: // MBC3+TIMER+RAM+BATTERY
+        case 0x11: // MBC3
+        case 0x12: // MBC3+RAM
+        case 0x13: // MBC3+RAM+BATTERY
+            return MBC_3;
+        case 0x19: // MBC5
+        case 0x1A: // MBC5+RAM
+        case 0x1B: // MBC5+RAM+BATTERY
+        case 0x1C: // MBC5+RUMBLE
+        case 0x1D: // MBC5+RUMBLE+RAM
+        case 0x1E: // MBC5+RUMBLE+RAM+BATTERY
+            return MBC_5;
+        default:
+            return MBC_NONE;
+    }
+}
+
+// Bank numbers wrap around the banks actually present, like the unconnected address lines do
+// Images shorter than a bank (or not loaded yet) keep the number as written
+static u16 wrap_rom_bank(const Cartridge *cart, u16 bank) {
+    size_t banks = cart->rom_size / MBC_ROM_BANK_SIZE;
+    return banks ? (u16)(bank % banks) : bank;
+}
+
+static u8 ram_bank_count(const Cartridge *cart) {
+    size_t banks = cart->ram_size / MBC_RAM_BANK_SIZE;
+    return banks ? (u8)banks : 1; // 2 KB carts have a single partial bank
+}
+
+static u8 *rom_bank_ptr(const Cartridge *cart, u16 bank) {
+    size_t offset = (size_t)bank * MBC_ROM_BANK_SIZE;
+    return (cart->rom && offset < cart->rom_size) ? cart->rom + offset : NULL;
+}
+
+// ---------------------------------------------
+// Bank selection
+// ---------------------------------------------
+void mbc_init(GameBoy *gb) {
+    Mbc *mbc = &gb->cart.mbc;
+    u8   type = gb->cart.header.cart_type;
+
+    memset(mbc, 0, sizeof(*mbc));
+    mbc->type = mbc_type_from_header(type);
+
+    // ROM only and ROM+RAM carts have no controller
+    if (mbc->type == MBC_NONE && type != 0x00 && type != 0x08 && type != 0x09)
+        fprintf(stderr, "Unsupported cartridge type 0x%02X (%s), banking disabled\n", type,
+                get_cart_type_name(type));
+
+    // Without an enable register RAM is always accessible
+    mbc->ram_enabled = mbc->type == MBC_NONE;
+    mbc->bank_lo     = 1;
+    mbc_update_banks(gb);
+}
+
+void mbc_update_banks(GameBoy *gb) {
+    Cartridge *cart = &gb->cart;
+    Mbc       *mbc  = &cart->mbc;
+
+    u16        rom_bank0 = 0;
+    u16        rom_bank  = mbc->bank_lo;
+    u8         ram_bank  = 0;
+    bool       rtc       = false;
+
+    switch (mbc->type) {
+        case MBC_1:
+            // 0x4000 - 0x5FFF supplies ROM bits 5-6, and in mode 1 also banks 0x0000 and RAM
+            rom_bank |= (mbc->bank_hi & 0x03) << 5;
+            if (mbc->mode) {
+                rom_bank0 = (mbc->bank_hi & 0x03) << 5;
+                ram_bank  = mbc->bank_hi & 0x03;
+            }
+            break;
+        case MBC_3:
+            rtc      = mbc->bank_hi >= 0x08 && mbc->bank_hi <= 0x0C;
+            ram_bank = mbc->bank_hi & 0x03;
+            break;
+        case MBC_5:
+            ram_bank = mbc->bank_hi & 0x0F;
+            break;
+        default:
+            break;
+    }
+
+    mbc->rom_bank0     = wrap_rom_bank(cart, rom_bank0);
+    mbc->rom_bank      = wrap_rom_bank(cart, rom_bank);
+    mbc->ram_bank      = ram_bank % ram_bank_count(cart);
+    mbc->rtc_mapped    = rtc;
+
+    mbc->rom_bank0_ptr = rom_bank_ptr(cart, mbc->rom_bank0);
+    mbc->rom_bank_ptr  = rom_bank_ptr(cart, mbc->rom_bank);
+    mbc->ram_bank_ptr  = (cart->ram && mbc->ram_enabled && !rtc)
+                             ? cart->ram + (size_t)mbc->ram_bank * MBC_RAM_BANK_SIZE
+                             : NULL;
+}
+
+// Refresh the page table after a register write, only touching what moved
+// ROM pages never hold decode cache traps, so a ROM bank switch just rewrites their read entries.
+// Cached blocks are keyed by host address and so stay valid for their own bank, but one running
+// from the switched region must not go on with the old bank's handlers: mmu_map_rom bumps
+// map_gen, which ends it after the write. RAM enable and RAM bank changes are rare and rebuild the
+// whole table
+static void mbc_remap(GameBoy *gb) {
+    Mbc *mbc       = &gb->cart.mbc;
+    u8  *rom_bank0 = mbc->rom_bank0_ptr;
+    u8  *rom_bank  = mbc->rom_bank_ptr;
+    u8  *ram_bank  = mbc->ram_bank_ptr;
+    bool rtc       = mbc->rtc_mapped;
+
+    mbc_update_banks(gb);
+
+    if (mbc->ram_bank_ptr != ram_bank || mbc->rtc_mapped != rtc)
+        mmu_map_update(gb);
+    else if (mbc->rom_bank0_ptr != rom_bank0 || mbc->rom_bank_ptr != rom_bank)
+        mmu_map_rom(gb);
+}
+
+// ---------------------------------------------
+// Register writes
+// ---------------------------------------------
+void mbc_write(GameBoy *gb, u16 addr, u8 value) {
+    Mbc *mbc = &gb->cart.mbc;
+
+    // ROM only: nothing to write to
+    if (mbc->type == MBC_NONE)
+        return;
+
+    switch (addr >> 13) {
+        case 0: // 0x0000 - 0x1FFF: RAM (and RTC) enable
+            mbc->ram_enabled = (value & 0x0F) == 0x0A;
+            break;
+
+        case 1: // 0x2000 - 0x3FFF: ROM bank
+            if (mbc->type == MBC_1) {
+                // 5 bits, 0 selects 1 (so banks 0x20/0x40/0x60 can't be reached)
+                mbc->bank_lo = (value & 0x1F) ? (value & 0x1F) : 1;
+            } else if (mbc->type == MBC_3) {
+                mbc->bank_lo = (value & 0x7F) ? (value & 0x7F) : 1;
+            } else if (mbc->type == MBC_5) {
+                // 0x2000 - 0x2FFF low 8 bits, 0x3000 - 0x3FFF bit 8, bank 0 is selectable
+                if (addr < 0x3000)
+                    mbc->bank_lo = (mbc->bank_lo & 0x100) | value;
+                else
+                    mbc->bank_lo = (mbc->bank_lo & 0xFF) | ((value & 0x01) << 8);
+            }
+            break;
+
+        case 2: // 0x4000 - 0x5FFF: RAM bank, MBC1 upper ROM bits, MBC3 RTC register select
+            mbc->bank_hi = value;
+            break;
+
+        default: // 0x6000 - 0x7FFF: MBC1 banking mode, MBC3 clock latch
+            if (mbc->type == MBC_1) {
+                mbc->mode = value & 0x01;
+            } else if (mbc->type == MBC_3) {
+                // Writing 0 then 1 copies the clock into the readable registers
+                if (mbc->mode == 0x00 && value == 0x01)
+                    memcpy(mbc->rtc_latched, mbc->rtc, sizeof(mbc->rtc));
+                mbc->mode = value;
+            }
+            break;
+    }
+
+    mbc_remap(gb);
+}
+
+// ---------------------------------------------
+// Slow path accesses
+// ---------------------------------------------
+u8 mbc_rom_read(GameBoy *gb, u16 addr) {
+    const Cartridge *cart = &gb->cart;
+    u16              bank = addr < MBC_ROM_BANK_SIZE ? cart->mbc.rom_bank0 : cart->mbc.rom_bank;
+    size_t offset = (size_t)bank * MBC_ROM_BANK_SIZE + (addr & (MBC_ROM_BANK_SIZE - 1));
+
+    if (cart->rom && offset < cart->rom_size)
+        return cart->rom[offset];
+    return 0xFF; // Open bus
+}
+
+u8 mbc_ram_read(GameBoy *gb, u16 addr) {
+    const Cartridge *cart = &gb->cart;
+    const Mbc       *mbc  = &cart->mbc;
+
+    if (!mbc->ram_enabled)
+        return 0xFF;
+    if (mbc->rtc_mapped)
+        return mbc->rtc_latched[mbc->bank_hi - 0x08];
+
+    size_t offset = (size_t)mbc->ram_bank * MBC_RAM_BANK_SIZE + (addr - 0xA000);
+    if (cart->ram && offset < cart->ram_size)
+        return cart->ram[offset];
+    return 0xFF;
+}
+
+void mbc_ram_write(GameBoy *gb, u16 addr, u8 value) {
+    Cartridge *cart = &gb->cart;
+    Mbc       *mbc  = &cart->mbc;
+
+    if (!mbc->ram_enabled)
+        return;
+
+    if (mbc->rtc_mapped) {
+        // Written registers read back without waiting for the next latch
+        mbc->rtc[mbc->bank_hi - 0x08]         = value;
+        mbc->rtc_latched[mbc->bank_hi - 0x08] = value;
+        return;
+    }
+
+    size_t offset = (size_t)mbc->ram_bank * MBC_RAM_BANK_SIZE + (addr - 0xA000);
+    if (cart->ram && offset < cart->ram_size)
+        cart->ram[offset] = value;
+}
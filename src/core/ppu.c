@@ -0,0 +1,412 @@
+// src/core/ppu.c
+#include <core/ppu.h>
+#include <core/bus.h>
+#include <core/tile_decode.h>
+#include <gbemu.h>
+#include <string.h>
+
+/*
+LCD registers:
+https://gbdev.io/pandocs/LCDC.html
+https://gbdev.io/pandocs/STAT.html
+
+0xFF40 : LCDC - LCD control
+0xFF41 : STAT - Interrupt sources (bits 3-6), LY=LYC flag (bit 2), mode (bits 0-1)
+0xFF42 : SCY  - Background scroll Y
+0xFF43 : SCX  - Background scroll X
+0xFF44 : LY   - Current line (read only)
+0xFF45 : LYC  - Line compared against LY
+0xFF46 : DMA  - OAM DMA source page
+0xFF47 : BGP  - Background palette
+0xFF48 : OBP0 - Sprite palette 0
+0xFF49 : OBP1 - Sprite palette 1
+0xFF4A : WY   - Window Y
+0xFF4B : WX   - Window X + 7
+
+Line timing (456 T-cycles per line, 154 lines per frame):
+  Lines 0-143   : Mode 2 (80) -> Mode 3 (172) -> Mode 0 (204)
+  Lines 144-153 : Mode 1 (456 each)
+*/
+
+#define DRAW_START_DELAY 12 // T-cycles into mode 3 before the first pixel is output
+
+// ---------------------------------------------
+// Tile data
+// ---------------------------------------------
+static u8 palette_shade(u8 palette, u8 color) {
+    return (palette >> (color * 2)) & 0x03;
+}
+
+// Decoded pixels of a tile, re-decoding it first if VRAM changed since the last use
+// Tiles are usually loaded in runs, so the dirty tiles following it are decoded in the same batch
+static const u8 *ppu_tile(GameBoy *gb, u16 tile) {
+    if (gb->tile_dirty[tile]) {
+        u16 end = tile + 1;
+        while (end < PPU_TILES && gb->tile_dirty[end])
+            end++;
+
+        tile_decode_rows(&gb->vram[tile * 16], (size_t)(end - tile) * 8, TILE_PALETTE_IDENTITY,
+                         gb->tile_cache[tile]);
+        memset(&gb->tile_dirty[tile], false, end - tile);
+    }
+    return gb->tile_cache[tile];
+}
+
+// Tile number of a background/window map entry
+static u16 bg_tile(const GameBoy *gb, u8 index) {
+    // 0x8000 addressing is unsigned, 0x8800 addressing is signed around 0x9000 (tile 256)
+    if (gb->ppu.lcdc & LCDC_TILE_DATA)
+        return index;
+    return (u16)(256 + (i8)index);
+}
+
+// Pixels [x, x + len) of row y of a 32x32 map (map space, wrapping at 256), through lut
+static void fetch_map_span(GameBoy *gb, u16 map, u8 x, u8 y, int len, const u8 lut[4], u8 *out) {
+    const u8 *map_row = &gb->vram[map + (y >> 3) * 32];
+
+    for (int i = 0; i < len;) {
+        u8        map_x = (u8)(x + i);
+        const u8 *row   = ppu_tile(gb, bg_tile(gb, map_row[map_x >> 3])) + (y & 7) * 8;
+        int       fine  = map_x & 7;
+        int       count = 8 - fine < len - i ? 8 - fine : len - i;
+
+        for (int k = 0; k < count; k++)
+            out[i + k] = lut[row[fine + k]];
+        i += count;
+    }
+}
+
+// ---------------------------------------------
+// Sprites
+// ---------------------------------------------
+
+// OAM scan for the current line: fill obj_line with the pixels of up to 10 sprites
+static void ppu_prepare_sprites(GameBoy *gb) {
+    PPU *p       = &gb->ppu;
+    p->obj_count = 0;
+
+    memset(p->obj_line, 0, sizeof(p->obj_line));
+    if (!(p->lcdc & LCDC_OBJ_ENABLE))
+        return;
+
+    int height = (p->lcdc & LCDC_OBJ_SIZE) ? 16 : 8;
+    u8  selected[PPU_MAX_SPRITES];
+    int count = 0;
+
+    // First 10 sprites in OAM order overlapping the line
+    for (int i = 0; i < 40 && count < PPU_MAX_SPRITES; i++) {
+        int row = p->ly - (gb->oam[i * 4] - 16);
+        if (row >= 0 && row < height)
+            selected[count++] = (u8)i;
+    }
+    if (!count)
+        return;
+
+    // DMG priority: lower X first, then lower OAM index (insertion sort keeps OAM order on ties)
+    for (int i = 1; i < count; i++) {
+        u8  cur = selected[i];
+        int j   = i - 1;
+        while (j >= 0 && gb->oam[selected[j] * 4 + 1] > gb->oam[cur * 4 + 1]) {
+            selected[j + 1] = selected[j];
+            j--;
+        }
+        selected[j + 1] = cur;
+    }
+
+    // Lowest priority first, so the winning sprite's opaque pixels are written last
+    for (int i = count - 1; i >= 0; i--) {
+        const u8 *obj  = &gb->oam[selected[i] * 4];
+        u8        attr = obj[3];
+        int       row  = p->ly - (obj[0] - 16);
+        u8        tile = (height == 16) ? (obj[2] & 0xFE) : obj[2];
+
+        if (attr & 0x40) // Y flip
+            row = height - 1 - row;
+
+        // Rows 8-15 of a tall sprite are the next tile
+        const u8 *pixels = ppu_tile(gb, (u16)(tile + (row >> 3))) + (row & 7) * 8;
+
+        for (int k = 0; k < 8; k++) {
+            int x     = obj[1] - 8 + k;
+            u8  color = pixels[(attr & 0x20) ? 7 - k : k]; // X flip
+            if (x < 0 || x >= PPU_WIDTH || !color)
+                continue;
+            p->obj_line[x] = color | (attr & 0x10) | (attr & 0x80);
+        }
+    }
+    p->obj_count = (u8)count;
+}
+
+// ---------------------------------------------
+// Line rendering
+// ---------------------------------------------
+
+// Render pixels [x0, x1) of line LY with the current register values
+static void ppu_render_span(GameBoy *gb, int x0, int x1) {
+    PPU *p       = &gb->ppu;
+    u8  *out     = p->framebuffer[p->ly];
+    u16  bg_map  = (p->lcdc & LCDC_BG_MAP) ? 0x1C00 : 0x1800;
+    u16  win_map = (p->lcdc & LCDC_WIN_MAP) ? 0x1C00 : 0x1800;
+    int  win_x   = p->wx - 7;
+    bool bg_on   = (p->lcdc & LCDC_BG_ENABLE) != 0;
+    bool win_on  = bg_on && (p->lcdc & LCDC_WIN_ENABLE) && p->window_y_hit && p->wx <= 166;
+
+    // Without sprites BGP is applied while copying into the frame buffer, otherwise the raw colors
+    // are kept for the sprite priority test
+    static const u8 identity[4] = {0, 1, 2, 3};
+    u8              shades[4]   = {palette_shade(p->bgp, 0), palette_shade(p->bgp, 1),
+                                   palette_shade(p->bgp, 2), palette_shade(p->bgp, 3)};
+    u8              colors[PPU_WIDTH];
+    u8             *bg  = p->obj_count ? colors : out;
+    const u8       *lut = p->obj_count ? identity : shades;
+
+    // Window from win_start to the end of the span, background before it
+    int  win_start = x1;
+    if (win_on)
+        win_start = win_x > x0 ? (win_x < x1 ? win_x : x1) : x0;
+
+    if (!bg_on)
+        memset(bg + x0, lut[0], (size_t)(x1 - x0));
+    else if (win_start > x0)
+        fetch_map_span(gb, bg_map, (u8)(x0 + p->scx), (u8)(p->ly + p->scy), win_start - x0, lut,
+                       bg + x0);
+
+    if (win_start < x1) {
+        fetch_map_span(gb, win_map, (u8)(win_start - win_x), p->window_line, x1 - win_start, lut,
+                       bg + win_start);
+        p->window_drawn = true;
+    }
+
+    if (!p->obj_count)
+        return;
+
+    for (int x = x0; x < x1; x++) {
+        u8 obj   = p->obj_line[x];
+        u8 color = colors[x];
+
+        if ((obj & 0x03) && !((obj & 0x80) && color))
+            out[x] = palette_shade((obj & 0x10) ? p->obp1 : p->obp0, obj & 0x03);
+        else
+            out[x] = palette_shade(p->bgp, color);
+    }
+}
+
+// Dot renderer: output the pixels the LCD has reached by now
+static void ppu_catch_up(GameBoy *gb) {
+    PPU *p = &gb->ppu;
+
+    if (p->render_mode != PPU_RENDER_DOT || p->mode != PPU_MODE_DRAW)
+        return;
+
+    u64 elapsed = gb->cycles - p->mode_start;
+    int x       = elapsed > DRAW_START_DELAY ? (int)(elapsed - DRAW_START_DELAY) : 0;
+    if (x > PPU_WIDTH)
+        x = PPU_WIDTH;
+
+    if (x > p->line_x) {
+        ppu_render_span(gb, p->line_x, x);
+        p->line_x = (u8)x;
+    }
+}
+
+// ---------------------------------------------
+// Mode state machine
+// ---------------------------------------------
+
+// Raise the STAT interrupt on a rising edge of the combined source line
+static void ppu_update_stat(GameBoy *gb) {
+    PPU *p    = &gb->ppu;
+    bool line = false;
+
+    if (p->lcdc & LCDC_LCD_ENABLE) {
+        line = ((p->stat & STAT_LYC_INT) && p->ly == p->lyc) ||
+               ((p->stat & STAT_HBLANK_INT) && p->mode == PPU_MODE_HBLANK) ||
+               ((p->stat & STAT_VBLANK_INT) && p->mode == PPU_MODE_VBLANK) ||
+               ((p->stat & STAT_OAM_INT) && p->mode == PPU_MODE_OAM);
+    }
+
+    if (line && !p->stat_line)
+        gb_request_interrupt(gb, INT_STAT);
+    p->stat_line = line;
+}
+
+static void ppu_enter_mode(GameBoy *gb, PpuMode mode, u64 when, u32 length) {
+    gb->ppu.mode       = (u8)mode;
+    gb->ppu.mode_start = when;
+    sched_schedule(&gb->sched, SCHED_PPU, when + length);
+    ppu_update_stat(gb);
+}
+
+// Mode 2 -> 3 -> 0 -> (2 | 1), deadlines chained off the previous one so lateness never drifts
+static void ppu_event(GameBoy *gb, u64 when) {
+    PPU *p = &gb->ppu;
+
+    switch (p->mode) {
+        case PPU_MODE_OAM:
+            if (p->ly == p->wy)
+                p->window_y_hit = true;
+            p->line_x       = 0;
+            p->window_drawn = false;
+            ppu_prepare_sprites(gb);
+            ppu_enter_mode(gb, PPU_MODE_DRAW, when, PPU_DRAW_CYCLES);
+            break;
+
+        case PPU_MODE_DRAW:
+            ppu_render_span(gb, p->line_x, PPU_WIDTH);
+            p->line_x = PPU_WIDTH;
+            if (p->window_drawn)
+                p->window_line++;
+            ppu_enter_mode(gb, PPU_MODE_HBLANK, when, PPU_HBLANK_CYCLES);
+            break;
+
+        case PPU_MODE_HBLANK:
+            p->ly++;
+            if (p->ly == PPU_HEIGHT) {
+                p->frame_count++;
+                gb_request_interrupt(gb, INT_VBLANK);
+                ppu_enter_mode(gb, PPU_MODE_VBLANK, when, PPU_LINE_CYCLES);
+            } else {
+                ppu_enter_mode(gb, PPU_MODE_OAM, when, PPU_OAM_CYCLES);
+            }
+            break;
+
+        case PPU_MODE_VBLANK:
+            if (++p->ly < PPU_LINES) {
+                ppu_enter_mode(gb, PPU_MODE_VBLANK, when, PPU_LINE_CYCLES);
+                break;
+            }
+            p->ly           = 0;
+            p->window_line  = 0;
+            p->window_y_hit = false;
+            ppu_enter_mode(gb, PPU_MODE_OAM, when, PPU_OAM_CYCLES);
+            break;
+    }
+}
+
+// LCD switched on: restart at the top of the frame
+static void ppu_lcd_on(GameBoy *gb) {
+    PPU *p          = &gb->ppu;
+    p->ly           = 0;
+    p->window_line  = 0;
+    p->window_y_hit = false;
+    ppu_enter_mode(gb, PPU_MODE_OAM, gb->cycles, PPU_OAM_CYCLES);
+}
+
+// LCD switched off: LY stays 0 in mode 0 and the screen goes blank
+static void ppu_lcd_off(GameBoy *gb) {
+    PPU *p  = &gb->ppu;
+    p->ly   = 0;
+    p->mode = PPU_MODE_HBLANK;
+    sched_cancel(&gb->sched, SCHED_PPU);
+    memset(p->framebuffer, 0, sizeof(p->framebuffer));
+    ppu_update_stat(gb);
+}
+
+// ---------------------------------------------
+// PPU Functions
+// ---------------------------------------------
+void ppu_invalidate_tiles(GameBoy *gb) {
+    memset(gb->tile_dirty, true, sizeof(gb->tile_dirty));
+}
+
+void ppu_init(GameBoy *gb) {
+    PPU *p = &gb->ppu;
+
+    memset(p, 0, sizeof(PPU));
+    p->lcdc        = 0x91;
+    p->bgp         = 0xFC;
+    p->render_mode = PPU_RENDER_SCANLINE;
+    ppu_invalidate_tiles(gb);
+
+    sched_set_handler(&gb->sched, SCHED_PPU, ppu_event);
+    ppu_lcd_on(gb);
+}
+
+u8 ppu_read(GameBoy *gb, u16 addr) {
+    const PPU *p = &gb->ppu;
+
+    switch (addr) {
+        case 0xFF40:
+            return p->lcdc;
+        case 0xFF41: {
+            u8 mode = (p->lcdc & LCDC_LCD_ENABLE) ? p->mode : 0;
+            return 0x80 | (p->stat & 0x78) | (p->ly == p->lyc ? 0x04 : 0) | mode;
+        }
+        case 0xFF42:
+            return p->scy;
+        case 0xFF43:
+            return p->scx;
+        case 0xFF44:
+            return p->ly;
+        case 0xFF45:
+            return p->lyc;
+        case 0xFF47:
+            return p->bgp;
+        case 0xFF48:
+            return p->obp0;
+        case 0xFF49:
+            return p->obp1;
+        case 0xFF4A:
+            return p->wy;
+        case 0xFF4B:
+            return p->wx;
+        default: // DMA is write only
+            return 0xFF;
+    }
+}
+
+void ppu_write(GameBoy *gb, u16 addr, u8 value) {
+    PPU *p = &gb->ppu;
+
+    // Pixels already output keep the old value
+    ppu_catch_up(gb);
+
+    switch (addr) {
+        case 0xFF40: {
+            u8 old  = p->lcdc;
+            p->lcdc = value;
+            if ((old ^ value) & LCDC_LCD_ENABLE) {
+                if (value & LCDC_LCD_ENABLE)
+                    ppu_lcd_on(gb);
+                else
+                    ppu_lcd_off(gb);
+            }
+            break;
+        }
+        case 0xFF41:
+            p->stat = value & 0x78;
+            ppu_update_stat(gb);
+            break;
+        case 0xFF42:
+            p->scy = value;
+            break;
+        case 0xFF43:
+            p->scx = value;
+            break;
+        case 0xFF45:
+            p->lyc = value;
+            ppu_update_stat(gb);
+            break;
+        case 0xFF46: // OAM DMA, copied at once
+            for (u16 i = 0; i < sizeof(gb->oam); i++)
+                gb->oam[i] = mmu_read(gb, (u16)((value << 8) | i));
+            break;
+        case 0xFF47:
+            p->bgp = value;
+            break;
+        case 0xFF48:
+            p->obp0 = value;
+            break;
+        case 0xFF49:
+            p->obp1 = value;
+            break;
+        case 0xFF4A:
+            p->wy = value;
+            break;
+        case 0xFF4B:
+            p->wx = value;
+            break;
+        default: // LY is read only
+            break;
+    }
+}
@@ -0,0 +1,275 @@
+// src/core/rewind.c
+#include <core/rewind.h>
+#include <core/savestate.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Packed entries are records of (zero words, literal words, literals), both counts as LEB128.
+// A record ends at a zero word, so there are at most words / 2 + 1 of them
+#define REWIND_PACK_BOUND(words) ((words) * 8 + ((words) / 2 + 1) * 10)
+
+// ---------------------------------------------
+// Word run-length coding
+// ---------------------------------------------
+static inline u64 load_word(const u8 *src, const u8 *ref, size_t i) {
+    u64 w, r;
+    memcpy(&w, src + i * 8, 8);
+    if (!ref)
+        return w;
+    memcpy(&r, ref + i * 8, 8);
+    return w ^ r;
+}
+
+static inline u8 *put_varint(u8 *out, size_t v) {
+    while (v >= 0x80) {
+        *out++ = (u8)(v | 0x80);
+        v >>= 7;
+    }
+    *out++ = (u8)v;
+    return out;
+}
+
+static inline size_t get_varint(const u8 **in) {
+    size_t v     = 0;
+    int    shift = 0;
+    u8     byte;
+    do {
+        byte = *(*in)++;
+        v |= (size_t)(byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return v;
+}
+
+// Code src ^ ref (src alone when ref is NULL), returns the packed size
+static size_t rewind_pack(const u8 *src, const u8 *ref, size_t words, u8 *out) {
+    u8    *p = out;
+    size_t i = 0;
+
+    while (i < words) {
+        size_t zeros = i;
+        while (i < words && load_word(src, ref, i) == 0)
+            i++;
+        zeros = i - zeros;
+
+        size_t start = i;
+        while (i < words && load_word(src, ref, i) != 0)
+            i++;
+
+        p = put_varint(p, zeros);
+        p = put_varint(p, i - start);
+        for (size_t j = start; j < i; j++) {
+            u64 w = load_word(src, ref, j);
+            memcpy(p, &w, 8);
+            p += 8;
+        }
+    }
+
+    return (size_t)(p - out);
+}
+
+// Decode into out, XORing the literals into it (delta) or overwriting it (keyframe)
+static void rewind_unpack(const u8 *in, size_t size, u8 *out, size_t words, bool delta) {
+    const u8 *end = in + size;
+    size_t    i   = 0;
+
+    while (in < end && i < words) {
+        size_t zeros = get_varint(&in);
+        size_t lits  = get_varint(&in);
+
+        if (!delta)
+            memset(out + i * 8, 0, zeros * 8);
+        i += zeros;
+
+        if (!delta) {
+            memcpy(out + i * 8, in, lits * 8);
+        } else {
+            for (size_t j = 0; j < lits; j++) {
+                u64 w = load_word(in, out + i * 8, j);
+                memcpy(out + (i + j) * 8, &w, 8);
+            }
+        }
+        in += lits * 8;
+        i += lits;
+    }
+}
+
+// ---------------------------------------------
+// Ring
+// ---------------------------------------------
+static inline RewindEntry *entry_at(const Rewind *rw, u32 n) {
+    return &rw->entries[(rw->first + n) % rw->capacity];
+}
+
+// The oldest entry is always a keyframe, its deltas are useless without it
+static void drop_oldest_group(Rewind *rw) {
+    do {
+        rw->first = (rw->first + 1) % rw->capacity;
+        rw->count--;
+    } while (rw->count && !entry_at(rw, 0)->keyframe);
+
+    if (!rw->count)
+        rw->head = 0;
+}
+
+// Arena offset where size bytes fit after the newest entry, wrapping to the start when the end
+// is too short, or -1 if they would overlap the oldest entry
+static int64_t arena_slot(const Rewind *rw, size_t size) {
+    if (!rw->count)
+        return size <= rw->arena_size ? 0 : -1;
+
+    size_t oldest = entry_at(rw, 0)->offset;
+    if (rw->head > oldest) {
+        if (rw->arena_size - rw->head >= size)
+            return (int64_t)rw->head;
+        return oldest >= size ? 0 : -1;
+    }
+    return (rw->head < oldest && oldest - rw->head >= size) ? (int64_t)rw->head : -1;
+}
+
+static void unpack_entry(const Rewind *rw, const RewindEntry *e, u8 *out) {
+    rewind_unpack(rw->arena + e->offset, e->size, out, rw->state_size / 8, !e->keyframe);
+}
+
+// ---------------------------------------------
+// Setup
+// ---------------------------------------------
+bool rewind_init(Rewind *rw, GameBoy *gb, size_t arena_size, u32 max_states,
+                 u32 keyframe_interval) {
+    memset(rw, 0, sizeof(*rw));
+
+    // Entry offsets and sizes are 32-bit
+    if (!max_states || arena_size > UINT32_MAX)
+        return false;
+
+    rw->state_size        = gb_state_size(gb);
+    rw->arena_size        = arena_size;
+    rw->capacity          = max_states;
+    rw->keyframe_interval = keyframe_interval ? keyframe_interval : REWIND_KEYFRAME_INTERVAL;
+
+    rw->arena             = malloc(arena_size);
+    rw->entries           = calloc(max_states, sizeof(RewindEntry));
+    rw->key               = malloc(rw->state_size);
+    rw->state             = malloc(rw->state_size);
+    rw->packed            = malloc(REWIND_PACK_BOUND(rw->state_size / 8));
+
+    if (!rw->arena || !rw->entries || !rw->key || !rw->state || !rw->packed) {
+        rewind_free(rw);
+        return false;
+    }
+    return true;
+}
+
+void rewind_free(Rewind *rw) {
+    free(rw->arena);
+    free(rw->entries);
+    free(rw->key);
+    free(rw->state);
+    free(rw->packed);
+    memset(rw, 0, sizeof(*rw));
+}
+
+void rewind_clear(Rewind *rw) {
+    rw->first          = 0;
+    rw->count          = 0;
+    rw->head           = 0;
+    rw->since_keyframe = 0;
+}
+
+// ---------------------------------------------
+// Push / Restore
+// ---------------------------------------------
+bool rewind_push(Rewind *rw, GameBoy *gb) {
+    if (!rw->arena || gb_state_size(gb) != rw->state_size)
+        return false;
+    gb_save_state(gb, rw->state, rw->state_size);
+
+    size_t  words    = rw->state_size / 8;
+    bool    keyframe = !rw->count || rw->since_keyframe + 1 >= rw->keyframe_interval;
+    size_t  size     = rewind_pack(rw->state, keyframe ? NULL : rw->key, words, rw->packed);
+    int64_t slot     = 0;
+
+    // Make room, oldest keyframe group first
+    for (;;) {
+        // Dropped the keyframe this delta was against
+        if (!rw->count && !keyframe) {
+            keyframe = true;
+            size     = rewind_pack(rw->state, NULL, words, rw->packed);
+        }
+        if (rw->count < rw->capacity && (slot = arena_slot(rw, size)) >= 0)
+            break;
+        if (!rw->count)
+            return false; // Bigger than the whole arena
+        drop_oldest_group(rw);
+    }
+
+    memcpy(rw->arena + slot, rw->packed, size);
+    *entry_at(rw, rw->count) = (RewindEntry){(u32)slot, (u32)size, keyframe};
+    rw->count++;
+    rw->head = (size_t)slot + size;
+
+    if (keyframe) {
+        memcpy(rw->key, rw->state, rw->state_size);
+        rw->since_keyframe = 0;
+    } else {
+        rw->since_keyframe++;
+    }
+    return true;
+}
+
+bool rewind_load(Rewind *rw, GameBoy *gb, u32 age) {
+    if (age >= rw->count)
+        return false;
+
+    u32 n = rw->count - 1 - age;
+    u32 k = n;
+    while (!entry_at(rw, k)->keyframe)
+        k--;
+
+    unpack_entry(rw, entry_at(rw, k), rw->state);
+    if (k != n)
+        unpack_entry(rw, entry_at(rw, n), rw->state);
+
+    return gb_load_state(gb, rw->state, rw->state_size);
+}
+
+bool rewind_pop(Rewind *rw, GameBoy *gb) {
+    if (!rewind_load(rw, gb, 0))
+        return false;
+
+    bool keyframe = entry_at(rw, rw->count - 1)->keyframe;
+    rw->count--;
+
+    if (!rw->count) {
+        rewind_clear(rw);
+        return true;
+    }
+
+    const RewindEntry *newest = entry_at(rw, rw->count - 1);
+    rw->head                  = (size_t)newest->offset + newest->size;
+
+    if (!keyframe) {
+        rw->since_keyframe--;
+        return true;
+    }
+
+    // New deltas go against the previous keyframe, unpack it again
+    u32 k = rw->count - 1;
+    while (!entry_at(rw, k)->keyframe)
+        k--;
+    unpack_entry(rw, entry_at(rw, k), rw->key);
+    rw->since_keyframe = rw->count - 1 - k;
+    return true;
+}
+
+u32 rewind_count(const Rewind *rw) {
+    return rw->count;
+}
+
+size_t rewind_bytes_used(const Rewind *rw) {
+    size_t used = 0;
+    for (u32 i = 0; i < rw->count; i++)
+        used += entry_at(rw, i)->size;
+    return used;
+}
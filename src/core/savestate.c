@@ -0,0 +1,223 @@
+// src/core/savestate.c
+#include <core/savestate.h>
+#include <core/bus.h>
+#include <core/fork.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// ---------------------------------------------
+// Layout
+// ---------------------------------------------
+#define STATE_ID(a, b, c, d) ((u32)(a) | ((u32)(b) << 8) | ((u32)(c) << 16) | ((u32)(d) << 24))
+#define STATE_MAGIC STATE_ID('B', 'D', 'M', 'G')
+#define STATE_ALIGN 8
+#define STATE_PAD(size) (((size) + STATE_ALIGN - 1) & ~(size_t)(STATE_ALIGN - 1))
+
+typedef struct {
+    u32 magic;
+    u32 version;
+    u32 chunk_count;
+    u32 size; // Whole state, header included
+} StateHeader;
+
+typedef struct {
+    u32 id;
+    u32 size; // Payload bytes, before padding
+} ChunkHeader;
+
+typedef struct {
+    u32    id;
+    void  *data;
+    size_t size;
+} StateChunk;
+
+// Which cartridge the state belongs to: its raw header (title, header and global checksums) and
+// image size. Only compared on load, never restored
+typedef struct {
+    RawRomHeader raw_header;
+    u64          rom_size;
+} StateCart;
+
+enum { STATE_CHUNKS = 10, STATE_CART_CHUNK = 0 };
+
+// Where each chunk lives in this instance, in file order, cart being filled in for this instance
+// Structs ending in pointers (CPU, scheduler, MBC) are saved up to the first pointer
+static void state_chunks(GameBoy *gb, StateCart *cart, StateChunk chunks[STATE_CHUNKS]) {
+    // WRAM, OAM, HRAM, IE and IF are consecutive fields
+    const size_t wram_span = offsetof(GameBoy, if_register) + 1 - offsetof(GameBoy, wram);
+    const size_t sched_len = offsetof(Scheduler, handlers);
+    const size_t mbc_len   = offsetof(Mbc, rom_bank0_ptr);
+
+    memset(cart, 0, sizeof(*cart));
+    cart->raw_header = gb->cart.raw_header;
+    cart->rom_size   = gb->cart.rom_size;
+
+    chunks[0] = (StateChunk){STATE_ID('C', 'A', 'R', 'T'), cart, sizeof(*cart)};
+    chunks[1] = (StateChunk){STATE_ID('C', 'P', 'U', ' '), &gb->cpu, offsetof(CPU, gb)};
+    chunks[2] = (StateChunk){STATE_ID('V', 'R', 'A', 'M'), gb->vram, sizeof(gb->vram)};
+    chunks[3] = (StateChunk){STATE_ID('W', 'R', 'A', 'M'), gb->wram, wram_span};
+    chunks[4] = (StateChunk){STATE_ID('S', 'C', 'H', 'D'), &gb->sched, sched_len};
+    chunks[5] = (StateChunk){STATE_ID('T', 'I', 'M', 'R'), &gb->timer, sizeof(gb->timer)};
+    chunks[6] = (StateChunk){STATE_ID('P', 'P', 'U', ' '), &gb->ppu, sizeof(gb->ppu)};
+    chunks[7] = (StateChunk){STATE_ID('M', 'B', 'C', ' '), &gb->cart.mbc, mbc_len};
+    chunks[8] = (StateChunk){STATE_ID('S', 'R', 'A', 'M'), gb->cart.ram, gb->cart.ram_size};
+    chunks[9] = (StateChunk){STATE_ID('S', 'Y', 'S', ' '), &gb->cycles, sizeof(gb->cycles)};
+}
+
+static size_t state_total(const StateChunk chunks[STATE_CHUNKS]) {
+    size_t total = sizeof(StateHeader);
+    for (int i = 0; i < STATE_CHUNKS; i++)
+        total += sizeof(ChunkHeader) + STATE_PAD(chunks[i].size);
+    return total;
+}
+
+// ---------------------------------------------
+// Save / Load
+// ---------------------------------------------
+size_t gb_state_size(GameBoy *gb) {
+    StateCart  cart;
+    StateChunk chunks[STATE_CHUNKS];
+    state_chunks(gb, &cart, chunks);
+    return state_total(chunks);
+}
+
+size_t gb_save_state(GameBoy *gb, void *buf, size_t size) {
+    StateCart  cart;
+    StateChunk chunks[STATE_CHUNKS];
+    state_chunks(gb, &cart, chunks);
+
+    size_t total = state_total(chunks);
+    if (size < total)
+        return 0;
+
+    // A fork's WRAM and cart RAM must be its own to be saved from
+    fork_detach(gb, true);
+
+    u8         *out    = buf;
+    StateHeader header = {STATE_MAGIC, GB_STATE_VERSION, STATE_CHUNKS, (u32)total};
+    memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+
+    for (int i = 0; i < STATE_CHUNKS; i++) {
+        ChunkHeader chunk = {chunks[i].id, (u32)chunks[i].size};
+        size_t      pad   = STATE_PAD(chunks[i].size) - chunks[i].size;
+
+        memcpy(out, &chunk, sizeof(chunk));
+        out += sizeof(chunk);
+        if (chunks[i].size)
+            memcpy(out, chunks[i].data, chunks[i].size);
+        memset(out + chunks[i].size, 0, pad);
+        out += chunks[i].size + pad;
+    }
+
+    return total;
+}
+
+bool gb_load_state(GameBoy *gb, const void *buf, size_t size) {
+    StateCart  cart;
+    StateChunk chunks[STATE_CHUNKS];
+    state_chunks(gb, &cart, chunks);
+
+    // Validate everything first, a rejected state leaves the machine as it was
+    StateHeader header;
+    if (size < sizeof(header))
+        return false;
+    memcpy(&header, buf, sizeof(header));
+
+    if (header.magic != STATE_MAGIC || header.version != GB_STATE_VERSION ||
+        header.chunk_count != STATE_CHUNKS || header.size != size || size != state_total(chunks))
+        return false;
+
+    const u8 *in = (const u8 *)buf + sizeof(header);
+    for (int i = 0; i < STATE_CHUNKS; i++) {
+        ChunkHeader chunk;
+        memcpy(&chunk, in, sizeof(chunk));
+        if (chunk.id != chunks[i].id || chunk.size != chunks[i].size)
+            return false;
+        if (i == STATE_CART_CHUNK && memcmp(in + sizeof(chunk), &cart, sizeof(cart)) != 0)
+            return false;
+        in += sizeof(chunk) + STATE_PAD(chunk.size);
+    }
+
+    // Everything shared with a fork snapshot is about to be overwritten
+    fork_detach(gb, false);
+
+    in = (const u8 *)buf + sizeof(header);
+    for (int i = 0; i < STATE_CHUNKS; i++) {
+        in += sizeof(ChunkHeader);
+        if (chunks[i].size)
+            memcpy(chunks[i].data, in, chunks[i].size);
+        in += STATE_PAD(chunks[i].size);
+    }
+
+    // Rebuild what was derived from the restored state: bank pointers, page table, decode cache
+    // (mmu_map_update), decoded tiles and the pending interrupts
+    mmu_map_update(gb);
+    ppu_invalidate_tiles(gb);
+    cpu_update_interrupts(&gb->cpu);
+
+    // The .sav flush follows this instance's setting, not the saved one
+    if (gb->save_sync_cycles)
+        sched_schedule(&gb->sched, SCHED_SAVE, gb->cycles + gb->save_sync_cycles);
+    else
+        sched_cancel(&gb->sched, SCHED_SAVE);
+
+    return true;
+}
+
+// ---------------------------------------------
+// Files
+// ---------------------------------------------
+int gb_save_state_file(GameBoy *gb, const char *path) {
+    static const u8 zeros[STATE_ALIGN];
+    StateCart       cart;
+    StateChunk      chunks[STATE_CHUNKS];
+    ChunkHeader     headers[STATE_CHUNKS];
+    struct iovec    iov[1 + 3 * STATE_CHUNKS];
+    int             n = 0;
+
+    fork_detach(gb, true);
+    state_chunks(gb, &cart, chunks);
+    size_t      total  = state_total(chunks);
+    StateHeader header = {STATE_MAGIC, GB_STATE_VERSION, STATE_CHUNKS, (u32)total};
+
+    iov[n++] = (struct iovec){&header, sizeof(header)};
+    for (int i = 0; i < STATE_CHUNKS; i++) {
+        headers[i] = (ChunkHeader){chunks[i].id, (u32)chunks[i].size};
+        iov[n++]   = (struct iovec){&headers[i], sizeof(ChunkHeader)};
+        iov[n++]   = (struct iovec){chunks[i].data, chunks[i].size};
+        iov[n++]   = (struct iovec){(void *)zeros, STATE_PAD(chunks[i].size) - chunks[i].size};
+    }
+
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return -1;
+
+    ssize_t written = writev(fd, iov, n);
+    if (close(fd) != 0 || written != (ssize_t)total)
+        return -1;
+    return 0;
+}
+
+int gb_load_state_file(GameBoy *gb, const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return -1;
+
+    struct stat st;
+    u8         *buf = NULL;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+        buf = malloc((size_t)st.st_size);
+
+    bool ok = buf && read(fd, buf, (size_t)st.st_size) == st.st_size &&
+              gb_load_state(gb, buf, (size_t)st.st_size);
+
+    free(buf);
+    close(fd);
+    return ok ? 0 : -1;
+}
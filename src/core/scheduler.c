@@ -0,0 +1,129 @@
+// src/core/scheduler.c
+#include <core/scheduler.h>
+#include <gbemu.h>
+#include <string.h>
+
+// ---------------------------------------------
+// Heap helpers
+// Ordered by deadline, ties broken by event kind so dispatch order is deterministic
+// ---------------------------------------------
+static bool entry_before(const SchedEntry *a, const SchedEntry *b) {
+    return a->when < b->when || (a->when == b->when && a->event < b->event);
+}
+
+static void heap_swap(Scheduler *s, int i, int j) {
+    SchedEntry tmp            = s->heap[i];
+    s->heap[i]                = s->heap[j];
+    s->heap[j]                = tmp;
+    s->slot[s->heap[i].event] = (i8)i;
+    s->slot[s->heap[j].event] = (i8)j;
+}
+
+static void sift_up(Scheduler *s, int i) {
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!entry_before(&s->heap[i], &s->heap[parent]))
+            break;
+        heap_swap(s, i, parent);
+        i = parent;
+    }
+}
+
+static void sift_down(Scheduler *s, int i) {
+    for (;;) {
+        int left     = 2 * i + 1;
+        int right    = left + 1;
+        int smallest = i;
+
+        if (left < s->count && entry_before(&s->heap[left], &s->heap[smallest]))
+            smallest = left;
+        if (right < s->count && entry_before(&s->heap[right], &s->heap[smallest]))
+            smallest = right;
+        if (smallest == i)
+            break;
+
+        heap_swap(s, i, smallest);
+        i = smallest;
+    }
+}
+
+// Move the last entry into the hole and restore the heap order around it
+static void heap_remove(Scheduler *s, int i) {
+    int last                  = --s->count;
+    s->slot[s->heap[i].event] = -1;
+
+    if (i == last)
+        return;
+
+    u8 moved       = s->heap[last].event;
+    s->heap[i]     = s->heap[last];
+    s->slot[moved] = (i8)i;
+    sift_up(s, i);
+    sift_down(s, s->slot[moved]);
+}
+
+// ---------------------------------------------
+// Scheduler Functions
+// ---------------------------------------------
+void sched_init(Scheduler *s) {
+    memset(s, 0, sizeof(Scheduler));
+    memset(s->slot, -1, sizeof(s->slot));
+    s->deadline = SCHED_NEVER;
+}
+
+void sched_set_handler(Scheduler *s, SchedEvent event, SchedHandler handler) {
+    s->handlers[event] = handler;
+}
+
+void sched_schedule(Scheduler *s, SchedEvent event, u64 when) {
+    int i = s->slot[event];
+
+    if (i < 0) {
+        i                = s->count++;
+        s->heap[i].event = (u8)event;
+        s->slot[event]   = (i8)i;
+    }
+
+    s->heap[i].when = when;
+    sift_up(s, i);
+    sift_down(s, s->slot[event]);
+
+    // A running cpu_run slice must stop in time for it
+    if (when < s->deadline)
+        s->deadline = when;
+}
+
+void sched_cancel(Scheduler *s, SchedEvent event) {
+    if (s->slot[event] >= 0)
+        heap_remove(s, s->slot[event]);
+}
+
+bool sched_is_pending(const Scheduler *s, SchedEvent event) {
+    return s->slot[event] >= 0;
+}
+
+u64 sched_when(const Scheduler *s, SchedEvent event) {
+    return s->slot[event] >= 0 ? s->heap[(int)s->slot[event]].when : SCHED_NEVER;
+}
+
+u64 sched_next(const Scheduler *s) {
+    return s->count ? s->heap[0].when : SCHED_NEVER;
+}
+
+void sched_set_deadline(Scheduler *s, u64 end) {
+    u64 next    = sched_next(s);
+    s->deadline = next < end ? next : end;
+}
+
+void sched_run_due(GameBoy *gb) {
+    Scheduler *s = &gb->sched;
+
+    while (s->count && s->heap[0].when <= gb->cycles) {
+        SchedEntry due = s->heap[0];
+        heap_remove(s, 0);
+
+        // The handler may schedule the event again
+        if (s->handlers[due.event])
+            s->handlers[due.event](gb, due.when);
+    }
+}
@@ -0,0 +1,242 @@
+// src/core/tile_decode.c
+#include <core/tile_decode.h>
+#include <pthread.h>
+
+#if !defined(GB_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TILE_SIMD_X86
+#include <immintrin.h>
+
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+typedef void (*TileDecodeFunc)(const u8 *planes, size_t rows, u8 palette, u8 *out);
+
+// ---------------------------------------------
+// Scalar kernel (reference, and tail of the vector ones)
+// ---------------------------------------------
+static void decode_scalar(const u8 *planes, size_t rows, u8 palette, u8 *out) {
+    const u8 shades[4] = {palette & 0x03, (palette >> 2) & 0x03, (palette >> 4) & 0x03,
+                          (palette >> 6) & 0x03};
+
+    for (size_t r = 0; r < rows; r++) {
+        u8 lo = planes[2 * r];
+        u8 hi = planes[2 * r + 1];
+
+        for (int i = 0; i < 8; i++) {
+            int bit        = 7 - i;
+            out[8 * r + i] = shades[((lo >> bit) & 1) | (((hi >> bit) & 1) << 1)];
+        }
+    }
+}
+
+#ifdef TILE_SIMD_X86
+// ---------------------------------------------
+// SSE2 kernel, 8 rows per iteration
+// Every plane byte is broadcast to the 8 lanes of its row, tested against one bit per lane, and
+// the two resulting masks select between the 4 palette shades.
+// ---------------------------------------------
+static inline TARGET_SSE2 __m128i select128(__m128i mask, __m128i if_clear, __m128i if_set) {
+    return _mm_or_si128(_mm_andnot_si128(mask, if_clear), _mm_and_si128(mask, if_set));
+}
+
+// Shades of two rows, lo and hi hold each row's plane bytes broadcast to 8 lanes
+static inline TARGET_SSE2 __m128i shade128(__m128i lo, __m128i hi, __m128i bits,
+                                           const __m128i shades[4]) {
+    __m128i lo_set = _mm_cmpeq_epi8(_mm_and_si128(lo, bits), bits);
+    __m128i hi_set = _mm_cmpeq_epi8(_mm_and_si128(hi, bits), bits);
+
+    return select128(hi_set, select128(lo_set, shades[0], shades[1]),
+                     select128(lo_set, shades[2], shades[3]));
+}
+
+static TARGET_SSE2 void decode_sse2(const u8 *planes, size_t rows, u8 palette, u8 *out) {
+    const __m128i bits      = _mm_setr_epi8((char)0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+                                            (char)0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+    const __m128i low_bytes = _mm_set1_epi16(0x00FF);
+    const __m128i zero      = _mm_setzero_si128();
+    const __m128i shades[4] = {_mm_set1_epi8(palette & 0x03), _mm_set1_epi8((palette >> 2) & 0x03),
+                               _mm_set1_epi8((palette >> 4) & 0x03),
+                               _mm_set1_epi8((palette >> 6) & 0x03)};
+    size_t        r         = 0;
+
+    for (; r + 8 <= rows; r += 8) {
+        __m128i in = _mm_loadu_si128((const __m128i *)(planes + 2 * r));
+
+        // Split the interleaved planes: bytes 0-7 are rows 0-7
+        __m128i lo = _mm_packus_epi16(_mm_and_si128(in, low_bytes), zero);
+        __m128i hi = _mm_packus_epi16(_mm_srli_epi16(in, 8), zero);
+
+        // Broadcast: x2, x4 (rows 0-3 / 4-7), then x8 (two rows per vector)
+        lo           = _mm_unpacklo_epi8(lo, lo);
+        hi           = _mm_unpacklo_epi8(hi, hi);
+        __m128i lo_a = _mm_unpacklo_epi16(lo, lo);
+        __m128i lo_b = _mm_unpackhi_epi16(lo, lo);
+        __m128i hi_a = _mm_unpacklo_epi16(hi, hi);
+        __m128i hi_b = _mm_unpackhi_epi16(hi, hi);
+
+        __m128i *dst = (__m128i *)(out + 8 * r);
+
+        _mm_storeu_si128(dst + 0, shade128(_mm_unpacklo_epi32(lo_a, lo_a),
+                                           _mm_unpacklo_epi32(hi_a, hi_a), bits, shades));
+        _mm_storeu_si128(dst + 1, shade128(_mm_unpackhi_epi32(lo_a, lo_a),
+                                           _mm_unpackhi_epi32(hi_a, hi_a), bits, shades));
+        _mm_storeu_si128(dst + 2, shade128(_mm_unpacklo_epi32(lo_b, lo_b),
+                                           _mm_unpacklo_epi32(hi_b, hi_b), bits, shades));
+        _mm_storeu_si128(dst + 3, shade128(_mm_unpackhi_epi32(lo_b, lo_b),
+                                           _mm_unpackhi_epi32(hi_b, hi_b), bits, shades));
+    }
+
+    decode_scalar(planes + 2 * r, rows - r, palette, out + 8 * r);
+}
+
+// ---------------------------------------------
+// AVX2 kernel, 16 rows per iteration
+// Same steps as SSE2 on two 128-bit lanes (rows 0-7 and 8-15), the unpacks stay within a lane so
+// the results are regrouped with cross-lane permutes before storing.
+// ---------------------------------------------
+static inline TARGET_AVX2 __m256i select256(__m256i mask, __m256i if_clear, __m256i if_set) {
+    return _mm256_or_si256(_mm256_andnot_si256(mask, if_clear), _mm256_and_si256(mask, if_set));
+}
+
+static inline TARGET_AVX2 __m256i shade256(__m256i lo, __m256i hi, __m256i bits,
+                                           const __m256i shades[4]) {
+    __m256i lo_set = _mm256_cmpeq_epi8(_mm256_and_si256(lo, bits), bits);
+    __m256i hi_set = _mm256_cmpeq_epi8(_mm256_and_si256(hi, bits), bits);
+
+    return select256(hi_set, select256(lo_set, shades[0], shades[1]),
+                     select256(lo_set, shades[2], shades[3]));
+}
+
+static TARGET_AVX2 void decode_avx2(const u8 *planes, size_t rows, u8 palette, u8 *out) {
+    const __m256i bits      = _mm256_set1_epi64x((long long)0x0102040810204080ULL);
+    const __m256i low_bytes = _mm256_set1_epi16(0x00FF);
+    const __m256i zero      = _mm256_setzero_si256();
+    const __m256i shades[4] = {_mm256_set1_epi8(palette & 0x03),
+                               _mm256_set1_epi8((palette >> 2) & 0x03),
+                               _mm256_set1_epi8((palette >> 4) & 0x03),
+                               _mm256_set1_epi8((palette >> 6) & 0x03)};
+    size_t        r         = 0;
+
+    for (; r + 16 <= rows; r += 16) {
+        __m256i in = _mm256_loadu_si256((const __m256i *)(planes + 2 * r));
+
+        __m256i lo = _mm256_packus_epi16(_mm256_and_si256(in, low_bytes), zero);
+        __m256i hi = _mm256_packus_epi16(_mm256_srli_epi16(in, 8), zero);
+
+        lo           = _mm256_unpacklo_epi8(lo, lo);
+        hi           = _mm256_unpacklo_epi8(hi, hi);
+        __m256i lo_a = _mm256_unpacklo_epi16(lo, lo);
+        __m256i lo_b = _mm256_unpackhi_epi16(lo, lo);
+        __m256i hi_a = _mm256_unpacklo_epi16(hi, hi);
+        __m256i hi_b = _mm256_unpackhi_epi16(hi, hi);
+
+        // Rows {0,1 | 8,9}, {2,3 | 10,11}, {4,5 | 12,13}, {6,7 | 14,15}
+        __m256i r01 = shade256(_mm256_unpacklo_epi32(lo_a, lo_a), _mm256_unpacklo_epi32(hi_a, hi_a),
+                               bits, shades);
+        __m256i r23 = shade256(_mm256_unpackhi_epi32(lo_a, lo_a), _mm256_unpackhi_epi32(hi_a, hi_a),
+                               bits, shades);
+        __m256i r45 = shade256(_mm256_unpacklo_epi32(lo_b, lo_b), _mm256_unpacklo_epi32(hi_b, hi_b),
+                               bits, shades);
+        __m256i r67 = shade256(_mm256_unpackhi_epi32(lo_b, lo_b), _mm256_unpackhi_epi32(hi_b, hi_b),
+                               bits, shades);
+
+        __m256i *dst = (__m256i *)(out + 8 * r);
+
+        _mm256_storeu_si256(dst + 0, _mm256_permute2x128_si256(r01, r23, 0x20));
+        _mm256_storeu_si256(dst + 1, _mm256_permute2x128_si256(r45, r67, 0x20));
+        _mm256_storeu_si256(dst + 2, _mm256_permute2x128_si256(r01, r23, 0x31));
+        _mm256_storeu_si256(dst + 3, _mm256_permute2x128_si256(r45, r67, 0x31));
+    }
+
+    decode_sse2(planes + 2 * r, rows - r, palette, out + 8 * r);
+}
+#endif // TILE_SIMD_X86
+
+// ---------------------------------------------
+// Dispatch
+// ---------------------------------------------
+// The best kernel is picked once, on first use from any thread
+// tile_decode_select can override it afterwards
+static TileDecodeFunc tile_decode_func;
+static TileDecodeImpl tile_decode_impl;
+static pthread_once_t tile_decode_once = PTHREAD_ONCE_INIT;
+
+bool tile_decode_supported(TileDecodeImpl impl) {
+    switch (impl) {
+        case TILE_DECODE_SCALAR:
+        case TILE_DECODE_AUTO:
+            return true;
+#ifdef TILE_SIMD_X86
+        case TILE_DECODE_SSE2:
+            return __builtin_cpu_supports("sse2");
+        case TILE_DECODE_AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+static bool use_kernel(TileDecodeImpl impl) {
+    if (impl == TILE_DECODE_AUTO) {
+        if (tile_decode_supported(TILE_DECODE_AVX2))
+            impl = TILE_DECODE_AVX2;
+        else if (tile_decode_supported(TILE_DECODE_SSE2))
+            impl = TILE_DECODE_SSE2;
+        else
+            impl = TILE_DECODE_SCALAR;
+    }
+
+    if (!tile_decode_supported(impl))
+        return false;
+
+    switch (impl) {
+#ifdef TILE_SIMD_X86
+        case TILE_DECODE_SSE2:
+            tile_decode_func = decode_sse2;
+            break;
+        case TILE_DECODE_AVX2:
+            tile_decode_func = decode_avx2;
+            break;
+#endif
+        default:
+            tile_decode_func = decode_scalar;
+            break;
+    }
+    tile_decode_impl = impl;
+    return true;
+}
+
+static void select_default(void) {
+    use_kernel(TILE_DECODE_AUTO);
+}
+
+bool tile_decode_select(TileDecodeImpl impl) {
+    // The default pick must not come later and undo this
+    pthread_once(&tile_decode_once, select_default);
+    return use_kernel(impl);
+}
+
+TileDecodeImpl tile_decode_active(void) {
+    pthread_once(&tile_decode_once, select_default);
+    return tile_decode_impl;
+}
+
+const char *tile_decode_name(TileDecodeImpl impl) {
+    switch (impl) {
+        case TILE_DECODE_SCALAR:
+            return "scalar";
+        case TILE_DECODE_SSE2:
+            return "sse2";
+        case TILE_DECODE_AVX2:
+            return "avx2";
+        default:
+            return "auto";
+    }
+}
+
+void tile_decode_rows(const u8 *planes, size_t rows, u8 palette, u8 *out) {
+    pthread_once(&tile_decode_once, select_default);
+    tile_decode_func(planes, rows, palette, out);
+}
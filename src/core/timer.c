@@ -0,0 +1,187 @@
+// src/core/timer.c
+#include <core/timer.h>
+#include <gbemu.h>
+
+/*
+Timer registers:
+https://gbdev.io/pandocs/Timer_and_Divider_Registers.html
+
+0xFF04 : DIV  - Upper 8 bits of the 16-bit system counter, any write resets the counter
+0xFF05 : TIMA - Incremented on a falling edge of the counter bit selected by TAC
+0xFF06 : TMA  - Loaded into TIMA one M-cycle after it overflows, when IF bit 2 is also raised
+0xFF07 : TAC  - Bit 2 enable, bits 0-1 select the rate (4096, 262144, 65536 or 16384 Hz)
+
+The system counter runs with the CPU clock, so it is never stored: it is gb->cycles plus an
+offset that DIV writes move. TIMA only changes on its own at multiples of the selected period,
+so the number of increments between two accesses is a division, and the one moment software
+can observe without reading the registers (the overflow interrupt) is a scheduler event.
+*/
+
+#define TAC_ENABLE 0x04
+#define TIMA_RELOAD_DELAY 4 // T-cycles between the overflow and the TMA reload
+
+// T-cycles per TIMA increment for each TAC clock select
+static const u16 tac_periods[4] = {1024, 16, 64, 256};
+
+static u16 timer_counter(const Timer *t, u64 now) {
+    return (u16)(now + t->div_offset);
+}
+
+// The counter bit TIMA watches, 0 while the timer is disabled
+static bool timer_bit(const Timer *t, u64 now) {
+    if (!(t->tac & TAC_ENABLE))
+        return false;
+    return (timer_counter(t, now) & (tac_periods[t->tac & 0x03] >> 1)) != 0;
+}
+
+// ---------------------------------------------
+// Catch-up
+// ---------------------------------------------
+
+// Bring TIMA up to date with cycle now, running any overflow and TMA reload in between
+static void timer_sync(GameBoy *gb, u64 now) {
+    Timer *t = &gb->timer;
+
+    while (t->tima_sync < now) {
+        // TIMA reads 0 until the reload
+        if (t->reload_pending) {
+            if (now < t->reload_at) {
+                t->tima_sync = now;
+                return;
+            }
+            t->tima           = t->tma;
+            t->reload_pending = false;
+            t->tima_sync      = t->reload_at;
+            gb_request_interrupt(gb, INT_TIMER);
+            continue;
+        }
+
+        if (!(t->tac & TAC_ENABLE)) {
+            t->tima_sync = now;
+            return;
+        }
+
+        // Falling edges happen whenever the counter's low bits wrap past the period
+        u64 period = tac_periods[t->tac & 0x03];
+        u64 phase  = timer_counter(t, t->tima_sync) & (period - 1);
+        u64 edges  = (phase + (now - t->tima_sync)) / period;
+        u64 left   = 0x100 - t->tima; // Increments until the overflow
+
+        if (edges < left) {
+            t->tima += (u8)edges;
+            t->tima_sync = now;
+            return;
+        }
+
+        u64 overflow_at   = t->tima_sync + (period - phase) + (left - 1) * period;
+        t->tima           = 0;
+        t->reload_pending = true;
+        t->reload_at      = overflow_at + TIMA_RELOAD_DELAY;
+        t->tima_sync      = overflow_at;
+    }
+}
+
+// Put the overflow event at the next TMA reload, or drop it while the timer can't overflow
+static void timer_reschedule(GameBoy *gb) {
+    Timer *t = &gb->timer;
+
+    if (t->reload_pending) {
+        sched_schedule(&gb->sched, SCHED_TIMER, t->reload_at);
+        return;
+    }
+    if (!(t->tac & TAC_ENABLE)) {
+        sched_cancel(&gb->sched, SCHED_TIMER);
+        return;
+    }
+
+    u64 period      = tac_periods[t->tac & 0x03];
+    u64 phase       = timer_counter(t, t->tima_sync) & (period - 1);
+    u64 overflow_at = t->tima_sync + (period - phase) + (u64)(0xFF - t->tima) * period;
+    sched_schedule(&gb->sched, SCHED_TIMER, overflow_at + TIMA_RELOAD_DELAY);
+}
+
+// Extra increment from a falling edge caused by a DIV or TAC write
+static void timer_glitch_tick(GameBoy *gb, u64 now) {
+    Timer *t = &gb->timer;
+
+    if (++t->tima == 0) {
+        t->reload_pending = true;
+        t->reload_at      = now + TIMA_RELOAD_DELAY;
+    }
+}
+
+static void timer_event(GameBoy *gb, u64 when) {
+    timer_sync(gb, when);
+    timer_reschedule(gb);
+}
+
+// ---------------------------------------------
+// Timer Functions
+// ---------------------------------------------
+void timer_init(GameBoy *gb) {
+    Timer *t          = &gb->timer;
+
+    // DMG state after the boot ROM: DIV = 0xAB, timer stopped
+    t->div_offset     = 0xABCC - gb->cycles;
+    t->tima_sync      = gb->cycles;
+    t->reload_at      = 0;
+    t->reload_pending = false;
+    t->tima           = 0x00;
+    t->tma            = 0x00;
+    t->tac            = 0x00;
+
+    sched_set_handler(&gb->sched, SCHED_TIMER, timer_event);
+    sched_cancel(&gb->sched, SCHED_TIMER);
+}
+
+u8 timer_read(GameBoy *gb, u16 addr) {
+    Timer *t   = &gb->timer;
+    u64    now = gb->cycles;
+
+    switch (addr) {
+        case 0xFF04: // DIV
+            return (u8)(timer_counter(t, now) >> 8);
+        case 0xFF05: // TIMA
+            timer_sync(gb, now);
+            return t->tima;
+        case 0xFF06: // TMA
+            return t->tma;
+        case 0xFF07: // TAC, upper 5 bits read as 1
+            return t->tac | 0xF8;
+        default:
+            return 0xFF;
+    }
+}
+
+void timer_write(GameBoy *gb, u16 addr, u8 value) {
+    Timer *t   = &gb->timer;
+    u64    now = gb->cycles;
+
+    timer_sync(gb, now);
+
+    switch (addr) {
+        case 0xFF04: // DIV: resetting the counter is a falling edge if the watched bit was set
+            if (timer_bit(t, now))
+                timer_glitch_tick(gb, now);
+            t->div_offset = (u64)0 - now;
+            break;
+        case 0xFF05: // TIMA: a write before the reload cancels it
+            t->reload_pending = false;
+            t->tima           = value;
+            break;
+        case 0xFF06: // TMA
+            t->tma = value;
+            break;
+        case 0xFF07: { // TAC: disabling or switching away from a set bit is a falling edge
+            bool was_set = timer_bit(t, now);
+            t->tac       = value & 0x07;
+            if (was_set && !timer_bit(t, now))
+                timer_glitch_tick(gb, now);
+            break;
+        }
+        default:
+            return;
+    }
+
+    timer_reschedule(gb);
+}
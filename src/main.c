@@ -7,7 +7,7 @@
 #include <stdlib.h>
 #include <string.h>
 
-#define RUN_DEBUG_INTERVAL 1000
+#define RUN_MAX_FRAMES 600 // Run mode timeout: 10 seconds of emulated time
 
 // Print the usage information
 static void print_usage(const char *program_name) {
@@ -157,6 +157,14 @@ int main(int argc, char *argv[]) {
         return 0;
     }
 
+    // Battery RAM lives in a .sav file next to the ROM
+    if (cart_has_battery(gb.cart.header.cart_type) && gb.cart.ram) {
+        char sav_path[4096];
+        if (cart_save_path(rom_path, sav_path, sizeof(sav_path)) &&
+            gb_attach_save(&gb, sav_path, GB_SAVE_SYNC_FRAMES) == 0)
+            printf("Save file: %s\n", sav_path);
+    }
+
     // Step mode
     if (step_count > 0) {
         printf("\nExecuting %d instructions...\n\n", step_count);
@@ -195,17 +203,27 @@ int main(int argc, char *argv[]) {
     // Run mode
     else if (run_mode) {
         printf("Running emulator (press Ctrl+C to stop)...\n");
-        printf("NOTE: No PPU/APU yet, this will just execute instructions.\n\n");
+        printf("NOTE: Headless, frames are rendered but not shown and there is no APU yet.\n\n");
 
-        for (int i = 0; i < 100000 && gb.running && !gb.cpu.halted; i++) {
-            gb_step(&gb);
+        // One frame per batch, the core also returns early on HALT
+        for (int frame = 0; frame < RUN_MAX_FRAMES && gb.running;) {
+            GbRunResult res = gb_run_cycles(&gb, GB_FRAME_CYCLES);
 
-            // Verbose output per interval if debug mode
-            if (debug_mode && (i % RUN_DEBUG_INTERVAL == 0)) {
-                printf("[RUN %06d] PC=0x%04X SP=0x%04X AF=%04X BC=%04X DE=%04X HL=%04X\n", i,
-                       gb.cpu.pc, gb.cpu.sp, cpu_read_af(&gb.cpu), cpu_read_bc(&gb.cpu),
+            // An interrupt ends HALT, unless none is enabled
+            if (res.reason == GB_STOP_HALT && !(gb.ie_register & 0x1F)) {
+                printf("\nCPU halted for good at PC=0x%04X (IE = 0)\n", (u16)(gb.cpu.pc - 1));
+                break;
+            }
+            if (res.reason != GB_STOP_FRAME)
+                continue;
+
+            // Verbose output per frame if debug mode
+            if (debug_mode) {
+                printf("[FRAME %04d] PC=0x%04X SP=0x%04X AF=%04X BC=%04X DE=%04X HL=%04X\n",
+                       frame, gb.cpu.pc, gb.cpu.sp, cpu_read_af(&gb.cpu), cpu_read_bc(&gb.cpu),
                        cpu_read_de(&gb.cpu), cpu_read_hl(&gb.cpu));
             }
+            frame++;
         }
 
         printf("\nEmulation finished.\n");
@@ -1,7 +1,12 @@
 // tests/test_cartridge.c
 #include <check.h>
+#include <fcntl.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
 #include <core/cartridge.h>
 
 // ============================================================================
@@ -293,6 +298,245 @@ START_TEST(test_header_checksum_invalid) {
 }
 END_TEST
 
+// ============================================================================
+// ROM Loading Tests
+// ============================================================================
+
+// Write a 64 KB image with a valid header checksum and a marker byte in each bank
+static void write_test_rom(char *path, const char *title) {
+    static u8 rom[0x10000];
+    memset(rom, 0, sizeof(rom));
+
+    memcpy(&rom[0x0134], title, strlen(title));
+    rom[0x0147] = 0x03; // MBC1+RAM+BATTERY
+    rom[0x0148] = 0x01; // 64 KB
+    rom[0x0149] = 0x02; // 8 KB RAM
+    rom[0x3FFF] = 0xA0;
+    rom[0xFFFF] = 0xA3;
+
+    u8 checksum = 0;
+    for (u16 addr = 0x0134; addr <= 0x014C; addr++)
+        checksum = checksum - rom[addr] - 1;
+    rom[0x014D] = checksum;
+
+    int fd = mkstemp(path);
+    ck_assert_int_ge(fd, 0);
+    ck_assert_int_eq(write(fd, rom, sizeof(rom)), (int)sizeof(rom));
+    close(fd);
+}
+
+START_TEST(test_cart_load_mapped) {
+    char path[] = "/tmp/baredmg_romXXXXXX";
+    write_test_rom(path, "LOADTEST");
+
+    Cartridge cart = {0};
+    ck_assert_int_eq(cart_load(&cart, path), 0);
+    remove(path);
+
+#if defined(__unix__) || defined(__APPLE__)
+    ck_assert(cart.rom_mapped);
+#endif
+    ck_assert_uint_eq(cart.rom_size, 0x10000);
+    ck_assert_uint_eq(cart.rom[0x3FFF], 0xA0);
+    ck_assert_uint_eq(cart.rom[0xFFFF], 0xA3);
+    ck_assert_str_eq(cart.header.title, "LOADTEST");
+
+    cart_unload(&cart);
+    ck_assert_ptr_null(cart.rom);
+    ck_assert(!cart.rom_mapped);
+}
+END_TEST
+
+START_TEST(test_cart_load_no_mmap) {
+    char path[] = "/tmp/baredmg_romXXXXXX";
+    write_test_rom(path, "LOADTEST");
+
+    Cartridge cart = {0};
+    ck_assert_int_eq(cart_load_flags(&cart, path, CART_LOAD_NO_MMAP), 0);
+    remove(path);
+
+    // Heap copy: writable, same contents
+    ck_assert(!cart.rom_mapped);
+    ck_assert_uint_eq(cart.rom[0xFFFF], 0xA3);
+    cart.rom[0xFFFF] = 0x00;
+
+    cart_unload(&cart);
+    ck_assert_ptr_null(cart.rom);
+}
+END_TEST
+
+START_TEST(test_cart_load_shared) {
+    char path_a[] = "/tmp/baredmg_romXXXXXX";
+    char path_b[] = "/tmp/baredmg_romXXXXXX";
+    char copy_a[] = "/tmp/baredmg_romXXXXXX";
+    write_test_rom(path_a, "SHARED");
+    write_test_rom(copy_a, "SHARED"); // Same image, other file
+    write_test_rom(path_b, "OTHER");
+
+    Cartridge first = {0}, second = {0}, other = {0};
+    ck_assert_int_eq(cart_load_shared(&first, path_a), 0);
+    ck_assert_int_eq(cart_load_shared(&second, copy_a), 0);
+    ck_assert_int_eq(cart_load_shared(&other, path_b), 0);
+    remove(path_a);
+    remove(copy_a);
+    remove(path_b);
+
+    // One ROM buffer for the same image, RAM stays per instance
+    ck_assert_ptr_eq(first.rom, second.rom);
+    ck_assert_ptr_ne(first.rom, other.rom);
+    ck_assert_ptr_ne(first.ram, second.ram);
+    ck_assert_str_eq(second.header.title, "SHARED");
+    ck_assert_uint_eq(cart_shared_images(), 2);
+
+    // The image outlives the first instance
+    cart_unload(&first);
+    ck_assert_ptr_null(first.rom);
+    ck_assert_uint_eq(second.rom[0xFFFF], 0xA3);
+    ck_assert_uint_eq(cart_shared_images(), 2);
+
+    cart_unload(&second);
+    cart_unload(&other);
+    ck_assert_uint_eq(cart_shared_images(), 0);
+}
+END_TEST
+
+START_TEST(test_cart_load_shared_same_header) {
+    char path[] = "/tmp/baredmg_romXXXXXX";
+    char hack[] = "/tmp/baredmg_romXXXXXX";
+    write_test_rom(path, "SHARED");
+    write_test_rom(hack, "SHARED");
+
+    // Same header and size, one byte of code changed
+    FILE *f = fopen(hack, "r+b");
+    ck_assert_ptr_nonnull(f);
+    fseek(f, 0x8000, SEEK_SET);
+    fputc(0x42, f);
+    fclose(f);
+
+    Cartridge original = {0}, patched = {0}, again = {0};
+    ck_assert_int_eq(cart_load_shared(&original, path), 0);
+    ck_assert_int_eq(cart_load_shared(&patched, hack), 0);
+    ck_assert_int_eq(cart_load_shared(&again, path), 0);
+    remove(path);
+    remove(hack);
+
+    ck_assert_ptr_ne(original.rom, patched.rom);
+    ck_assert_ptr_eq(original.rom, again.rom);
+    ck_assert_uint_eq(original.rom[0x8000], 0x00);
+    ck_assert_uint_eq(patched.rom[0x8000], 0x42);
+    ck_assert_uint_eq(cart_shared_images(), 2);
+
+    cart_unload(&original);
+    cart_unload(&patched);
+    cart_unload(&again);
+    ck_assert_uint_eq(cart_shared_images(), 0);
+}
+END_TEST
+
+START_TEST(test_cart_load_shared_rebuilt_in_place) {
+    char            path[]   = "/tmp/baredmg_romXXXXXX";
+    struct timespec first[2] = {{1000, 1}, {1000, 1}};
+    struct timespec later[2] = {{1000, 2}, {1000, 2}};
+    write_test_rom(path, "REBUILT");
+    ck_assert_int_eq(utimensat(AT_FDCWD, path, first, 0), 0);
+
+    Cartridge old = {0}, rebuilt = {0};
+    ck_assert_int_eq(cart_load_shared(&old, path), 0);
+
+    // Same file, size and second, new contents
+    FILE *f = fopen(path, "r+b");
+    ck_assert_ptr_nonnull(f);
+    fseek(f, 0x8000, SEEK_SET);
+    fputc(0x42, f);
+    fclose(f);
+    ck_assert_int_eq(utimensat(AT_FDCWD, path, later, 0), 0);
+
+    ck_assert_int_eq(cart_load_shared(&rebuilt, path), 0);
+    remove(path);
+
+    // Not handed the image loaded before the rebuild (a mapped one may show the new bytes too)
+    ck_assert_uint_eq(rebuilt.rom[0x8000], 0x42);
+
+    cart_unload(&old);
+    cart_unload(&rebuilt);
+}
+END_TEST
+
+START_TEST(test_cart_load_missing_file) {
+    Cartridge cart = {0};
+    ck_assert_int_eq(cart_load(&cart, "/nonexistent/baredmg.gb"), 1);
+    ck_assert_int_eq(cart_load_shared(&cart, "/nonexistent/baredmg.gb"), 1);
+    ck_assert_ptr_null(cart.rom);
+}
+END_TEST
+
+// ============================================================================
+// Battery Save Tests
+// ============================================================================
+
+START_TEST(test_cart_has_battery) {
+    ck_assert(cart_has_battery(0x03));  // MBC1+RAM+BATTERY
+    ck_assert(cart_has_battery(0x10));  // MBC3+TIMER+RAM+BATTERY
+    ck_assert(cart_has_battery(0x1E));  // MBC5+RUMBLE+RAM+BATTERY
+    ck_assert(!cart_has_battery(0x00)); // ROM ONLY
+    ck_assert(!cart_has_battery(0x1A)); // MBC5+RAM
+}
+END_TEST
+
+START_TEST(test_cart_save_path) {
+    char out[32];
+
+    ck_assert(cart_save_path("roms/game.gb", out, sizeof(out)));
+    ck_assert_str_eq(out, "roms/game.sav");
+
+    // Dots in directories aren't extensions
+    ck_assert(cart_save_path("roms.v2/game", out, sizeof(out)));
+    ck_assert_str_eq(out, "roms.v2/game.sav");
+
+    ck_assert(!cart_save_path("a/very/long/path/to/some/game.gbc", out, sizeof(out)));
+}
+END_TEST
+
+START_TEST(test_cart_map_save) {
+    char rom_path[] = "/tmp/baredmg_romXXXXXX";
+    char sav_path[] = "/tmp/baredmg_savXXXXXX";
+    write_test_rom(rom_path, "SAVETEST");
+
+    int fd = mkstemp(sav_path); // Exists but empty, like a new save
+    ck_assert_int_ge(fd, 0);
+    close(fd);
+
+    Cartridge cart = {0};
+    ck_assert_int_eq(cart_load(&cart, rom_path), 0);
+
+    // RAM written before attaching carries over into a new save
+    cart.ram[0] = 0x5A;
+    ck_assert_int_eq(cart_map_save(&cart, sav_path), 0);
+    ck_assert(cart.ram_mapped);
+    ck_assert_uint_eq(cart.ram[0], 0x5A);
+    cart.ram[0x1FFF] = 0x77;
+    cart_unload(&cart);
+
+    // Written back, sized to the RAM
+    FILE *sav = fopen(sav_path, "rb");
+    u8    data[0x2001];
+    ck_assert_ptr_nonnull(sav);
+    ck_assert_uint_eq(fread(data, 1, sizeof(data), sav), 0x2000);
+    fclose(sav);
+    ck_assert_uint_eq(data[0], 0x5A);
+    ck_assert_uint_eq(data[0x1FFF], 0x77);
+
+    // An existing save wins over the fresh RAM
+    ck_assert_int_eq(cart_load(&cart, rom_path), 0);
+    ck_assert_int_eq(cart_map_save(&cart, sav_path), 0);
+    ck_assert_uint_eq(cart.ram[0x1FFF], 0x77);
+    cart_unload(&cart);
+
+    remove(rom_path);
+    remove(sav_path);
+}
+END_TEST
+
 // ============================================================================
 // Test Suite Setup
 // ============================================================================
@@ -300,7 +544,7 @@ END_TEST
 Suite *cartridge_suite(void) {
     Suite *s;
     TCase *tc_ram_size, *tc_rom_size, *tc_cart_type, *tc_publisher;
-    TCase *tc_parse, *tc_checksum;
+    TCase *tc_parse, *tc_checksum, *tc_load, *tc_save;
 
     s           = suite_create("Cartridge");
 
@@ -358,6 +602,23 @@ Suite *cartridge_suite(void) {
     tcase_add_test(tc_checksum, test_header_checksum_invalid);
     suite_add_tcase(s, tc_checksum);
 
+    // Loading from disk, mapped and copied
+    tc_load = tcase_create("ROM Loading");
+    tcase_add_test(tc_load, test_cart_load_mapped);
+    tcase_add_test(tc_load, test_cart_load_no_mmap);
+    tcase_add_test(tc_load, test_cart_load_shared);
+    tcase_add_test(tc_load, test_cart_load_shared_same_header);
+    tcase_add_test(tc_load, test_cart_load_shared_rebuilt_in_place);
+    tcase_add_test(tc_load, test_cart_load_missing_file);
+    suite_add_tcase(s, tc_load);
+
+    // Battery RAM backed by .sav files
+    tc_save = tcase_create("Battery Saves");
+    tcase_add_test(tc_save, test_cart_has_battery);
+    tcase_add_test(tc_save, test_cart_save_path);
+    tcase_add_test(tc_save, test_cart_map_save);
+    suite_add_tcase(s, tc_save);
+
     return s;
 }
 
@@ -0,0 +1,1109 @@
+// tests/test_cpu.c
+#include <check.h>
+#include <gbemu.h>
+#include <core/bus.h>
+#include <core/cpu/cpu.h>
+#include <core/cpu/cpu_decode.h>
+#include <core/cpu/cpu_exec.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// Machine Setup
+// ============================================================================
+
+// Fresh machine with the LCD off, so no PPU events cut cpu_run slices short
+static void init_cpu_only(GameBoy *gb) {
+    gb_init(gb);
+    mmu_write(gb, 0xFF40, 0x00);
+}
+
+// ============================================================================
+// Reference Cycle Counts
+// https://www.pastraiser.com/cpu/gameboy/gameboy_opcodes.html
+// Conditional instructions list the taken variant here and the not-taken one below
+// ============================================================================
+
+// clang-format off
+static const u8 ref_cycles[256] = {
+//  x0  x1  x2  x3  x4  x5  x6  x7  x8  x9  xA  xB  xC  xD  xE  xF
+     4, 12,  8,  8,  4,  4,  8,  4, 20,  8,  8,  8,  4,  4,  8,  4, // 0x
+     4, 12,  8,  8,  4,  4,  8,  4, 12,  8,  8,  8,  4,  4,  8,  4, // 1x
+    12, 12,  8,  8,  4,  4,  8,  4, 12,  8,  8,  8,  4,  4,  8,  4, // 2x
+    12, 12,  8,  8, 12, 12, 12,  4, 12,  8,  8,  8,  4,  4,  8,  4, // 3x
+     4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 4x
+     4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 5x
+     4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 6x
+     8,  8,  8,  8,  8,  8,  4,  8,  4,  4,  4,  4,  4,  4,  8,  4, // 7x
+     4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 8x
+     4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // 9x
+     4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // Ax
+     4,  4,  4,  4,  4,  4,  8,  4,  4,  4,  4,  4,  4,  4,  8,  4, // Bx
+    20, 12, 16, 16, 24, 16,  8, 16, 20, 16, 16,  4, 24, 24,  8, 16, // Cx
+    20, 12, 16,  4, 24, 16,  8, 16, 20, 16, 16,  4, 24,  4,  8, 16, // Dx
+    12, 12,  8,  4,  4, 16,  8, 16, 16,  4, 16,  4,  4,  4,  8, 16, // Ex
+    12, 12,  8,  4,  4, 16,  8, 16, 12,  8, 16,  4,  4,  4,  8, 16, // Fx
+};
+// clang-format on
+
+// Conditional branches: opcode, flag that selects them, whether they jump when it is set
+typedef struct {
+    u8   opcode;
+    u8   flag;
+    bool when_set;
+    u8   not_taken;
+} BranchCase;
+
+static const BranchCase branch_cases[] = {
+    {0x20, FLAG_ZERO, false, 8},   {0x28, FLAG_ZERO, true, 8},   // JR cc
+    {0x30, FLAG_CARRY, false, 8},  {0x38, FLAG_CARRY, true, 8},  //
+    {0xC2, FLAG_ZERO, false, 12},  {0xCA, FLAG_ZERO, true, 12},  // JP cc
+    {0xD2, FLAG_CARRY, false, 12}, {0xDA, FLAG_CARRY, true, 12}, //
+    {0xC4, FLAG_ZERO, false, 12},  {0xCC, FLAG_ZERO, true, 12},  // CALL cc
+    {0xD4, FLAG_CARRY, false, 12}, {0xDC, FLAG_CARRY, true, 12}, //
+    {0xC0, FLAG_ZERO, false, 8},   {0xC8, FLAG_ZERO, true, 8},   // RET cc
+    {0xD0, FLAG_CARRY, false, 8},  {0xD8, FLAG_CARRY, true, 8},  //
+};
+
+#define BRANCH_CASE_COUNT (sizeof(branch_cases) / sizeof(branch_cases[0]))
+
+static const BranchCase *find_branch(u8 opcode) {
+    for (size_t i = 0; i < BRANCH_CASE_COUNT; i++) {
+        if (branch_cases[i].opcode == opcode)
+            return &branch_cases[i];
+    }
+    return NULL;
+}
+
+// Execute a single opcode on a fresh machine with the given flags
+static u8 run_opcode(u8 opcode, u8 flags) {
+    GameBoy gb;
+    init_cpu_only(&gb);
+    gb.cpu.pc     = 0xC000;
+    gb.cpu.regs.f = flags;
+    return cpu_execute(&gb.cpu, opcode);
+}
+
+// ============================================================================
+// Cycle Accounting Tests
+// ============================================================================
+
+START_TEST(test_cycles_unconditional) {
+    for (int op = 0; op < 256; op++) {
+        if (op == 0xCB || find_branch(op))
+            continue;
+
+        ck_assert_msg(run_opcode(op, 0x00) == ref_cycles[op], "opcode 0x%02X: got %u, want %u", op,
+                      run_opcode(op, 0x00), ref_cycles[op]);
+    }
+}
+END_TEST
+
+START_TEST(test_cycles_branch_taken) {
+    for (size_t i = 0; i < BRANCH_CASE_COUNT; i++) {
+        const BranchCase *bc    = &branch_cases[i];
+        u8                flags = bc->when_set ? bc->flag : 0x00;
+
+        ck_assert_msg(run_opcode(bc->opcode, flags) == ref_cycles[bc->opcode],
+                      "opcode 0x%02X taken", bc->opcode);
+    }
+}
+END_TEST
+
+START_TEST(test_cycles_branch_not_taken) {
+    for (size_t i = 0; i < BRANCH_CASE_COUNT; i++) {
+        const BranchCase *bc    = &branch_cases[i];
+        u8                flags = bc->when_set ? 0x00 : bc->flag;
+
+        ck_assert_msg(run_opcode(bc->opcode, flags) == bc->not_taken, "opcode 0x%02X not taken",
+                      bc->opcode);
+    }
+}
+END_TEST
+
+// ============================================================================
+// CB Prefix Tests
+// ============================================================================
+
+// Execute CB opcode on a fresh machine: operands B = 0x85, (HL) = 0x85 at 0xC100
+static u8 run_cb(GameBoy *gb, u8 opcode, u8 flags) {
+    init_cpu_only(gb);
+    gb->wram[0x0000] = opcode;
+    gb->wram[0x0100] = 0x85;
+    gb->cpu.regs.b   = 0x85;
+    gb->cpu.regs.h   = 0xC1;
+    gb->cpu.regs.l   = 0x00;
+    gb->cpu.regs.f   = flags;
+    gb->cpu.pc       = 0xC000;
+    return cpu_execute(&gb->cpu, 0xCB);
+}
+
+START_TEST(test_cb_cycles) {
+    GameBoy gb;
+
+    for (int op = 0; op < 256; op++) {
+        u8 want = 8;
+        if ((op & 7) == 6)
+            want = (op >> 6) == 1 ? 12 : 16;
+
+        ck_assert_msg(run_cb(&gb, op, 0x00) == want, "CB 0x%02X: got %u, want %u", op,
+                      run_cb(&gb, op, 0x00), want);
+        ck_assert_uint_eq(gb.cpu.pc, 0xC001);
+    }
+}
+END_TEST
+
+START_TEST(test_cb_results) {
+    // Operation on 0x85 (B and (HL)) with the given flags: result and flags
+    static const struct {
+        u8 op, flags, result, f;
+    } cases[] = {
+        {0x00, 0x00, 0x0B, FLAG_CARRY},                       // RLC
+        {0x08, 0x00, 0xC2, FLAG_CARRY},                       // RRC
+        {0x10, 0x00, 0x0A, FLAG_CARRY},                       // RL, carry out
+        {0x18, FLAG_CARRY, 0xC2, FLAG_CARRY},                 // RR, carry in
+        {0x20, 0x00, 0x0A, FLAG_CARRY},                       // SLA
+        {0x28, 0x00, 0xC2, FLAG_CARRY},                       // SRA keeps bit 7
+        {0x30, FLAG_CARRY, 0x58, 0x00},                       // SWAP clears C
+        {0x38, 0x00, 0x42, FLAG_CARRY},                       // SRL
+        {0x40, FLAG_CARRY, 0x85, FLAG_HF_CARRY | FLAG_CARRY}, // BIT 0, set: C kept
+        {0x48, 0x00, 0x85, FLAG_ZERO | FLAG_HF_CARRY},        // BIT 1, clear
+        {0x80, FLAG_SUBT, 0x84, FLAG_SUBT},                   // RES 0 keeps the flags
+        {0xF0, 0x00, 0xC5, 0x00},                             // SET 6
+    };
+
+    GameBoy gb;
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        run_cb(&gb, cases[i].op, cases[i].flags);
+        ck_assert_msg(gb.cpu.regs.b == cases[i].result, "CB 0x%02X", cases[i].op);
+        ck_assert_msg(gb.cpu.regs.f == cases[i].f, "CB 0x%02X flags", cases[i].op);
+
+        run_cb(&gb, cases[i].op | 6, cases[i].flags);
+        ck_assert_msg(gb.wram[0x0100] == cases[i].result, "CB 0x%02X", cases[i].op | 6);
+        ck_assert_msg(gb.cpu.regs.f == cases[i].f, "CB 0x%02X flags", cases[i].op | 6);
+    }
+
+    // Zero result: SRL A on 0x01
+    gb.wram[0x0000] = 0x3F;
+    gb.cpu.regs.a   = 0x01;
+    gb.cpu.pc       = 0xC000;
+    cpu_execute(&gb.cpu, 0xCB);
+    ck_assert_uint_eq(gb.cpu.regs.a, 0x00);
+    ck_assert_uint_eq(gb.cpu.regs.f, FLAG_ZERO | FLAG_CARRY);
+}
+END_TEST
+
+// ============================================================================
+// Frame Timing Tests
+// ============================================================================
+
+START_TEST(test_run_frame_bounded) {
+    GameBoy gb;
+    init_cpu_only(&gb);
+
+    // JR -2: a 12-cycle busy loop in WRAM, 70224 is a multiple of 12
+    gb.wram[0x0000] = 0x18;
+    gb.wram[0x0001] = 0xFE;
+    gb.cpu.pc       = 0xC000;
+    gb.running      = true;
+
+    gb_run_frame(&gb);
+
+    ck_assert_uint_eq(gb.cycles, GB_FRAME_CYCLES);
+    ck_assert_uint_eq(gb.cpu.pc, 0xC000);
+}
+END_TEST
+
+START_TEST(test_run_frame_halted) {
+    GameBoy gb;
+    init_cpu_only(&gb);
+
+    gb.cpu.halted = true;
+    gb.running    = true;
+
+    gb_run_frame(&gb);
+    gb_run_frame(&gb);
+
+    ck_assert_uint_eq(gb.cycles, 2 * GB_FRAME_CYCLES);
+}
+END_TEST
+
+// ============================================================================
+// Run Loop Tests
+// cpu_run is checked against cpu_step, one instruction at a time (budget 1)
+// and in one long call, on random programs in WRAM
+// ============================================================================
+
+#define FUZZ_SEEDS 64
+#define FUZZ_STEPS 2000
+
+static u32 fuzz_state;
+
+static u8 fuzz_byte(void) {
+    fuzz_state = fuzz_state * 1103515245u + 12345u;
+    return (u8)(fuzz_state >> 16);
+}
+
+// Opcodes that stop or derail the comparison: illegal, HALT, STOP
+static const u8 fuzz_skipped[] = {0x10, 0x76, 0xD3, 0xDB, 0xDD, 0xE3, 0xE4,
+                                  0xEB, 0xEC, 0xED, 0xF4, 0xFC, 0xFD};
+
+static bool fuzz_skip(u8 op) {
+    for (size_t i = 0; i < sizeof(fuzz_skipped); i++) {
+        if (fuzz_skipped[i] == op)
+            return true;
+    }
+    return false;
+}
+
+static void fuzz_setup(GameBoy *gb, u32 seed) {
+    init_cpu_only(gb);
+    fuzz_state = seed;
+
+    for (size_t i = 0; i < sizeof(gb->wram); i++) {
+        u8 op        = fuzz_byte();
+        gb->wram[i] = fuzz_skip(op) ? 0x00 : op;
+    }
+
+    gb->cpu.regs.a = fuzz_byte();
+    gb->cpu.regs.f = fuzz_byte() & 0xF0;
+    gb->cpu.regs.b = fuzz_byte();
+    gb->cpu.regs.c = fuzz_byte();
+    gb->cpu.regs.d = 0xC0 | (fuzz_byte() & 0x1F);
+    gb->cpu.regs.e = fuzz_byte();
+    gb->cpu.regs.h = 0xC0 | (fuzz_byte() & 0x1F);
+    gb->cpu.regs.l = fuzz_byte();
+    gb->cpu.sp     = 0xDFF0;
+    gb->cpu.pc     = 0xC000;
+    gb->running    = true;
+}
+
+static bool same_state(const GameBoy *x, const GameBoy *y) {
+    return memcmp(&x->cpu.regs, &y->cpu.regs, sizeof(x->cpu.regs)) == 0 &&
+           x->cpu.pc == y->cpu.pc && x->cpu.sp == y->cpu.sp && x->cpu.ime == y->cpu.ime &&
+           x->cpu.halted == y->cpu.halted && x->cycles == y->cycles &&
+           memcmp(x->wram, y->wram, sizeof(x->wram)) == 0 &&
+           memcmp(x->hram, y->hram, sizeof(x->hram)) == 0 &&
+           memcmp(x->vram, y->vram, sizeof(x->vram)) == 0;
+}
+
+START_TEST(test_run_matches_step) {
+    static GameBoy ref, run;
+
+    for (u32 seed = 1; seed <= FUZZ_SEEDS; seed++) {
+        fuzz_setup(&ref, seed);
+        fuzz_setup(&run, seed);
+
+        for (int i = 0; i < FUZZ_STEPS && !ref.cpu.halted; i++) {
+            u16 pc     = ref.cpu.pc;
+            u8  opcode = mmu_read(&ref, pc);
+
+            ref.cycles += cpu_step(&ref.cpu);
+            cpu_run(&run.cpu, 1);
+
+            ck_assert_msg(same_state(&ref, &run), "seed %u: opcode 0x%02X at 0x%04X diverged", seed,
+                          opcode, pc);
+        }
+    }
+}
+END_TEST
+
+START_TEST(test_run_long_budget) {
+    static GameBoy ref, run;
+
+    for (u32 seed = 1; seed <= FUZZ_SEEDS; seed++) {
+        fuzz_setup(&ref, seed);
+        fuzz_setup(&run, seed);
+
+        while (ref.cycles < 10000 && !ref.cpu.halted)
+            ref.cycles += cpu_step(&ref.cpu);
+        u32 ran = cpu_run(&run.cpu, 10000);
+
+        ck_assert_uint_eq(ran, ref.cycles);
+        ck_assert_msg(same_state(&ref, &run), "seed %u diverged", seed);
+    }
+}
+END_TEST
+
+START_TEST(test_run_zero_budget) {
+    GameBoy gb;
+    init_cpu_only(&gb);
+    gb.cpu.pc = 0xC000;
+
+    ck_assert_uint_eq(cpu_run(&gb.cpu, 0), 0);
+    ck_assert_uint_eq(gb.cpu.pc, 0xC000);
+}
+END_TEST
+
+START_TEST(test_run_ei_delay) {
+    GameBoy gb;
+    init_cpu_only(&gb);
+
+    // EI; NOP: IME is still off right after EI and on once the NOP has started
+    gb.wram[0x0000] = 0xFB;
+    gb.wram[0x0001] = 0x00;
+    gb.cpu.pc       = 0xC000;
+
+    cpu_run(&gb.cpu, 1);
+    ck_assert(!gb.cpu.ime);
+    cpu_run(&gb.cpu, 1);
+    ck_assert(gb.cpu.ime);
+    ck_assert_uint_eq(gb.cpu.pc, 0xC002);
+}
+END_TEST
+
+// ============================================================================
+// Batched Execution Tests
+// ============================================================================
+
+// Fresh machine executing from WRAM
+static void setup_wram_program(GameBoy *gb, const u8 *code, size_t len) {
+    init_cpu_only(gb);
+    memcpy(gb->wram, code, len);
+    gb->cpu.pc  = 0xC000;
+    gb->running = true;
+}
+
+START_TEST(test_run_cycles_budget) {
+    static const u8 code[] = {0x18, 0xFE}; // JR -2
+    GameBoy         gb;
+    setup_wram_program(&gb, code, sizeof(code));
+
+    GbRunResult res = gb_run_cycles(&gb, 100);
+
+    ck_assert_int_eq(res.reason, GB_STOP_BUDGET);
+    ck_assert_uint_eq(res.cycles, 108);
+    ck_assert_uint_eq(res.overshoot, 8);
+    ck_assert_uint_eq(gb.cycles, 108);
+}
+END_TEST
+
+START_TEST(test_run_cycles_frame_end) {
+    static const u8 code[] = {0x18, 0xFE}; // JR -2
+    GameBoy         gb;
+    setup_wram_program(&gb, code, sizeof(code));
+    gb.cycles       = GB_FRAME_CYCLES - 224;
+
+    GbRunResult res = gb_run_cycles(&gb, 1000);
+
+    // 19 loops of 12 cycles to cross the boundary
+    ck_assert_int_eq(res.reason, GB_STOP_FRAME);
+    ck_assert_uint_eq(res.cycles, 228);
+    ck_assert_uint_eq(res.overshoot, 4);
+}
+END_TEST
+
+START_TEST(test_run_cycles_halt) {
+    static const u8 code[] = {0x00, 0x00, 0x76}; // NOP; NOP; HALT
+    GameBoy         gb;
+    setup_wram_program(&gb, code, sizeof(code));
+
+    GbRunResult res = gb_run_cycles(&gb, 1000);
+
+    ck_assert_int_eq(res.reason, GB_STOP_HALT);
+    ck_assert_uint_eq(res.cycles, 12);
+    ck_assert_uint_eq(res.overshoot, 0);
+    ck_assert_uint_eq(gb.cpu.pc, 0xC003);
+
+    // Already halted: idles through the budget
+    res = gb_run_cycles(&gb, 1000);
+    ck_assert_int_eq(res.reason, GB_STOP_BUDGET);
+    ck_assert_uint_eq(res.cycles, 1000);
+}
+END_TEST
+
+START_TEST(test_run_cycles_breakpoint) {
+    static const u8 code[] = {0x00, 0x00, 0x00, 0x18, 0xFB}; // NOP x3; JR -5
+    GameBoy         gb;
+    setup_wram_program(&gb, code, sizeof(code));
+    ck_assert(gb_add_breakpoint(&gb, 0xC002));
+
+    GbRunResult res = gb_run_cycles(&gb, 1000);
+    ck_assert_int_eq(res.reason, GB_STOP_BREAKPOINT);
+    ck_assert_uint_eq(res.cycles, 8);
+    ck_assert_uint_eq(gb.cpu.pc, 0xC002);
+
+    // Resuming from the breakpoint runs the loop once more back to it
+    res = gb_run_cycles(&gb, 1000);
+    ck_assert_int_eq(res.reason, GB_STOP_BREAKPOINT);
+    ck_assert_uint_eq(res.cycles, 4 + 12 + 8);
+
+    gb_clear_breakpoints(&gb);
+    res = gb_run_cycles(&gb, 1000);
+    ck_assert_int_eq(res.reason, GB_STOP_BUDGET);
+}
+END_TEST
+
+START_TEST(test_run_frame_halt_on_boundary) {
+    static const u8 code[] = {0x00, 0x00, 0x76}; // NOP; NOP; HALT
+    GameBoy         gb;
+    setup_wram_program(&gb, code, sizeof(code));
+    gb.cycles = GB_FRAME_CYCLES - 12;
+
+    // HALT completes exactly at the frame end: that frame is done, not the next one
+    gb_run_frame(&gb);
+    ck_assert(gb.cpu.halted);
+    ck_assert_uint_eq(gb.cycles, GB_FRAME_CYCLES);
+}
+END_TEST
+
+START_TEST(test_run_frame_breakpoint_on_boundary) {
+    static const u8 code[] = {0x00, 0x00, 0x18, 0xFC}; // NOP; NOP; JR -4
+    GameBoy         gb;
+    setup_wram_program(&gb, code, sizeof(code));
+    ck_assert(gb_add_breakpoint(&gb, 0xC002));
+    gb.cycles = GB_FRAME_CYCLES - 8;
+
+    gb_run_frame(&gb);
+    ck_assert_uint_eq(gb.cpu.pc, 0xC002);
+    ck_assert_uint_eq(gb.cycles, GB_FRAME_CYCLES);
+}
+END_TEST
+
+START_TEST(test_run_cycles_not_running) {
+    GameBoy gb;
+    init_cpu_only(&gb);
+
+    GbRunResult res = gb_run_cycles(&gb, 1000);
+
+    ck_assert_uint_eq(res.cycles, 0);
+    ck_assert_uint_eq(gb.cycles, 0);
+}
+END_TEST
+
+START_TEST(test_breakpoint_slots) {
+    GameBoy gb;
+    init_cpu_only(&gb);
+
+    for (int i = 0; i < GB_MAX_BREAKPOINTS; i++)
+        ck_assert(gb_add_breakpoint(&gb, 0xC000 + i));
+    ck_assert(!gb_add_breakpoint(&gb, 0xD000));
+}
+END_TEST
+
+// ============================================================================
+// Decode Cache Tests
+// ============================================================================
+
+START_TEST(test_decode_block_shape) {
+    // LD A, n; INC A; JR -3; NOP
+    static const u8 code[] = {0x3E, 0x01, 0x3C, 0x18, 0xFD, 0x00};
+    GameBoy         gb;
+    setup_wram_program(&gb, code, sizeof(code));
+
+    const DecodedBlock *blk = cpu_decode_block(&gb, 0xC000);
+
+    // Ends at the jump
+    ck_assert_ptr_nonnull(blk);
+    ck_assert_uint_eq(blk->count, 3);
+    ck_assert_ptr_eq(blk->host, gb.wram);
+
+    // Second lookup hits the same entry
+    ck_assert_ptr_eq(cpu_decode_block(&gb, 0xC000), blk);
+
+    // Not cacheable: I/O page
+    ck_assert_ptr_null(cpu_decode_block(&gb, 0xFF80));
+
+    // SWAP A; JR -4: the CB instruction is one entry, its own handler
+    gb.wram[0x0100] = 0xCB;
+    gb.wram[0x0101] = 0x37;
+    gb.wram[0x0102] = 0x18;
+    gb.wram[0x0103] = 0xFC;
+    blk             = cpu_decode_block(&gb, 0xC100);
+    ck_assert_ptr_nonnull(blk);
+    ck_assert_uint_eq(blk->count, 2);
+    ck_assert(blk->handlers[0] == cpu_get_cb_handler(0x37));
+}
+END_TEST
+
+START_TEST(test_decode_traps_code_page) {
+    static const u8 code[] = {0x00, 0x76}; // NOP; HALT
+    GameBoy         gb;
+    setup_wram_program(&gb, code, sizeof(code));
+
+    const DecodedBlock *blk = cpu_decode_block(&gb, 0xC000);
+
+    // WRAM page and its echo lose direct writes, the rest of WRAM keeps them
+    ck_assert_ptr_null(gb.write_map[0xC0]);
+    ck_assert_ptr_null(gb.write_map[0xE0]);
+    ck_assert_ptr_nonnull(gb.write_map[0xC1]);
+
+    // A write through the echo drops the block and restores both pages
+    mmu_write(&gb, 0xE050, 0x12);
+    ck_assert_uint_eq(gb.wram[0x0050], 0x12);
+    ck_assert_ptr_eq(gb.write_map[0xC0], gb.wram);
+    ck_assert_ptr_eq(gb.write_map[0xE0], gb.wram);
+    ck_assert_ptr_null(blk->host);
+}
+END_TEST
+
+START_TEST(test_decode_self_modifying_block) {
+    // LD A, 0x3C; LD (0xC006), A; NOP; NOP; HALT
+    // Patches the second NOP of its own block into INC A
+    static const u8 code[] = {0x3E, 0x3C, 0xEA, 0x06, 0xC0, 0x00, 0x00, 0x76};
+    GameBoy         gb;
+    setup_wram_program(&gb, code, sizeof(code));
+
+    cpu_run(&gb.cpu, 1000);
+
+    ck_assert(gb.cpu.halted);
+    ck_assert_uint_eq(gb.cpu.regs.a, 0x3D);
+}
+END_TEST
+
+START_TEST(test_decode_patched_between_runs) {
+    static const u8 code[] = {0x3C, 0x76}; // INC A; HALT
+    GameBoy         gb;
+    setup_wram_program(&gb, code, sizeof(code));
+    gb.cpu.regs.a = 0;
+
+    cpu_run(&gb.cpu, 100);
+    ck_assert_uint_eq(gb.cpu.regs.a, 1);
+
+    // Patch INC A into DEC A and rerun the cached code
+    mmu_write(&gb, 0xC000, 0x3D);
+    gb.cpu.pc     = 0xC000;
+    gb.cpu.halted = false;
+
+    cpu_run(&gb.cpu, 100);
+    ck_assert_uint_eq(gb.cpu.regs.a, 0);
+}
+END_TEST
+
+START_TEST(test_decode_vram_code) {
+    GameBoy gb;
+    init_cpu_only(&gb);
+
+    // INC A; HALT in tile data, which isn't trapped
+    mmu_write(&gb, 0x8000, 0x3C);
+    mmu_write(&gb, 0x8001, 0x76);
+    gb.cpu.pc     = 0x8000;
+    gb.cpu.regs.a = 0;
+
+    cpu_run(&gb.cpu, 100);
+    ck_assert_uint_eq(gb.cpu.regs.a, 1);
+
+    // INC A -> NOP (a different handler, so a stale block would show)
+    mmu_write(&gb, 0x8000, 0x00);
+    gb.cpu.pc     = 0x8000;
+    gb.cpu.halted = false;
+
+    cpu_run(&gb.cpu, 100);
+    ck_assert_uint_eq(gb.cpu.regs.a, 1);
+}
+END_TEST
+
+START_TEST(test_decode_rom_swap) {
+    GameBoy gb;
+    init_cpu_only(&gb);
+
+    u8 *rom_a = calloc(1, 0x8000);
+    u8 *rom_b = calloc(1, 0x8000);
+    rom_a[0x4000] = 0x3C; // INC A
+    rom_a[0x4001] = 0x76; // HALT
+    rom_b[0x4000] = 0x3D; // DEC A
+    rom_b[0x4001] = 0x76; // HALT
+
+    gb.cart.rom      = rom_a;
+    gb.cart.rom_size = 0x8000;
+    mmu_map_update(&gb);
+    gb.cpu.pc     = 0x4000;
+    gb.cpu.regs.a = 0x10;
+    cpu_run(&gb.cpu, 100);
+    ck_assert_uint_eq(gb.cpu.regs.a, 0x11);
+
+    // Different bank contents behind the same PC
+    gb.cart.rom = rom_b;
+    mmu_map_update(&gb);
+    gb.cpu.pc     = 0x4000;
+    gb.cpu.halted = false;
+    cpu_run(&gb.cpu, 100);
+    ck_assert_uint_eq(gb.cpu.regs.a, 0x10);
+
+    free(rom_a);
+    free(rom_b);
+}
+END_TEST
+
+START_TEST(test_decode_bank_switch_in_block) {
+    // Bank 1: LD A, 2; LD (0x2000), A; INC B; HALT
+    // Bank 2: DEC B; HALT past the switch, where execution continues
+    static const u8 bank1[] = {0x3E, 0x02, 0xEA, 0x00, 0x20, 0x04, 0x76};
+    static GameBoy  ref, run;
+    u8             *rom = calloc(1, 4 * MBC_ROM_BANK_SIZE);
+    memcpy(rom + MBC_ROM_BANK_SIZE, bank1, sizeof(bank1));
+    rom[2 * MBC_ROM_BANK_SIZE + 5] = 0x05;
+    rom[2 * MBC_ROM_BANK_SIZE + 6] = 0x76;
+
+    GameBoy *gbs[] = {&ref, &run};
+    for (int i = 0; i < 2; i++) {
+        init_cpu_only(gbs[i]);
+        gbs[i]->cart.rom              = rom;
+        gbs[i]->cart.rom_size         = 4 * MBC_ROM_BANK_SIZE;
+        gbs[i]->cart.header.cart_type = 0x01; // MBC1
+        mbc_init(gbs[i]);
+        mmu_map_update(gbs[i]);
+        gbs[i]->cpu.pc     = 0x4000;
+        gbs[i]->cpu.regs.b = 0;
+    }
+
+    while (!ref.cpu.halted)
+        cpu_step(&ref.cpu);
+    cpu_run(&run.cpu, 1000);
+
+    // The block from bank 1 must stop after the switch instead of running its INC B
+    ck_assert(run.cpu.halted);
+    ck_assert_uint_eq(ref.cpu.regs.b, 0xFF);
+    ck_assert_uint_eq(run.cpu.regs.b, ref.cpu.regs.b);
+    ck_assert_uint_eq(run.cpu.pc, ref.cpu.pc);
+
+    free(rom);
+}
+END_TEST
+
+// ============================================================================
+// Lazy Flags Tests
+// ============================================================================
+
+// Flags of x + y + carry / x - y - carry, computed directly
+static u8 ref_add_flags(u8 x, u8 y, u8 carry) {
+    return ((u8)(x + y + carry) ? 0 : FLAG_ZERO) |
+           ((x & 0x0F) + (y & 0x0F) + carry > 0x0F ? FLAG_HF_CARRY : 0) |
+           (x + y + carry > 0xFF ? FLAG_CARRY : 0);
+}
+
+static u8 ref_sub_flags(u8 x, u8 y, u8 carry) {
+    return FLAG_SUBT | ((u8)(x - y - carry) ? 0 : FLAG_ZERO) |
+           ((x & 0x0F) < (y & 0x0F) + carry ? FLAG_HF_CARRY : 0) |
+           (x < y + carry ? FLAG_CARRY : 0);
+}
+
+START_TEST(test_lazy_flags_arith) {
+    // ADD, ADC, SUB, SBC, CP A, B
+    static const u8 ops[] = {0x80, 0x88, 0x90, 0x98, 0xB8};
+    GameBoy         gb;
+    init_cpu_only(&gb);
+
+    for (size_t i = 0; i < sizeof(ops); i++) {
+        for (int x = 0; x < 256; x++) {
+            for (int y = 0; y < 256; y++) {
+                u8 flags      = (x ^ y) & 1 ? FLAG_CARRY : 0;
+                u8 carry      = (ops[i] & 0x08) && flags && ops[i] != 0xB8 ? 1 : 0;
+                u8 want       = ops[i] < 0x90 ? ref_add_flags(x, y, carry)
+                                              : ref_sub_flags(x, y, carry);
+
+                gb.cpu.regs.a = x;
+                gb.cpu.regs.b = y;
+                gb.cpu.regs.f = flags;
+                cpu_execute(&gb.cpu, ops[i]);
+
+                ck_assert_msg(gb.cpu.regs.f == want, "op 0x%02X, 0x%02X, 0x%02X: F 0x%02X", ops[i],
+                              x, y, gb.cpu.regs.f);
+            }
+        }
+    }
+}
+END_TEST
+
+START_TEST(test_lazy_flags_inc_dec) {
+    GameBoy gb;
+    init_cpu_only(&gb);
+
+    for (int x = 0; x < 256; x++) {
+        for (u8 carry = 0; carry <= FLAG_CARRY; carry += FLAG_CARRY) {
+            gb.cpu.regs.b = x;
+            gb.cpu.regs.f = carry;
+            cpu_execute(&gb.cpu, 0x04); // INC B
+            ck_assert_uint_eq(gb.cpu.regs.f, ((u8)(x + 1) ? 0 : FLAG_ZERO) |
+                                                 ((x & 0x0F) == 0x0F ? FLAG_HF_CARRY : 0) | carry);
+
+            gb.cpu.regs.b = x;
+            gb.cpu.regs.f = carry;
+            cpu_execute(&gb.cpu, 0x05); // DEC B
+            ck_assert_uint_eq(gb.cpu.regs.f, FLAG_SUBT | ((u8)(x - 1) ? 0 : FLAG_ZERO) |
+                                                 ((x & 0x0F) == 0x00 ? FLAG_HF_CARRY : 0) | carry);
+        }
+    }
+}
+END_TEST
+
+START_TEST(test_lazy_flags_readers) {
+    // Flags read while still deferred, inside one cached block
+    static const u8 code[] = {
+        0x3E, 0x0F, // LD A, $0F
+        0xC6, 0x01, // ADD A, $01   ; A = $10, H
+        0xF5,       // PUSH AF
+        0xD6, 0x11, // SUB $11      ; A = $FF, N H C
+        0x38, 0x01, // JR C, +1
+        0x04,       // INC B        ; skipped
+        0x3C,       // INC A        ; A = $00, Z H, C kept
+        0xCE, 0x0F, // ADC A, $0F   ; A = $10, H
+        0xF5,       // PUSH AF
+        0x76,       // HALT
+    };
+    GameBoy gb;
+    setup_wram_program(&gb, code, sizeof(code));
+    gb.cpu.sp     = 0xDFF0;
+    gb.cpu.regs.b = 0x00;
+
+    cpu_run(&gb.cpu, 1000);
+
+    ck_assert(gb.cpu.halted);
+    ck_assert_uint_eq(gb.cpu.regs.b, 0x00);
+    ck_assert_uint_eq(cpu_read_af(&gb.cpu), 0x1020);
+    ck_assert_uint_eq(gb.cpu.regs.f, FLAG_HF_CARRY);
+    ck_assert_uint_eq(mmu_read(&gb, 0xDFEE), FLAG_HF_CARRY); // First PUSH AF
+    ck_assert_uint_eq(mmu_read(&gb, 0xDFEC), FLAG_HF_CARRY); // Second
+}
+END_TEST
+
+// ============================================================================
+// Register File Tests
+// ============================================================================
+
+START_TEST(test_register_pairs) {
+    CPU cpu;
+    memset(&cpu, 0, sizeof(cpu));
+
+    cpu.regs.hl = 0xC0DE;
+    ck_assert_uint_eq(cpu.regs.h, 0xC0);
+    ck_assert_uint_eq(cpu.regs.l, 0xDE);
+
+    cpu.regs.b = 0x12;
+    cpu.regs.c = 0x34;
+    ck_assert_uint_eq(cpu.regs.bc, 0x1234);
+    ck_assert_uint_eq(cpu_read_bc(&cpu), 0x1234);
+
+    cpu_write_de(&cpu, 0xBEEF);
+    ck_assert_uint_eq(cpu.regs.d, 0xBE);
+    ck_assert_uint_eq(cpu.regs.e, 0xEF);
+}
+END_TEST
+
+START_TEST(test_register_pair_ops) {
+    static const u8 code[] = {
+        0x01, 0xFF, 0x00, // LD BC, $00FF
+        0x03,             // INC BC        ; carries into B
+        0x21, 0x00, 0xD0, // LD HL, $D000
+        0x3E, 0x5A,       // LD A, $5A
+        0x32,             // LD (HL-), A   ; HL = $CFFF
+        0x22,             // LD (HL+), A   ; HL = $D000
+        0x2B,             // DEC HL
+        0xC5,             // PUSH BC       ; SP crosses a page
+        0xD1,             // POP DE
+        0xE5,             // PUSH HL
+        0xF1,             // POP AF        ; low F bits dropped
+        0x76,             // HALT
+    };
+    GameBoy gb;
+    setup_wram_program(&gb, code, sizeof(code));
+    gb.cpu.sp = 0xD101;
+
+    cpu_run(&gb.cpu, 1000);
+
+    ck_assert(gb.cpu.halted);
+    ck_assert_uint_eq(gb.cpu.regs.bc, 0x0100);
+    ck_assert_uint_eq(gb.cpu.regs.hl, 0xCFFF);
+    ck_assert_uint_eq(gb.cpu.regs.de, 0x0100);
+    ck_assert_uint_eq(cpu_read_af(&gb.cpu), 0xCFF0);
+    ck_assert_uint_eq(gb.cpu.sp, 0xD101);
+    ck_assert_uint_eq(mmu_read(&gb, 0xCFFF), 0x5A);
+    ck_assert_uint_eq(mmu_read(&gb, 0xD000), 0x5A);
+    ck_assert_uint_eq(mmu_read(&gb, 0xD100), 0xCF); // PUSH HL, high byte first
+    ck_assert_uint_eq(mmu_read(&gb, 0xD0FF), 0xFF);
+}
+END_TEST
+
+// ============================================================================
+// Interrupt Tests
+// ============================================================================
+
+START_TEST(test_interrupt_dispatch) {
+    GameBoy gb;
+    init_cpu_only(&gb);
+    gb.cpu.pc  = 0xC123;
+    gb.cpu.sp  = 0xDFF0;
+    gb.cpu.ime = true;
+    mmu_write(&gb, 0xFFFF, INT_VBLANK | INT_TIMER);
+
+    // Not requested yet, then both at once: VBlank first
+    ck_assert(!cpu_interrupt_pending(&gb.cpu));
+    gb_request_interrupt(&gb, INT_TIMER | INT_VBLANK);
+    ck_assert(cpu_interrupt_pending(&gb.cpu));
+
+    ck_assert_uint_eq(cpu_step(&gb.cpu), INT_DISPATCH_CYCLES);
+    ck_assert_uint_eq(gb.cpu.pc, 0x0040);
+    ck_assert_uint_eq(gb.cpu.sp, 0xDFEE);
+    ck_assert_uint_eq(mmu_read16(&gb, 0xDFEE), 0xC123);
+    ck_assert_uint_eq(gb.if_register, INT_TIMER);
+    ck_assert(!gb.cpu.ime);
+
+    // IME off: Timer stays requested
+    ck_assert(!cpu_interrupt_pending(&gb.cpu));
+
+    // DI/EI/RETI aside, IME set directly needs a refresh
+    gb.cpu.ime = true;
+    cpu_update_interrupts(&gb.cpu);
+    cpu_step(&gb.cpu);
+    ck_assert_uint_eq(gb.cpu.pc, 0x0050);
+    ck_assert_uint_eq(gb.if_register, 0);
+}
+END_TEST
+
+START_TEST(test_interrupt_handler_roundtrip) {
+    // EI; NOP; LD A, INT_TIMER; LDH (IF), A; INC C; HALT
+    static const u8 code[] = {0xFB, 0x00, 0x3E, INT_TIMER, 0xE0, 0x0F, 0x0C, 0x76};
+    GameBoy         gb;
+    setup_wram_program(&gb, code, sizeof(code));
+
+    // Timer handler: INC B; RETI
+    u8 *rom          = calloc(1, 0x8000);
+    rom[0x0050]      = 0x04;
+    rom[0x0051]      = 0xD9;
+    gb.cart.rom      = rom;
+    gb.cart.rom_size = 0x8000;
+    mmu_map_update(&gb);
+
+    gb.cpu.sp     = 0xDFF0;
+    gb.cpu.regs.b = 0;
+    gb.cpu.regs.c = 0;
+    mmu_write(&gb, 0xFFFF, INT_TIMER);
+
+    // Dispatched right after the write to IF, in the middle of a block
+    cpu_run(&gb.cpu, 1000);
+
+    ck_assert(gb.cpu.halted);
+    ck_assert(gb.cpu.ime);
+    ck_assert_uint_eq(gb.cpu.regs.b, 1);
+    ck_assert_uint_eq(gb.cpu.regs.c, 1);
+    ck_assert_uint_eq(gb.cpu.sp, 0xDFF0);
+    ck_assert_uint_eq(gb.if_register, 0);
+    ck_assert_uint_eq(gb.cycles, 4 + 4 + 8 + 12 + INT_DISPATCH_CYCLES + 4 + 16 + 4 + 4);
+
+    free(rom);
+}
+END_TEST
+
+START_TEST(test_interrupt_ei_delay) {
+    // EI; INC A; INC A: the first INC A runs before the dispatch
+    static const u8 code[] = {0xFB, 0x3C, 0x3C, 0x76};
+    GameBoy         gb;
+    setup_wram_program(&gb, code, sizeof(code));
+    gb.cpu.sp     = 0xDFF0;
+    gb.cpu.regs.a = 0;
+    mmu_write(&gb, 0xFFFF, INT_VBLANK);
+    gb_request_interrupt(&gb, INT_VBLANK);
+
+    cpu_run(&gb.cpu, 4 + 4 + INT_DISPATCH_CYCLES);
+
+    ck_assert_uint_eq(gb.cpu.regs.a, 1);
+    ck_assert_uint_eq(gb.cpu.pc, 0x0040);
+    ck_assert_uint_eq(mmu_read16(&gb, 0xDFEE), 0xC002);
+}
+END_TEST
+
+START_TEST(test_interrupt_ends_halt) {
+    // EI; HALT; INC A
+    static const u8 code[] = {0xFB, 0x76, 0x3C};
+    GameBoy         gb;
+    setup_wram_program(&gb, code, sizeof(code));
+    gb.cpu.sp = 0xDFF0;
+    mmu_write(&gb, 0xFFFF, INT_STAT);
+
+    cpu_run(&gb.cpu, 100);
+    ck_assert(gb.cpu.halted);
+
+    // Wake-up and dispatch, the return address is past the HALT
+    gb_request_interrupt(&gb, INT_STAT);
+    ck_assert_uint_eq(cpu_step(&gb.cpu), 4 + INT_DISPATCH_CYCLES);
+    ck_assert(!gb.cpu.halted);
+    ck_assert_uint_eq(gb.cpu.pc, 0x0048);
+    ck_assert_uint_eq(mmu_read16(&gb, 0xDFEE), 0xC002);
+}
+END_TEST
+
+// ============================================================================
+// Idle Fast-Forward Tests
+// ============================================================================
+
+// LDH A, (0x44); CP 0x90; JR NZ, -6: wait for LY to reach 144
+static const u8 ly_wait_loop[] = {0xF0, 0x44, 0xFE, 0x90, 0x20, 0xFA};
+
+START_TEST(test_idle_loop_detection) {
+    GameBoy gb;
+    setup_wram_program(&gb, ly_wait_loop, sizeof(ly_wait_loop));
+    ck_assert(cpu_is_idle_loop(&gb.cpu, 0xC000));
+
+    // AND n8 / JR Z is accepted as well
+    gb.wram[2] = 0xE6;
+    gb.wram[4] = 0x28;
+    ck_assert(cpu_is_idle_loop(&gb.cpu, 0xC000));
+
+    // DIV changes on its own
+    gb.wram[1] = 0x04;
+    ck_assert(!cpu_is_idle_loop(&gb.cpu, 0xC000));
+
+    // The jump must land back on the LDH
+    gb.wram[1] = 0x44;
+    gb.wram[5] = 0xF9;
+    ck_assert(!cpu_is_idle_loop(&gb.cpu, 0xC000));
+}
+END_TEST
+
+START_TEST(test_idle_loop_skip_matches_step) {
+    static GameBoy ref, run;
+    setup_wram_program(&ref, ly_wait_loop, sizeof(ly_wait_loop));
+    setup_wram_program(&run, ly_wait_loop, sizeof(ly_wait_loop));
+
+    while (ref.cycles < 100003)
+        ref.cycles += cpu_step(&ref.cpu);
+    cpu_run(&run.cpu, 100003);
+
+    ck_assert_uint_eq(run.cycles, ref.cycles);
+    ck_assert(same_state(&ref, &run));
+}
+END_TEST
+
+START_TEST(test_halt_skip) {
+    GameBoy gb;
+    init_cpu_only(&gb);
+    gb.cpu.halted = true;
+
+    // Whole budget in one go, rounded up to 4-cycle steps
+    ck_assert_uint_eq(cpu_run(&gb.cpu, 1001), 1004);
+    ck_assert(gb.cpu.halted);
+    ck_assert_uint_eq(cpu_halt_skip(10, 10), 0);
+}
+END_TEST
+
+START_TEST(test_halt_wakes_on_interrupt) {
+    static const u8 code[] = {0x3C, 0x76}; // INC A; HALT
+    GameBoy         gb;
+    setup_wram_program(&gb, code, sizeof(code));
+    gb.cpu.regs.a = 0;
+    mmu_write(&gb, 0xFFFF, INT_TIMER);
+
+    cpu_run(&gb.cpu, 100);
+    ck_assert(gb.cpu.halted);
+
+    // Requested but not enabled: stays halted
+    mmu_write(&gb, 0xFF0F, INT_VBLANK);
+    cpu_run(&gb.cpu, 100);
+    ck_assert(gb.cpu.halted);
+
+    // Enabled and requested: HALT ends even with IME off
+    mmu_write(&gb, 0xFF0F, INT_TIMER);
+    gb.cpu.pc = 0xC000;
+    cpu_run(&gb.cpu, 8);
+    ck_assert(!gb.cpu.halted);
+    ck_assert_uint_eq(gb.cpu.regs.a, 2);
+}
+END_TEST
+
+// ============================================================================
+// Test Suite Setup
+// ============================================================================
+
+Suite *cpu_suite(void) {
+    Suite *s;
+    TCase *tc_cycles, *tc_cb, *tc_frame, *tc_run, *tc_batch, *tc_decode, *tc_lazy, *tc_regs;
+    TCase *tc_irq, *tc_idle;
+
+    s         = suite_create("CPU");
+
+    // Cycle accounting
+    tc_cycles = tcase_create("Cycle Accounting");
+    tcase_add_test(tc_cycles, test_cycles_unconditional);
+    tcase_add_test(tc_cycles, test_cycles_branch_taken);
+    tcase_add_test(tc_cycles, test_cycles_branch_not_taken);
+    suite_add_tcase(s, tc_cycles);
+
+    // CB-prefixed instructions
+    tc_cb = tcase_create("CB Prefix");
+    tcase_add_test(tc_cb, test_cb_cycles);
+    tcase_add_test(tc_cb, test_cb_results);
+    suite_add_tcase(s, tc_cb);
+
+    // Frame timing
+    tc_frame = tcase_create("Frame Timing");
+    tcase_add_test(tc_frame, test_run_frame_bounded);
+    tcase_add_test(tc_frame, test_run_frame_halted);
+    suite_add_tcase(s, tc_frame);
+
+    // Batched run loop
+    tc_run = tcase_create("Run Loop");
+    tcase_add_test(tc_run, test_run_matches_step);
+    tcase_add_test(tc_run, test_run_long_budget);
+    tcase_add_test(tc_run, test_run_zero_budget);
+    tcase_add_test(tc_run, test_run_ei_delay);
+    suite_add_tcase(s, tc_run);
+
+    // gb_run_cycles
+    tc_batch = tcase_create("Batched Execution");
+    tcase_add_test(tc_batch, test_run_cycles_budget);
+    tcase_add_test(tc_batch, test_run_cycles_frame_end);
+    tcase_add_test(tc_batch, test_run_cycles_halt);
+    tcase_add_test(tc_batch, test_run_cycles_breakpoint);
+    tcase_add_test(tc_batch, test_run_frame_halt_on_boundary);
+    tcase_add_test(tc_batch, test_run_frame_breakpoint_on_boundary);
+    tcase_add_test(tc_batch, test_run_cycles_not_running);
+    tcase_add_test(tc_batch, test_breakpoint_slots);
+    suite_add_tcase(s, tc_batch);
+
+    // Basic-block cache
+    tc_decode = tcase_create("Decode Cache");
+    tcase_add_test(tc_decode, test_decode_block_shape);
+    tcase_add_test(tc_decode, test_decode_traps_code_page);
+    tcase_add_test(tc_decode, test_decode_self_modifying_block);
+    tcase_add_test(tc_decode, test_decode_patched_between_runs);
+    tcase_add_test(tc_decode, test_decode_vram_code);
+    tcase_add_test(tc_decode, test_decode_rom_swap);
+    tcase_add_test(tc_decode, test_decode_bank_switch_in_block);
+    suite_add_tcase(s, tc_decode);
+
+    // Deferred flag computation
+    tc_lazy = tcase_create("Lazy Flags");
+    tcase_add_test(tc_lazy, test_lazy_flags_arith);
+    tcase_add_test(tc_lazy, test_lazy_flags_inc_dec);
+    tcase_add_test(tc_lazy, test_lazy_flags_readers);
+    suite_add_tcase(s, tc_lazy);
+
+    // Register pairs
+    tc_regs = tcase_create("Register File");
+    tcase_add_test(tc_regs, test_register_pairs);
+    tcase_add_test(tc_regs, test_register_pair_ops);
+    suite_add_tcase(s, tc_regs);
+
+    // Interrupt dispatch
+    tc_irq = tcase_create("Interrupts");
+    tcase_add_test(tc_irq, test_interrupt_dispatch);
+    tcase_add_test(tc_irq, test_interrupt_handler_roundtrip);
+    tcase_add_test(tc_irq, test_interrupt_ei_delay);
+    tcase_add_test(tc_irq, test_interrupt_ends_halt);
+    suite_add_tcase(s, tc_irq);
+
+    // HALT and polling loop fast-forward
+    tc_idle = tcase_create("Idle Fast-Forward");
+    tcase_add_test(tc_idle, test_idle_loop_detection);
+    tcase_add_test(tc_idle, test_idle_loop_skip_matches_step);
+    tcase_add_test(tc_idle, test_halt_skip);
+    tcase_add_test(tc_idle, test_halt_wakes_on_interrupt);
+    suite_add_tcase(s, tc_idle);
+
+    return s;
+}
+
+int main(void) {
+    int      number_failed;
+    Suite   *s;
+    SRunner *sr;
+
+    s  = cpu_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_NORMAL);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (number_failed == 0) ? 0 : 1;
+}
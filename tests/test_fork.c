@@ -0,0 +1,301 @@
+// tests/test_fork.c
+#include <check.h>
+#include <gbemu.h>
+#include <core/bus.h>
+#include <core/fork.h>
+#include <core/savestate.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "test_machine.h"
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Writes a counter across every WRAM and cart RAM page in turn, so forks copy pages in as they go
+static void setup(GameBoy *gb) {
+    static const u8 program[] = {
+        0x3E, 0x0A,       // LD A, $0A
+        0xEA, 0x00, 0x00, // LD ($0000), A  ; cart RAM on
+        0x11, 0x00, 0xA0, // LD DE, $A000
+        0x04,             // loop: INC B
+        0x70,             // LD (HL), B
+        0x78,             // LD A, B
+        0x12,             // LD (DE), A
+        0x2C,             // INC L
+        0x24,             // INC H
+        0x7C,             // LD A, H
+        0xE6, 0x1F,       // AND $1F
+        0xF6, 0xC0,       // OR $C0         ; next WRAM page
+        0x67,             // LD H, A
+        0x1C,             // INC E
+        0x14,             // INC D
+        0x7A,             // LD A, D
+        0xE6, 0x1F,       // AND $1F
+        0xF6, 0xA0,       // OR $A0         ; next cart RAM page
+        0x57,             // LD D, A
+        0x18, 0xEA,       // JR loop
+    };
+    machine_setup(gb, program, sizeof(program));
+}
+
+// ============================================================================
+// Copy-on-write Tests
+// ============================================================================
+
+START_TEST(test_fork_shares_until_written) {
+    GameBoy gb;
+    setup(&gb);
+    mmu_write(&gb, 0xC010, 0x11);
+    mmu_write(&gb, 0xD000, 0x22);
+
+    GameBoy *fork = gb_fork(&gb);
+    ck_assert_ptr_nonnull(fork);
+    ck_assert_ptr_eq(fork->cpu.gb, fork);
+    ck_assert_ptr_eq(fork->cart.rom, gb.cart.rom);
+    ck_assert(fork->cart.rom_borrowed);
+
+    // Read from the snapshot, written through the slow path
+    ck_assert_ptr_ne(fork->read_map[0xC0], fork->wram);
+    ck_assert_ptr_null(fork->write_map[0xC0]);
+    ck_assert_uint_eq(mmu_read(fork, 0xC010), 0x11);
+    ck_assert_uint_eq(mmu_read(fork, 0xF000), 0x22); // Echo
+
+    // First write copies the page in, echo included, the rest of the page comes along
+    mmu_write(fork, 0xC011, 0x33);
+    ck_assert_ptr_eq(fork->read_map[0xC0], fork->wram);
+    ck_assert_ptr_eq(fork->write_map[0xE0], fork->wram);
+    ck_assert_uint_eq(mmu_read(fork, 0xC010), 0x11);
+    ck_assert_uint_eq(mmu_read(fork, 0xE011), 0x33);
+    ck_assert_ptr_null(fork->write_map[0xD0]);
+
+    // Neither side sees the other's writes
+    ck_assert_uint_eq(mmu_read(&gb, 0xC011), 0x00);
+    mmu_write(&gb, 0xD000, 0x44);
+    ck_assert_uint_eq(mmu_read(fork, 0xD000), 0x22);
+
+    gb_fork_free(fork);
+    machine_teardown(&gb);
+}
+END_TEST
+
+START_TEST(test_fork_cart_ram) {
+    GameBoy gb;
+    setup(&gb);
+    mmu_write(&gb, 0x0000, 0x0A); // RAM on
+    mmu_write(&gb, 0xA123, 0x55);
+
+    GameBoy *fork = gb_fork(&gb);
+    ck_assert_ptr_nonnull(fork);
+    ck_assert_ptr_ne(fork->cart.ram, gb.cart.ram);
+    ck_assert_uint_eq(mmu_read(fork, 0xA123), 0x55);
+
+    mmu_write(fork, 0xA123, 0x66);
+    ck_assert_uint_eq(mmu_read(fork, 0xA123), 0x66);
+    ck_assert_uint_eq(gb.cart.ram[0x123], 0x55);
+
+    // Disabling and enabling RAM rebuilds the page table, shared pages stay shared
+    mmu_write(fork, 0x0000, 0x00);
+    ck_assert_uint_eq(mmu_read(fork, 0xA123), 0xFF);
+    mmu_write(fork, 0x0000, 0x0A);
+    ck_assert_uint_eq(mmu_read(fork, 0xA123), 0x66);
+    ck_assert_ptr_null(fork->write_map[0xA5]);
+
+    // The source's .sav flush isn't inherited
+    ck_assert(!sched_is_pending(&fork->sched, SCHED_SAVE));
+
+    gb_fork_free(fork);
+    machine_teardown(&gb);
+}
+END_TEST
+
+START_TEST(test_fork_of_fork) {
+    GameBoy gb;
+    setup(&gb);
+    mmu_write(&gb, 0xC000, 0x01);
+    mmu_write(&gb, 0xC100, 0x02);
+
+    GameBoy *child = gb_fork(&gb);
+    mmu_write(child, 0xC100, 0x03);
+
+    // Shares the snapshot, copies what the child already wrote
+    GameBoy *grandchild = gb_fork(child);
+    ck_assert_ptr_eq(grandchild->fork_base, child->fork_base);
+    ck_assert_ptr_ne(grandchild->read_map[0xC0], child->wram);
+    ck_assert_ptr_eq(grandchild->read_map[0xC1], grandchild->wram + 0x100);
+
+    // Outlives the child
+    gb_fork_free(child);
+    ck_assert_uint_eq(mmu_read(grandchild, 0xC000), 0x01);
+    ck_assert_uint_eq(mmu_read(grandchild, 0xC100), 0x03);
+
+    gb_fork_free(grandchild);
+    machine_teardown(&gb);
+}
+END_TEST
+
+// ============================================================================
+// Execution Tests
+// ============================================================================
+
+START_TEST(test_fork_runs_like_source) {
+    GameBoy gb;
+    setup(&gb);
+    gb_run_cycles(&gb, 10000);
+
+    GameBoy *fork = gb_fork(&gb);
+    ck_assert_ptr_nonnull(fork);
+
+    // Same path from the same state, while the source moves on
+    gb_run_cycles(&gb, 30000);
+    gb_run_cycles(fork, 30000);
+    ck_assert_uint_eq(fork->cycles, gb.cycles);
+
+    // Every page was written to, so copied in
+    for (int page = 0; page < 0x20; page++) {
+        ck_assert_ptr_eq(fork->read_map[0xC0 + page], fork->wram + page * MMU_PAGE_SIZE);
+        ck_assert_ptr_eq(fork->read_map[0xA0 + page], fork->cart.ram + page * MMU_PAGE_SIZE);
+    }
+    ck_assert_ptr_nonnull(fork->fork_base);
+
+    size_t size  = gb_state_size(&gb);
+    u8    *state = machine_save(&gb, NULL);
+    u8    *other = machine_save(fork, NULL);
+    ck_assert_mem_eq(state, other, size);
+
+    // Saving needed WRAM and cart RAM of its own
+    ck_assert_ptr_null(fork->fork_base);
+    ck_assert_ptr_eq(fork->read_map[0xC0], fork->wram);
+
+    free(state);
+    free(other);
+    gb_fork_free(fork);
+    machine_teardown(&gb);
+}
+END_TEST
+
+START_TEST(test_fork_self_modifying_code) {
+    // LD HL, $C006; LD (HL), $3C; NOP; NOP; JR -2
+    // Patches the second NOP of its own block into INC A, in a page the fork still shares
+    static const u8 code[] = {0x21, 0x06, 0xC0, 0x36, 0x3C, 0x00, 0x00, 0x18, 0xFE};
+    GameBoy         gb;
+    setup(&gb);
+    mmu_write(&gb, 0xFF40, 0x00); // LCD off, no PPU events
+    for (u16 i = 0; i < sizeof(code); i++)
+        mmu_write(&gb, (u16)(0xC000 + i), code[i]);
+    gb.cpu.pc     = 0xC000;
+    gb.cpu.regs.a = 0x01;
+
+    GameBoy *fork = gb_fork(&gb);
+    ck_assert_ptr_nonnull(fork);
+
+    cpu_run(&gb.cpu, 200);
+    cpu_run(&fork->cpu, 200);
+
+    ck_assert_uint_eq(gb.cpu.regs.a, 0x02);
+    ck_assert_uint_eq(fork->cpu.regs.a, gb.cpu.regs.a);
+    ck_assert_uint_eq(fork->cycles, gb.cycles);
+
+    gb_fork_free(fork);
+    machine_teardown(&gb);
+}
+END_TEST
+
+START_TEST(test_fork_load_state) {
+    GameBoy gb;
+    setup(&gb);
+    gb_run_cycles(&gb, 5000);
+    u8 *state = machine_save(&gb, NULL);
+    gb_run_cycles(&gb, 5000);
+
+    GameBoy *fork = gb_fork(&gb);
+    ck_assert(gb_load_state(fork, state, gb_state_size(&gb)));
+    ck_assert_ptr_null(fork->fork_base);
+
+    // Restored memory, not the snapshot's
+    gb_load_state(&gb, state, gb_state_size(&gb));
+    ck_assert_mem_eq(fork->wram, gb.wram, sizeof(gb.wram));
+
+    free(state);
+    gb_fork_free(fork);
+    machine_teardown(&gb);
+}
+END_TEST
+
+START_TEST(test_fork_shared_image) {
+    static u8 rom[0x8000];
+    char      path[]   = "/tmp/baredmg_forkXXXXXX";
+    u8        checksum = 0;
+
+    memcpy(&rom[0x0134], "FORKTEST", 8);
+    rom[0x0100] = 0x18; // JR -2
+    rom[0x0101] = 0xFE;
+    for (u16 addr = 0x0134; addr <= 0x014C; addr++)
+        checksum = checksum - rom[addr] - 1;
+    rom[0x014D] = checksum;
+
+    int fd      = mkstemp(path);
+    ck_assert_int_ge(fd, 0);
+    ck_assert_int_eq(write(fd, rom, sizeof(rom)), (int)sizeof(rom));
+    close(fd);
+
+    GameBoy gb;
+    gb_init(&gb);
+    gb_load_rom(&gb, path);
+    remove(path);
+    ck_assert(gb.running);
+
+    // Holds its own reference: the image survives the source unloading
+    GameBoy *fork = gb_fork(&gb);
+    ck_assert(!fork->cart.rom_borrowed);
+    cart_unload(&gb.cart);
+    ck_assert_uint_eq(cart_shared_images(), 1);
+    ck_assert_uint_eq(mmu_read(fork, 0x0101), 0xFE);
+
+    gb_fork_free(fork);
+    ck_assert_uint_eq(cart_shared_images(), 0);
+}
+END_TEST
+
+// ============================================================================
+// Test Suite Setup
+// ============================================================================
+
+Suite *fork_suite(void) {
+    Suite *s;
+    TCase *tc_cow, *tc_exec;
+
+    s      = suite_create("Fork");
+
+    tc_cow = tcase_create("Copy-on-write");
+    tcase_add_test(tc_cow, test_fork_shares_until_written);
+    tcase_add_test(tc_cow, test_fork_cart_ram);
+    tcase_add_test(tc_cow, test_fork_of_fork);
+    suite_add_tcase(s, tc_cow);
+
+    tc_exec = tcase_create("Execution");
+    tcase_add_test(tc_exec, test_fork_runs_like_source);
+    tcase_add_test(tc_exec, test_fork_self_modifying_code);
+    tcase_add_test(tc_exec, test_fork_load_state);
+    tcase_add_test(tc_exec, test_fork_shared_image);
+    suite_add_tcase(s, tc_exec);
+
+    return s;
+}
+
+int main(void) {
+    int      number_failed;
+    Suite   *s;
+    SRunner *sr;
+
+    s  = fork_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_NORMAL);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (number_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,275 @@
+// tests/test_lockstep.c
+#include <check.h>
+#include <gbemu.h>
+#include <core/bus.h>
+#include <core/lockstep.h>
+#include <core/savestate.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LANES 8
+#define FRAMES 20
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Loops over a routine it copied to WRAM, then HALTs until the timer fires and polls LY
+// B and C set how long each lane loops, so lanes drift apart
+static const u8 program[] = {
+    0x31, 0xF0, 0xDF, // LD SP, $DFF0
+    0x21, 0x00, 0xC0, // LD HL, $C000
+    0x36, 0x3C,       // LD (HL), $3C     ; INC A
+    0x23,             // INC HL
+    0x36, 0xC9,       // LD (HL), $C9     ; RET
+    0x3E, 0x05,       // LD A, $05
+    0xE0, 0x07,       // LDH ($07), A     ; TAC: on, 262144 Hz
+    0x3E, 0x04,       // LD A, $04
+    0xE0, 0xFF,       // LDH ($FF), A     ; IE: timer
+    0xCD, 0x00, 0xC0, // loop: CALL $C000
+    0x80,             // ADD A, B
+    0x07,             // RLCA
+    0x2F,             // CPL
+    0x0D,             // DEC C
+    0x20, 0xF7,       // JR NZ, loop
+    0x76,             // HALT
+    0xF5,             // PUSH AF
+    0xAF,             // XOR A
+    0xE0, 0x0F,       // LDH ($0F), A     ; acknowledge
+    0xF0, 0x44,       // LDH A, ($44)     ; wait for LY 0x90
+    0xFE, 0x90,       // CP $90
+    0x20, 0xFA,       // JR NZ, -6
+    0xF1,             // POP AF
+    0x48,             // LD C, B
+    0x04,             // INC B
+    0x18, 0xE7,       // JR loop
+};
+
+static u8 *make_rom(void) {
+    u8 *rom = calloc(1, 2 * MBC_ROM_BANK_SIZE);
+    memcpy(rom + 0x0100, program, sizeof(program));
+    return rom;
+}
+
+// Plain 32 KB cart on rom, which the caller owns
+static void setup(GameBoy *gb, u8 *rom, u8 seed) {
+    gb_init(gb);
+    gb->cart.rom      = rom;
+    gb->cart.rom_size = 2 * MBC_ROM_BANK_SIZE;
+
+    mbc_init(gb);
+    mmu_map_update(gb);
+    cpu_reset(&gb->cpu);
+    gb->cpu.regs.b = seed;
+    gb->cpu.regs.c = (u8)(seed * 7 + 1);
+    gb->running    = true;
+}
+
+static void assert_same_state(GameBoy *a, GameBoy *b) {
+    size_t size  = gb_state_size(a);
+    u8    *state = malloc(size);
+    u8    *other = malloc(size);
+
+    ck_assert_uint_eq(gb_save_state(a, state, size), size);
+    ck_assert_uint_eq(gb_save_state(b, other, size), size);
+    ck_assert_mem_eq(state, other, size);
+
+    free(state);
+    free(other);
+}
+
+// ============================================================================
+// Equivalence Tests
+// ============================================================================
+
+START_TEST(test_lockstep_matches_run_frame) {
+    static GameBoy lanes[LANES], reference[LANES];
+    GameBoy       *ptrs[LANES];
+    u8            *rom = make_rom();
+
+    for (int i = 0; i < LANES; i++) {
+        setup(&lanes[i], rom, (u8)i);
+        setup(&reference[i], rom, (u8)i);
+        ptrs[i] = &lanes[i];
+    }
+
+    static Lockstep ls;
+    ck_assert(lockstep_init(&ls, ptrs, LANES));
+
+    for (int frame = 0; frame < FRAMES; frame++) {
+        lockstep_run_frame(&ls);
+        for (int i = 0; i < LANES; i++) {
+            gb_run_frame(&reference[i]);
+            ck_assert_uint_eq(lanes[i].cycles, reference[i].cycles);
+        }
+    }
+
+    for (int i = 0; i < LANES; i++)
+        assert_same_state(&lanes[i], &reference[i]);
+
+    // Lanes drifted apart
+    ck_assert_uint_ne(lanes[0].cpu.regs.b, lanes[LANES - 1].cpu.regs.b);
+
+    lockstep_free(&ls);
+    free(rom);
+}
+END_TEST
+
+START_TEST(test_lockstep_separate_images) {
+    static GameBoy lanes[2], reference[2];
+    GameBoy       *ptrs[2] = {&lanes[0], &lanes[1]};
+    u8            *roms[2] = {make_rom(), make_rom()};
+
+    // Same code at two host addresses: nothing is shared, results don't change
+    for (int i = 0; i < 2; i++) {
+        setup(&lanes[i], roms[i], 3);
+        setup(&reference[i], roms[i], 3);
+    }
+
+    static Lockstep ls;
+    ck_assert(lockstep_init(&ls, ptrs, 2));
+    for (int frame = 0; frame < FRAMES; frame++) {
+        lockstep_run_frame(&ls);
+        gb_run_frame(&reference[0]);
+        gb_run_frame(&reference[1]);
+    }
+
+    assert_same_state(&lanes[0], &reference[0]);
+    assert_same_state(&lanes[1], &reference[1]);
+
+    lockstep_free(&ls);
+    free(roms[0]);
+    free(roms[1]);
+}
+END_TEST
+
+START_TEST(test_lockstep_stopped_lane) {
+    static GameBoy lanes[2];
+    GameBoy       *ptrs[2] = {&lanes[0], &lanes[1]};
+    u8            *rom     = make_rom();
+
+    setup(&lanes[0], rom, 1);
+    setup(&lanes[1], rom, 1);
+    lanes[1].running = false;
+
+    static Lockstep ls;
+    ck_assert(lockstep_init(&ls, ptrs, 2));
+    lockstep_run_frame(&ls);
+
+    ck_assert_uint_eq(lanes[0].cycles, GB_FRAME_CYCLES);
+    ck_assert_uint_eq(lanes[1].cycles, 0);
+
+    lockstep_free(&ls);
+    free(rom);
+}
+END_TEST
+
+START_TEST(test_lockstep_breakpoints) {
+    static GameBoy lanes[2], reference[2];
+    GameBoy       *ptrs[2] = {&lanes[0], &lanes[1]};
+    u8            *rom     = make_rom();
+
+    // Stops at a breakpoint only pause gb_run_frame, lanes must go on the same way
+    for (int i = 0; i < 2; i++) {
+        setup(&lanes[i], rom, (u8)(i + 2));
+        setup(&reference[i], rom, (u8)(i + 2));
+        gb_add_breakpoint(&lanes[i], 0x0113); // loop: CALL $C000
+        gb_add_breakpoint(&reference[i], 0x0113);
+    }
+
+    static Lockstep ls;
+    ck_assert(lockstep_init(&ls, ptrs, 2));
+    for (int frame = 0; frame < 3; frame++) {
+        lockstep_run_frame(&ls);
+        gb_run_frame(&reference[0]);
+        gb_run_frame(&reference[1]);
+    }
+
+    assert_same_state(&lanes[0], &reference[0]);
+    assert_same_state(&lanes[1], &reference[1]);
+
+    lockstep_free(&ls);
+    free(rom);
+}
+END_TEST
+
+// ============================================================================
+// Sharing Tests
+// ============================================================================
+
+START_TEST(test_lockstep_shares_rom_blocks) {
+    static GameBoy lanes[LANES];
+    GameBoy       *ptrs[LANES];
+    u8            *rom = make_rom();
+
+    for (int i = 0; i < LANES; i++) {
+        setup(&lanes[i], rom, 5);
+        ptrs[i] = &lanes[i];
+    }
+
+    static Lockstep ls;
+    ck_assert(lockstep_init(&ls, ptrs, LANES));
+    lockstep_run_frame(&ls);
+
+    // ROM blocks were decoded once, into the shared cache. Lanes only decoded the WRAM routine
+    int shared = 0;
+    for (int i = 0; i < DECODE_CACHE_SIZE; i++) {
+        const u8 *host = ls.decode.blocks[i].host;
+        if (host) {
+            ck_assert(host >= rom && host < rom + 2 * MBC_ROM_BANK_SIZE);
+            shared++;
+        }
+    }
+    ck_assert_int_gt(shared, 0);
+
+    for (int lane = 0; lane < LANES; lane++) {
+        for (int i = 0; i < DECODE_CACHE_SIZE; i++) {
+            const u8 *host = lanes[lane].decode.blocks[i].host;
+            ck_assert(!host || host == lanes[lane].wram);
+        }
+        ck_assert_uint_eq(lanes[lane].cycles, lanes[0].cycles);
+    }
+
+    lockstep_free(&ls);
+    free(rom);
+}
+END_TEST
+
+// ============================================================================
+// Test Suite Setup
+// ============================================================================
+
+Suite *lockstep_suite(void) {
+    Suite *s;
+    TCase *tc_equiv, *tc_share;
+
+    s        = suite_create("Lockstep");
+
+    tc_equiv = tcase_create("Equivalence");
+    tcase_add_test(tc_equiv, test_lockstep_matches_run_frame);
+    tcase_add_test(tc_equiv, test_lockstep_separate_images);
+    tcase_add_test(tc_equiv, test_lockstep_stopped_lane);
+    tcase_add_test(tc_equiv, test_lockstep_breakpoints);
+    suite_add_tcase(s, tc_equiv);
+
+    tc_share = tcase_create("Sharing");
+    tcase_add_test(tc_share, test_lockstep_shares_rom_blocks);
+    suite_add_tcase(s, tc_share);
+
+    return s;
+}
+
+int main(void) {
+    int      number_failed;
+    Suite   *s;
+    SRunner *sr;
+
+    s  = lockstep_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_NORMAL);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (number_failed == 0) ? 0 : 1;
+}
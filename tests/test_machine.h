@@ -0,0 +1,53 @@
+// tests/test_machine.h
+// Machine fixture shared by the save state, rewind and fork tests
+#ifndef TEST_MACHINE_H
+#define TEST_MACHINE_H
+
+#include <check.h>
+#include <gbemu.h>
+#include <core/bus.h>
+#include <core/savestate.h>
+#include <stdlib.h>
+#include <string.h>
+
+// MBC1+RAM+BATTERY cart, 64 KB ROM and 8 KB RAM, about to run program from 0x0100 with HL at
+// the start of WRAM
+static inline void machine_setup(GameBoy *gb, const u8 *program, size_t len) {
+    gb_init(gb);
+    gb->cart.rom_size = 4 * MBC_ROM_BANK_SIZE;
+    gb->cart.rom      = calloc(1, gb->cart.rom_size);
+    gb->cart.ram_size = 0x2000;
+    gb->cart.ram      = calloc(1, gb->cart.ram_size);
+    memcpy(gb->cart.rom + 0x0100, program, len);
+    gb->cart.header.cart_type = 0x03;
+
+    mbc_init(gb);
+    mmu_map_update(gb);
+    cpu_reset(&gb->cpu);
+    gb->cpu.regs.h = 0xC0;
+    gb->cpu.regs.l = 0x00;
+    gb->running    = true;
+}
+
+// Fills WRAM from its start: INC A; LD (HL+),A; JR -4
+static inline void machine_setup_fill(GameBoy *gb) {
+    static const u8 program[] = {0x3C, 0x22, 0x18, 0xFC};
+    machine_setup(gb, program, sizeof(program));
+}
+
+static inline void machine_teardown(GameBoy *gb) {
+    free(gb->cart.rom);
+    free(gb->cart.ram);
+}
+
+// Save state of gb in a malloc'd buffer, its size in *size unless NULL
+static inline u8 *machine_save(GameBoy *gb, size_t *size) {
+    size_t len = gb_state_size(gb);
+    u8    *buf = malloc(len);
+    ck_assert_uint_eq(gb_save_state(gb, buf, len), len);
+    if (size)
+        *size = len;
+    return buf;
+}
+
+#endif // !TEST_MACHINE_H
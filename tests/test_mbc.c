@@ -0,0 +1,314 @@
+// tests/test_mbc.c
+#include <check.h>
+#include <gbemu.h>
+#include <core/bus.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Cartridge of the given type, every ROM bank starts with its own number (low, high byte)
+static void make_cart(GameBoy *gb, u8 type, size_t rom_banks, size_t ram_size) {
+    gb_init(gb);
+
+    gb->cart.rom_size = rom_banks * MBC_ROM_BANK_SIZE;
+    gb->cart.rom      = calloc(1, gb->cart.rom_size);
+    for (size_t bank = 0; bank < rom_banks; bank++) {
+        gb->cart.rom[bank * MBC_ROM_BANK_SIZE]     = (u8)bank;
+        gb->cart.rom[bank * MBC_ROM_BANK_SIZE + 1] = (u8)(bank >> 8);
+    }
+
+    gb->cart.ram_size         = ram_size;
+    gb->cart.ram              = ram_size ? calloc(1, ram_size) : NULL;
+    gb->cart.header.cart_type = type;
+
+    mbc_init(gb);
+    mmu_map_update(gb);
+}
+
+static void free_cart(GameBoy *gb) {
+    free(gb->cart.rom);
+    free(gb->cart.ram);
+}
+
+static u16 bank_at(GameBoy *gb, u16 addr) {
+    return MAKE_U16(mmu_read(gb, addr + 1), mmu_read(gb, addr));
+}
+
+// ============================================================================
+// MBC1 Tests
+// ============================================================================
+
+START_TEST(test_mbc1_rom_bank) {
+    GameBoy gb;
+    make_cart(&gb, 0x01, 8, 0);
+
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 1);
+
+    mmu_write(&gb, 0x2000, 0x05);
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 5);
+    ck_assert_uint_eq(bank_at(&gb, 0x0000), 0);
+
+    // Bank switch only swaps the page table pointer
+    ck_assert_ptr_eq(gb.cart.mbc.rom_bank_ptr, gb.cart.rom + 5 * MBC_ROM_BANK_SIZE);
+    ck_assert_ptr_eq(gb.read_map[0x40], gb.cart.rom + 5 * MBC_ROM_BANK_SIZE);
+    ck_assert_ptr_eq(gb.read_map[0x7F], gb.cart.rom + 5 * MBC_ROM_BANK_SIZE + 0x3F00);
+
+    // 0 selects 1, numbers past the last bank wrap
+    mmu_write(&gb, 0x3FFF, 0x00);
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 1);
+    mmu_write(&gb, 0x2000, 0x0B);
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 3);
+
+    free_cart(&gb);
+}
+END_TEST
+
+START_TEST(test_mbc1_upper_bits) {
+    GameBoy gb;
+    make_cart(&gb, 0x01, 128, 0); // 2 MB
+
+    mmu_write(&gb, 0x2000, 0x01);
+    mmu_write(&gb, 0x4000, 0x02);
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 0x41);
+    ck_assert_uint_eq(bank_at(&gb, 0x0000), 0x00);
+
+    // 0x40 isn't reachable, the low 5 bits read 0 as 1
+    mmu_write(&gb, 0x2000, 0x00);
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 0x41);
+
+    // Mode 1 also banks 0x0000 - 0x3FFF
+    mmu_write(&gb, 0x6000, 0x01);
+    ck_assert_uint_eq(bank_at(&gb, 0x0000), 0x40);
+    ck_assert_ptr_eq(gb.read_map[0x00], gb.cart.rom + 0x40 * MBC_ROM_BANK_SIZE);
+
+    mmu_write(&gb, 0x6000, 0x00);
+    ck_assert_uint_eq(bank_at(&gb, 0x0000), 0x00);
+
+    free_cart(&gb);
+}
+END_TEST
+
+START_TEST(test_mbc1_ram_enable) {
+    GameBoy gb;
+    make_cart(&gb, 0x03, 4, 0x2000);
+
+    // Disabled at power-on: reads open bus, writes dropped
+    ck_assert_ptr_null(gb.read_map[0xA0]);
+    mmu_write(&gb, 0xA000, 0x12);
+    ck_assert_uint_eq(mmu_read(&gb, 0xA000), 0xFF);
+    ck_assert_uint_eq(gb.cart.ram[0], 0x00);
+
+    // Enabled: mapped straight to the RAM
+    mmu_write(&gb, 0x0000, 0x0A);
+    ck_assert_ptr_eq(gb.write_map[0xBF], gb.cart.ram + 0x1F00);
+    mmu_write(&gb, 0xA000, 0x12);
+    ck_assert_uint_eq(mmu_read(&gb, 0xA000), 0x12);
+
+    // Anything without 0xA in the low nibble disables it again
+    mmu_write(&gb, 0x1FFF, 0x0B);
+    ck_assert_ptr_null(gb.read_map[0xA0]);
+    ck_assert_uint_eq(mmu_read(&gb, 0xA000), 0xFF);
+    ck_assert_uint_eq(gb.cart.ram[0], 0x12);
+
+    free_cart(&gb);
+}
+END_TEST
+
+START_TEST(test_mbc1_ram_banking) {
+    GameBoy gb;
+    make_cart(&gb, 0x03, 4, 0x8000);
+
+    mmu_write(&gb, 0x0000, 0x0A);
+    mmu_write(&gb, 0x4000, 0x02);
+
+    // Mode 0: RAM bank stays 0
+    mmu_write(&gb, 0xA000, 0x11);
+    ck_assert_uint_eq(gb.cart.ram[0x0000], 0x11);
+
+    // Mode 1: 0x4000 - 0x5FFF selects the RAM bank
+    mmu_write(&gb, 0x6000, 0x01);
+    mmu_write(&gb, 0xA000, 0x22);
+    ck_assert_uint_eq(gb.cart.ram[0x4000], 0x22);
+    ck_assert_ptr_eq(gb.read_map[0xA0], gb.cart.ram + 0x4000);
+
+    free_cart(&gb);
+}
+END_TEST
+
+// ============================================================================
+// MBC3 Tests
+// ============================================================================
+
+START_TEST(test_mbc3_rom_bank) {
+    GameBoy gb;
+    make_cart(&gb, 0x13, 128, 0x8000);
+
+    mmu_write(&gb, 0x2000, 0x7F);
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 0x7F);
+
+    mmu_write(&gb, 0x2000, 0x00);
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 0x01);
+
+    // RAM bank select works in every mode
+    mmu_write(&gb, 0x0000, 0x0A);
+    mmu_write(&gb, 0x4000, 0x03);
+    mmu_write(&gb, 0xA123, 0x5A);
+    ck_assert_uint_eq(gb.cart.ram[3 * MBC_RAM_BANK_SIZE + 0x123], 0x5A);
+
+    free_cart(&gb);
+}
+END_TEST
+
+START_TEST(test_mbc3_rtc_registers) {
+    GameBoy gb;
+    make_cart(&gb, 0x10, 4, 0x2000);
+
+    mmu_write(&gb, 0x0000, 0x0A);
+    mmu_write(&gb, 0xA000, 0x77); // RAM bank 0
+
+    // Selecting an RTC register unmaps the RAM
+    mmu_write(&gb, 0x4000, 0x09); // Minutes
+    ck_assert_ptr_null(gb.read_map[0xA0]);
+    mmu_write(&gb, 0xA000, 42);
+    ck_assert_uint_eq(mmu_read(&gb, 0xA000), 42);
+    ck_assert_uint_eq(gb.cart.ram[0], 0x77);
+
+    // Latched copy only changes on a 0 -> 1 write
+    gb.cart.mbc.rtc[RTC_M] = 43;
+    ck_assert_uint_eq(mmu_read(&gb, 0xA000), 42);
+    mmu_write(&gb, 0x6000, 0x00);
+    mmu_write(&gb, 0x6000, 0x01);
+    ck_assert_uint_eq(mmu_read(&gb, 0xA000), 43);
+
+    gb.cart.mbc.rtc[RTC_M] = 44;
+    mmu_write(&gb, 0x6000, 0x01);
+    ck_assert_uint_eq(mmu_read(&gb, 0xA000), 43);
+
+    // Back to RAM
+    mmu_write(&gb, 0x4000, 0x00);
+    ck_assert_uint_eq(mmu_read(&gb, 0xA000), 0x77);
+
+    free_cart(&gb);
+}
+END_TEST
+
+// ============================================================================
+// MBC5 Tests
+// ============================================================================
+
+START_TEST(test_mbc5_nine_bit_bank) {
+    GameBoy gb;
+    make_cart(&gb, 0x19, 512, 0); // 8 MB
+
+    mmu_write(&gb, 0x2000, 0x23);
+    mmu_write(&gb, 0x3000, 0x01);
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 0x123);
+
+    // Low byte alone keeps bit 8
+    mmu_write(&gb, 0x2FFF, 0x45);
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 0x145);
+
+    // Bank 0 can be mapped at 0x4000
+    mmu_write(&gb, 0x2000, 0x00);
+    mmu_write(&gb, 0x3000, 0x00);
+    ck_assert_uint_eq(bank_at(&gb, 0x4000), 0x000);
+
+    free_cart(&gb);
+}
+END_TEST
+
+START_TEST(test_mbc5_ram_bank) {
+    GameBoy gb;
+    make_cart(&gb, 0x1B, 4, 0x20000); // 128 KB
+
+    mmu_write(&gb, 0x0000, 0x0A);
+    mmu_write(&gb, 0x4000, 0x0F);
+    mmu_write(&gb, 0xBFFF, 0x99);
+    ck_assert_uint_eq(gb.cart.ram[0x1FFFF], 0x99);
+
+    free_cart(&gb);
+}
+END_TEST
+
+// ============================================================================
+// Battery Save Tests
+// ============================================================================
+
+START_TEST(test_save_written_through_bus) {
+    GameBoy gb;
+    char    path[] = "/tmp/baredmg_savXXXXXX";
+    int     fd     = mkstemp(path);
+    ck_assert_int_ge(fd, 0);
+
+    make_cart(&gb, 0x03, 4, 0x2000);
+    ck_assert_int_eq(gb_attach_save(&gb, path, 1), 0);
+
+    // Page table points at the file mapping, plain stores reach the file
+    mmu_write(&gb, 0x0000, 0x0A);
+    ck_assert_ptr_eq(gb.write_map[0xA0], gb.cart.ram);
+    mmu_write(&gb, 0xA010, 0x3C);
+
+    u8 byte = 0;
+    ck_assert_int_eq(pread(fd, &byte, 1, 0x10), 1);
+    ck_assert_uint_eq(byte, 0x3C);
+
+    // Flushed once per frame
+    ck_assert_uint_eq(sched_when(&gb.sched, SCHED_SAVE), GB_FRAME_CYCLES);
+
+    cart_unload(&gb.cart); // Frees the ROM, syncs and unmaps the save
+    close(fd);
+    remove(path);
+}
+END_TEST
+
+// ============================================================================
+// Test Suite Setup
+// ============================================================================
+
+Suite *mbc_suite(void) {
+    Suite *s;
+    TCase *tc_mbc1, *tc_mbc3, *tc_mbc5, *tc_save;
+
+    s       = suite_create("MBC");
+
+    tc_mbc1 = tcase_create("MBC1");
+    tcase_add_test(tc_mbc1, test_mbc1_rom_bank);
+    tcase_add_test(tc_mbc1, test_mbc1_upper_bits);
+    tcase_add_test(tc_mbc1, test_mbc1_ram_enable);
+    tcase_add_test(tc_mbc1, test_mbc1_ram_banking);
+    suite_add_tcase(s, tc_mbc1);
+
+    tc_mbc3 = tcase_create("MBC3");
+    tcase_add_test(tc_mbc3, test_mbc3_rom_bank);
+    tcase_add_test(tc_mbc3, test_mbc3_rtc_registers);
+    suite_add_tcase(s, tc_mbc3);
+
+    tc_mbc5 = tcase_create("MBC5");
+    tcase_add_test(tc_mbc5, test_mbc5_nine_bit_bank);
+    tcase_add_test(tc_mbc5, test_mbc5_ram_bank);
+    suite_add_tcase(s, tc_mbc5);
+
+    tc_save = tcase_create("Battery Saves");
+    tcase_add_test(tc_save, test_save_written_through_bus);
+    suite_add_tcase(s, tc_save);
+
+    return s;
+}
+
+int main(void) {
+    int      number_failed;
+    Suite   *s;
+    SRunner *sr;
+
+    s  = mbc_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_NORMAL);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (number_failed == 0) ? 0 : 1;
+}
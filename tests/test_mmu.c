@@ -136,13 +136,117 @@ START_TEST(test_ie_register) {
 }
 END_TEST
 
+// ============================================================================
+// Memory Map (page table) Tests
+// ============================================================================
+
+START_TEST(test_map_plain_memory) {
+    GameBoy gb = {0};
+    gb_init(&gb);
+
+    // WRAM, echo and VRAM pages point straight at host memory
+    ck_assert_ptr_eq(gb.read_map[0xC0], gb.wram);
+    ck_assert_ptr_eq(gb.write_map[0xD1], gb.wram + 0x1100);
+    ck_assert_ptr_eq(gb.read_map[0xE1], gb.wram + 0x0100);
+    ck_assert_ptr_eq(gb.read_map[0x9F], gb.vram + 0x1F00);
+
+    // Pages with side effects stay on the slow path
+    ck_assert_ptr_null(gb.read_map[0xFE]);
+    ck_assert_ptr_null(gb.read_map[0xFF]);
+    ck_assert_ptr_null(gb.write_map[0x00]);
+    ck_assert_ptr_null(gb.write_map[0x7F]);
+}
+END_TEST
+
+START_TEST(test_map_rom_after_update) {
+    GameBoy gb = {0};
+    gb_init(&gb);
+
+    gb.cart.rom         = calloc(1, 0x8000);
+    gb.cart.rom_size    = 0x8000;
+    gb.cart.rom[0x7FFF] = 0x5A;
+
+    // Not mapped yet: served by the slow path
+    ck_assert_ptr_null(gb.read_map[0x7F]);
+    ck_assert_uint_eq(mmu_read(&gb, 0x7FFF), 0x5A);
+
+    // Mapped after a rebuild: served by the page table
+    mmu_map_update(&gb);
+    ck_assert_ptr_eq(gb.read_map[0x7F], gb.cart.rom + 0x7F00);
+    ck_assert_uint_eq(mmu_read(&gb, 0x7FFF), 0x5A);
+
+    free(gb.cart.rom);
+}
+END_TEST
+
+START_TEST(test_map_short_rom_open_bus) {
+    GameBoy gb = {0};
+    gb_init(&gb);
+
+    // Image ends in the middle of a page
+    gb.cart.rom         = calloc(1, 0x0180);
+    gb.cart.rom_size    = 0x0180;
+    gb.cart.rom[0x017F] = 0x77;
+    mmu_map_update(&gb);
+
+    ck_assert_ptr_nonnull(gb.read_map[0x00]);
+    ck_assert_ptr_null(gb.read_map[0x01]);
+    ck_assert_uint_eq(mmu_read(&gb, 0x017F), 0x77);
+    ck_assert_uint_eq(mmu_read(&gb, 0x0180), 0xFF);
+
+    free(gb.cart.rom);
+}
+END_TEST
+
+START_TEST(test_map_cart_ram_2kb) {
+    GameBoy gb = {0};
+    gb_init(&gb);
+
+    gb.cart.ram      = calloc(1, 0x800);
+    gb.cart.ram_size = 0x800;
+    mmu_map_update(&gb);
+
+    mmu_write(&gb, 0xA7FF, 0x12);
+    mmu_write(&gb, 0xA800, 0x34); // Past the end: ignored
+
+    ck_assert_ptr_eq(gb.write_map[0xA7], gb.cart.ram + 0x700);
+    ck_assert_ptr_null(gb.write_map[0xA8]);
+    ck_assert_uint_eq(mmu_read(&gb, 0xA7FF), 0x12);
+    ck_assert_uint_eq(mmu_read(&gb, 0xA800), 0xFF);
+
+    free(gb.cart.ram);
+}
+END_TEST
+
+START_TEST(test_map_16bit_access) {
+    GameBoy gb = {0};
+    gb_init(&gb);
+
+    // Inside a mapped page: one little-endian access
+    mmu_write16(&gb, 0xC010, 0x1234);
+    ck_assert_uint_eq(gb.wram[0x10], 0x34);
+    ck_assert_uint_eq(gb.wram[0x11], 0x12);
+    ck_assert_uint_eq(mmu_read16(&gb, 0xC010), 0x1234);
+
+    // Across a page boundary, and in HRAM (slow path)
+    mmu_write16(&gb, 0xC0FF, 0xABCD);
+    ck_assert_uint_eq(mmu_read(&gb, 0xC0FF), 0xCD);
+    ck_assert_uint_eq(mmu_read(&gb, 0xC100), 0xAB);
+    ck_assert_uint_eq(mmu_read16(&gb, 0xC0FF), 0xABCD);
+
+    mmu_write16(&gb, 0xFF90, 0x5678);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF90), 0x78);
+    ck_assert_uint_eq(mmu_read16(&gb, 0xFF90), 0x5678);
+}
+END_TEST
+
 // ============================================================================
 // Test Suite Setup
 // ============================================================================
 
 Suite *mmu_suite(void) {
     Suite *s;
-    TCase *tc_wram, *tc_hram, *tc_rom, *tc_special;
+    TCase *tc_wram, *tc_hram, *tc_rom, *tc_special, *tc_map;
 
     s       = suite_create("MMU");
 
@@ -169,6 +273,15 @@ Suite *mmu_suite(void) {
     tcase_add_test(tc_special, test_ie_register);
     suite_add_tcase(s, tc_special);
 
+    // Page table
+    tc_map = tcase_create("Memory Map");
+    tcase_add_test(tc_map, test_map_plain_memory);
+    tcase_add_test(tc_map, test_map_rom_after_update);
+    tcase_add_test(tc_map, test_map_short_rom_open_bus);
+    tcase_add_test(tc_map, test_map_cart_ram_2kb);
+    tcase_add_test(tc_map, test_map_16bit_access);
+    suite_add_tcase(s, tc_map);
+
     return s;
 }
 
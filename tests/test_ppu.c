@@ -0,0 +1,481 @@
+// tests/test_ppu.c
+#include <check.h>
+#include <gbemu.h>
+#include <core/bus.h>
+#include <core/tile_decode.h>
+#include <string.h>
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Place the clock at an exact cycle and run the PPU events due by then
+static void run_to(GameBoy *gb, u64 cycle) {
+    gb->cycles = cycle;
+    sched_run_due(gb);
+}
+
+// Line start of LY = line, in the first frame
+static u64 line_start(int line) {
+    return (u64)line * PPU_LINE_CYCLES;
+}
+
+// Set one row of a tile in 0x8000 addressing, through the bus like the CPU would
+static void set_tile_row(GameBoy *gb, u8 tile, u8 row, u8 lo, u8 hi) {
+    mmu_write(gb, (u16)(0x8000 + tile * 16 + row * 2), lo);
+    mmu_write(gb, (u16)(0x8000 + tile * 16 + row * 2 + 1), hi);
+}
+
+static void set_sprite(GameBoy *gb, int index, u8 y, u8 x, u8 tile, u8 attr) {
+    gb->oam[index * 4]     = y;
+    gb->oam[index * 4 + 1] = x;
+    gb->oam[index * 4 + 2] = tile;
+    gb->oam[index * 4 + 3] = attr;
+}
+
+// Render line 0 of the first frame (registers set before the end of its mode 3)
+static const u8 *render_line0(GameBoy *gb) {
+    run_to(gb, PPU_OAM_CYCLES + PPU_DRAW_CYCLES);
+    return gb->ppu.framebuffer[0];
+}
+
+// ============================================================================
+// Timing Tests
+// ============================================================================
+
+START_TEST(test_ppu_mode_sequence) {
+    GameBoy gb;
+    gb_init(&gb);
+
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF41) & 0x03, PPU_MODE_OAM);
+    run_to(&gb, 79);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF41) & 0x03, PPU_MODE_OAM);
+    run_to(&gb, 80);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF41) & 0x03, PPU_MODE_DRAW);
+    run_to(&gb, 252);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF41) & 0x03, PPU_MODE_HBLANK);
+    run_to(&gb, 456);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF41) & 0x03, PPU_MODE_OAM);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF44), 1);
+}
+END_TEST
+
+START_TEST(test_ppu_vblank) {
+    GameBoy gb;
+    gb_init(&gb);
+
+    run_to(&gb, line_start(144) - 1);
+    ck_assert_uint_eq(gb.if_register & INT_VBLANK, 0);
+
+    run_to(&gb, line_start(144));
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF44), 144);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF41) & 0x03, PPU_MODE_VBLANK);
+    ck_assert_uint_eq(gb.if_register & INT_VBLANK, INT_VBLANK);
+    ck_assert_uint_eq(gb.ppu.frame_count, 1);
+
+    run_to(&gb, line_start(153));
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF44), 153);
+
+    // Frames line up with gb_run_cycles' frame boundaries
+    run_to(&gb, GB_FRAME_CYCLES);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF44), 0);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF41) & 0x03, PPU_MODE_OAM);
+}
+END_TEST
+
+START_TEST(test_ppu_lyc_interrupt) {
+    GameBoy gb;
+    gb_init(&gb);
+
+    mmu_write(&gb, 0xFF45, 5);
+    mmu_write(&gb, 0xFF41, STAT_LYC_INT);
+
+    run_to(&gb, line_start(5) - 1);
+    ck_assert_uint_eq(gb.if_register & INT_STAT, 0);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF41) & 0x04, 0);
+
+    run_to(&gb, line_start(5));
+    ck_assert_uint_eq(gb.if_register & INT_STAT, INT_STAT);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF41) & 0x04, 0x04);
+}
+END_TEST
+
+START_TEST(test_ppu_stat_rising_edge) {
+    GameBoy gb;
+    gb_init(&gb);
+
+    // HBlank and LYC=0 sources overlap on line 0: one interrupt for the combined line
+    mmu_write(&gb, 0xFF41, STAT_HBLANK_INT | STAT_LYC_INT);
+    gb.if_register = 0;
+    run_to(&gb, 252);
+    ck_assert_uint_eq(gb.if_register & INT_STAT, 0);
+
+    // Line 1: LYC no longer matches, the HBlank entry is a new rising edge
+    run_to(&gb, line_start(1) + 252);
+    ck_assert_uint_eq(gb.if_register & INT_STAT, INT_STAT);
+}
+END_TEST
+
+START_TEST(test_ppu_lcd_off) {
+    GameBoy gb;
+    gb_init(&gb);
+
+    run_to(&gb, line_start(10));
+    mmu_write(&gb, 0xFF40, 0x11);
+
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF44), 0);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF41) & 0x03, 0);
+    ck_assert(!sched_is_pending(&gb.sched, SCHED_PPU));
+
+    // Back on: the frame restarts from line 0
+    run_to(&gb, 10000);
+    mmu_write(&gb, 0xFF40, 0x91);
+    run_to(&gb, 10000 + PPU_LINE_CYCLES);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF44), 1);
+}
+END_TEST
+
+START_TEST(test_ppu_run_loop_sees_ly) {
+    // LDH A, (0x44); CP 0x90; JR NZ, -6; HALT: wait for VBlank
+    static const u8 code[] = {0xF0, 0x44, 0xFE, 0x90, 0x20, 0xFA, 0x76};
+    GameBoy         gb;
+    gb_init(&gb);
+    memcpy(gb.wram, code, sizeof(code));
+    gb.cpu.pc  = 0xC000;
+    gb.running = true;
+
+    // The loop exits on the first LY read after line 144 starts, even with the idle skip
+    GbRunResult res = gb_run_cycles(&gb, GB_FRAME_CYCLES);
+
+    ck_assert_int_eq(res.reason, GB_STOP_HALT);
+    ck_assert_uint_ge(gb.cycles, line_start(144));
+    ck_assert_uint_lt(gb.cycles, line_start(144) + 64);
+}
+END_TEST
+
+// ============================================================================
+// Rendering Tests
+// ============================================================================
+
+START_TEST(test_ppu_decode_tile_row) {
+    static const u8 planes[2] = {0xF0, 0xCC};
+    u8              out[8];
+    tile_decode_rows(planes, 1, TILE_PALETTE_IDENTITY, out);
+
+    static const u8 expected[8] = {3, 3, 1, 1, 2, 2, 0, 0};
+    ck_assert_mem_eq(out, expected, 8);
+}
+END_TEST
+
+START_TEST(test_ppu_background) {
+    GameBoy gb;
+    gb_init(&gb);
+
+    // Tile 1 in the first map column, tile 0 (blank) everywhere else
+    set_tile_row(&gb, 1, 0, 0xF0, 0xCC);
+    gb.vram[0x1800] = 1;
+    mmu_write(&gb, 0xFF47, 0xE4); // Identity palette
+
+    const u8 *line = render_line0(&gb);
+    static const u8 expected[8] = {3, 3, 1, 1, 2, 2, 0, 0};
+    ck_assert_mem_eq(line, expected, 8);
+    ck_assert_uint_eq(line[8], 0);
+
+    // BGP maps color indices to shades
+    mmu_write(&gb, 0xFF47, 0x1B); // Inverted
+    run_to(&gb, line_start(1) + PPU_OAM_CYCLES + PPU_DRAW_CYCLES);
+    ck_assert_uint_eq(gb.ppu.framebuffer[1][0], 3); // Row 1 of tile 1 is blank
+}
+END_TEST
+
+START_TEST(test_ppu_scroll) {
+    GameBoy gb;
+    gb_init(&gb);
+
+    // Tile 1 at map (1, 1), scrolled to the top-left corner
+    set_tile_row(&gb, 1, 3, 0xFF, 0x00);
+    gb.vram[0x1800 + 32 + 1] = 1;
+    mmu_write(&gb, 0xFF47, 0xE4);
+    mmu_write(&gb, 0xFF42, 8 + 3);
+    mmu_write(&gb, 0xFF43, 8 + 4);
+
+    const u8 *line = render_line0(&gb);
+    static const u8 expected[8] = {1, 1, 1, 1, 0, 0, 0, 0};
+    ck_assert_mem_eq(line, expected, 8);
+}
+END_TEST
+
+START_TEST(test_ppu_window) {
+    GameBoy gb;
+    gb_init(&gb);
+
+    // Window map at 0x9C00 uses tile 1, starts at x = 80
+    set_tile_row(&gb, 1, 0, 0xFF, 0xFF);
+    memset(&gb.vram[0x1C00], 1, 32);
+    mmu_write(&gb, 0xFF47, 0xE4);
+    mmu_write(&gb, 0xFF4A, 0);
+    mmu_write(&gb, 0xFF4B, 80 + 7);
+    mmu_write(&gb, 0xFF40, 0x91 | LCDC_WIN_ENABLE | LCDC_WIN_MAP);
+
+    const u8 *line = render_line0(&gb);
+    ck_assert_uint_eq(line[79], 0);
+    ck_assert_uint_eq(line[80], 3);
+    ck_assert_uint_eq(line[159], 3);
+    ck_assert_uint_eq(gb.ppu.window_line, 1);
+}
+END_TEST
+
+START_TEST(test_ppu_sprites) {
+    GameBoy gb;
+    gb_init(&gb);
+
+    set_tile_row(&gb, 2, 0, 0xFF, 0x00); // Color 1
+    set_tile_row(&gb, 3, 0, 0x00, 0xFF); // Color 2
+    set_tile_row(&gb, 4, 0, 0x0F, 0x00); // Color 1 on the right half only
+    mmu_write(&gb, 0xFF47, 0xE4);
+    mmu_write(&gb, 0xFF48, 0xE4);
+    mmu_write(&gb, 0xFF49, 0x1B); // Inverted
+    mmu_write(&gb, 0xFF40, 0x91 | LCDC_OBJ_ENABLE);
+
+    // Overlap: the lower X wins, whatever the OAM order
+    set_sprite(&gb, 0, 16, 8 + 12, 3, 0x00);
+    set_sprite(&gb, 1, 16, 8 + 10, 2, 0x00);
+
+    // Transparent pixels let the next sprite through
+    set_sprite(&gb, 2, 16, 8 + 40, 4, 0x00);
+    set_sprite(&gb, 3, 16, 8 + 42, 3, 0x10); // OBP1
+
+    const u8 *line = render_line0(&gb);
+    ck_assert_uint_eq(line[9], 0);
+    ck_assert_uint_eq(line[10], 1);
+    ck_assert_uint_eq(line[17], 1);
+    ck_assert_uint_eq(line[18], 2);
+    ck_assert_uint_eq(line[19], 2);
+    ck_assert_uint_eq(line[20], 0);
+
+    ck_assert_uint_eq(line[42], 1); // Shade 2 through OBP1 -> 1
+    ck_assert_uint_eq(line[44], 1);
+    ck_assert_uint_eq(line[49], 1);
+}
+END_TEST
+
+START_TEST(test_ppu_sprite_limit_and_priority) {
+    GameBoy gb;
+    gb_init(&gb);
+
+    set_tile_row(&gb, 1, 0, 0xFF, 0xFF); // BG color 3 on the left tile
+    set_tile_row(&gb, 2, 0, 0xFF, 0x00); // Sprite color 1
+    gb.vram[0x1800] = 1;
+    mmu_write(&gb, 0xFF47, 0xE4);
+    mmu_write(&gb, 0xFF48, 0xE4);
+    mmu_write(&gb, 0xFF40, 0x91 | LCDC_OBJ_ENABLE);
+
+    // Behind BG: hidden over BG color 3, shown over color 0
+    set_sprite(&gb, 0, 16, 8 + 4, 2, 0x80);
+
+    // 11 sprites on the line: the last in OAM order is dropped
+    for (int i = 1; i <= 10; i++)
+        set_sprite(&gb, i, 16, (u8)(8 + 14 * i), 2, 0x00);
+
+    const u8 *line = render_line0(&gb);
+    ck_assert_uint_eq(line[4], 3);
+    ck_assert_uint_eq(line[8], 1);
+    ck_assert_uint_eq(line[14 * 9], 1);
+    ck_assert_uint_eq(line[14 * 10], 0); // Sprite 10 is the 11th on the line
+}
+END_TEST
+
+START_TEST(test_ppu_oam_dma) {
+    GameBoy gb;
+    gb_init(&gb);
+
+    for (int i = 0; i < 0xA0; i++)
+        gb.wram[0x100 + i] = (u8)(i ^ 0x5A);
+
+    mmu_write(&gb, 0xFF46, 0xC1);
+    for (int i = 0; i < 0xA0; i++)
+        ck_assert_uint_eq(gb.oam[i], (u8)(i ^ 0x5A));
+}
+END_TEST
+
+// ============================================================================
+// Tile Cache Tests
+// ============================================================================
+
+START_TEST(test_tile_cache_follows_writes) {
+    GameBoy gb;
+    gb_init(&gb);
+    mmu_write(&gb, 0xFF47, 0xE4);
+
+    // Tile data pages are written through the slow path, the maps directly
+    ck_assert_ptr_null(gb.write_map[0x80]);
+    ck_assert_ptr_null(gb.write_map[0x97]);
+    ck_assert_ptr_eq(gb.write_map[0x98], gb.vram + 0x1800);
+
+    set_tile_row(&gb, 0, 0, 0xFF, 0x00);
+    ck_assert(gb.tile_dirty[0]);
+    ck_assert_uint_eq(render_line0(&gb)[0], 1);
+    ck_assert(!gb.tile_dirty[0]);
+
+    // Rewritten after being decoded: the next line sees the new data
+    set_tile_row(&gb, 0, 1, 0x00, 0xFF);
+    ck_assert(gb.tile_dirty[0]);
+    run_to(&gb, line_start(1) + PPU_OAM_CYCLES + PPU_DRAW_CYCLES);
+    ck_assert_uint_eq(gb.ppu.framebuffer[1][0], 2);
+}
+END_TEST
+
+START_TEST(test_tile_cache_same_value_write) {
+    GameBoy gb;
+    gb_init(&gb);
+    render_line0(&gb);
+
+    // Rewriting a byte with its current value leaves the tile clean
+    mmu_write(&gb, 0x8010, 0x00);
+    ck_assert(!gb.tile_dirty[1]);
+    mmu_write(&gb, 0x8010, 0x01);
+    ck_assert(gb.tile_dirty[1]);
+    ck_assert(!gb.tile_dirty[0]);
+}
+END_TEST
+
+START_TEST(test_tile_cache_signed_and_tall) {
+    GameBoy gb;
+    gb_init(&gb);
+    mmu_write(&gb, 0xFF47, 0xE4);
+    mmu_write(&gb, 0xFF48, 0xE4);
+
+    // 0x8800 addressing: index 0x80 is tile 128 (0x8800), index 0x00 is tile 256 (0x9000)
+    set_tile_row(&gb, 0x80, 0, 0xFF, 0xFF);
+    mmu_write(&gb, 0x9000, 0xFF);
+    gb.vram[0x1800] = 0x80;
+    gb.vram[0x1801] = 0x00;
+
+    // 8x16 sprite at x = 40 whose line 0 is row 8, the second tile of the pair
+    mmu_write(&gb, 0x8000 + 5 * 16 + 1, 0xFF); // Color 2
+    set_sprite(&gb, 0, 16 - 8, 8 + 40, 4, 0x00);
+    mmu_write(&gb, 0xFF40, 0x81 | LCDC_OBJ_ENABLE | LCDC_OBJ_SIZE);
+
+    const u8 *line = render_line0(&gb);
+    ck_assert_uint_eq(line[0], 3);
+    ck_assert_uint_eq(line[8], 1);
+    ck_assert_uint_eq(line[40], 2);
+}
+END_TEST
+
+START_TEST(test_tile_cache_invalidate) {
+    GameBoy gb;
+    gb_init(&gb);
+    mmu_write(&gb, 0xFF47, 0xE4);
+    render_line0(&gb);
+
+    // Direct VRAM changes (e.g. restoring a snapshot) need an explicit invalidation
+    gb.vram[0] = 0xFF;
+    gb.vram[1] = 0xFF;
+    ppu_invalidate_tiles(&gb);
+    run_to(&gb, line_start(1));
+    run_to(&gb, GB_FRAME_CYCLES + PPU_OAM_CYCLES + PPU_DRAW_CYCLES);
+    ck_assert_uint_eq(gb.ppu.framebuffer[0][0], 3);
+}
+END_TEST
+
+// ============================================================================
+// Render Mode Tests
+// ============================================================================
+
+// Change BGP 40 pixels into line 0, after the line has started drawing
+static void mid_line_palette_change(GameBoy *gb) {
+    set_tile_row(gb, 0, 0, 0xFF, 0x00); // Every BG pixel on line 0 is color 1
+    mmu_write(gb, 0xFF47, 0xE4);
+    run_to(gb, PPU_OAM_CYCLES);
+    gb->cycles = PPU_OAM_CYCLES + 12 + 40;
+    mmu_write(gb, 0xFF47, 0xE8); // Color 1 -> shade 2
+    run_to(gb, PPU_OAM_CYCLES + PPU_DRAW_CYCLES);
+}
+
+START_TEST(test_ppu_scanline_mode) {
+    GameBoy gb;
+    gb_init(&gb);
+    mid_line_palette_change(&gb);
+
+    // The whole line uses the registers at the end of mode 3
+    ck_assert_uint_eq(gb.ppu.framebuffer[0][0], 2);
+    ck_assert_uint_eq(gb.ppu.framebuffer[0][159], 2);
+}
+END_TEST
+
+START_TEST(test_ppu_dot_mode) {
+    GameBoy gb;
+    gb_init(&gb);
+    gb.ppu.render_mode = PPU_RENDER_DOT;
+    mid_line_palette_change(&gb);
+
+    // Pixels output before the write keep the old palette
+    ck_assert_uint_eq(gb.ppu.framebuffer[0][39], 1);
+    ck_assert_uint_eq(gb.ppu.framebuffer[0][40], 2);
+    ck_assert_uint_eq(gb.ppu.framebuffer[0][159], 2);
+}
+END_TEST
+
+// ============================================================================
+// Test Suite Setup
+// ============================================================================
+
+Suite *ppu_suite(void) {
+    Suite *s;
+    TCase *tc_timing, *tc_render, *tc_cache, *tc_modes;
+
+    s         = suite_create("PPU");
+
+    // Mode transitions, LY and interrupts
+    tc_timing = tcase_create("Timing");
+    tcase_add_test(tc_timing, test_ppu_mode_sequence);
+    tcase_add_test(tc_timing, test_ppu_vblank);
+    tcase_add_test(tc_timing, test_ppu_lyc_interrupt);
+    tcase_add_test(tc_timing, test_ppu_stat_rising_edge);
+    tcase_add_test(tc_timing, test_ppu_lcd_off);
+    tcase_add_test(tc_timing, test_ppu_run_loop_sees_ly);
+    suite_add_tcase(s, tc_timing);
+
+    // Frame buffer contents
+    tc_render = tcase_create("Rendering");
+    tcase_add_test(tc_render, test_ppu_decode_tile_row);
+    tcase_add_test(tc_render, test_ppu_background);
+    tcase_add_test(tc_render, test_ppu_scroll);
+    tcase_add_test(tc_render, test_ppu_window);
+    tcase_add_test(tc_render, test_ppu_sprites);
+    tcase_add_test(tc_render, test_ppu_sprite_limit_and_priority);
+    tcase_add_test(tc_render, test_ppu_oam_dma);
+    suite_add_tcase(s, tc_render);
+
+    // Decoded tiles follow VRAM writes
+    tc_cache = tcase_create("Tile Cache");
+    tcase_add_test(tc_cache, test_tile_cache_follows_writes);
+    tcase_add_test(tc_cache, test_tile_cache_same_value_write);
+    tcase_add_test(tc_cache, test_tile_cache_signed_and_tall);
+    tcase_add_test(tc_cache, test_tile_cache_invalidate);
+    suite_add_tcase(s, tc_cache);
+
+    // Scanline vs dot rendering
+    tc_modes = tcase_create("Render Modes");
+    tcase_add_test(tc_modes, test_ppu_scanline_mode);
+    tcase_add_test(tc_modes, test_ppu_dot_mode);
+    suite_add_tcase(s, tc_modes);
+
+    return s;
+}
+
+int main(void) {
+    int      number_failed;
+    Suite   *s;
+    SRunner *sr;
+
+    s  = ppu_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_NORMAL);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (number_failed == 0) ? 0 : 1;
+}
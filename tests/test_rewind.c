@@ -0,0 +1,241 @@
+// tests/test_rewind.c
+#include <check.h>
+#include <gbemu.h>
+#include <core/bus.h>
+#include <core/rewind.h>
+#include <core/savestate.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_machine.h"
+
+#define FRAMES 40
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Run a frame's worth of cycles, push, and keep a plain copy of the state in states[frame]
+static void record(Rewind *rw, GameBoy *gb, u8 **states, int frames) {
+    for (int i = 0; i < frames; i++) {
+        gb_run_cycles(gb, 3000);
+        states[i] = machine_save(gb, NULL);
+        ck_assert(rewind_push(rw, gb));
+    }
+}
+
+static void assert_state(GameBoy *gb, const u8 *expected) {
+    size_t size = gb_state_size(gb);
+    u8    *now  = malloc(size);
+    gb_save_state(gb, now, size);
+    ck_assert_mem_eq(now, expected, size);
+    free(now);
+}
+
+static void free_states(u8 **states, int frames) {
+    for (int i = 0; i < frames; i++)
+        free(states[i]);
+}
+
+// ============================================================================
+// Restore Tests
+// ============================================================================
+
+START_TEST(test_rewind_load_every_age) {
+    GameBoy gb;
+    Rewind  rw;
+    u8     *states[FRAMES];
+
+    machine_setup_fill(&gb);
+    ck_assert(rewind_init(&rw, &gb, 1 << 20, FRAMES, 8));
+    record(&rw, &gb, states, FRAMES);
+    ck_assert_uint_eq(rewind_count(&rw), FRAMES);
+
+    // Keyframes and deltas on either side of them
+    for (u32 age = 0; age < FRAMES; age++) {
+        ck_assert(rewind_load(&rw, &gb, age));
+        assert_state(&gb, states[FRAMES - 1 - age]);
+    }
+    ck_assert(!rewind_load(&rw, &gb, FRAMES));
+
+    // Loading drops nothing
+    ck_assert_uint_eq(rewind_count(&rw), FRAMES);
+
+    rewind_free(&rw);
+    free_states(states, FRAMES);
+    machine_teardown(&gb);
+}
+END_TEST
+
+START_TEST(test_rewind_pop_then_push) {
+    GameBoy gb;
+    Rewind  rw;
+    u8     *states[FRAMES];
+    u8     *again[FRAMES];
+
+    machine_setup_fill(&gb);
+    ck_assert(rewind_init(&rw, &gb, 1 << 20, 2 * FRAMES, 8));
+    record(&rw, &gb, states, FRAMES);
+
+    // Step back past two keyframes (entries 32 and 24)
+    for (int i = FRAMES - 1; i >= 20; i--) {
+        ck_assert(rewind_pop(&rw, &gb));
+        assert_state(&gb, states[i]);
+    }
+    ck_assert_uint_eq(rewind_count(&rw), 20);
+
+    // New deltas after popping must go against the surviving keyframe
+    gb_load_state(&gb, states[19], gb_state_size(&gb));
+    record(&rw, &gb, again, FRAMES - 20);
+    for (u32 age = 0; age < FRAMES - 20; age++) {
+        ck_assert(rewind_load(&rw, &gb, age));
+        assert_state(&gb, again[FRAMES - 21 - age]);
+    }
+    ck_assert(rewind_load(&rw, &gb, FRAMES - 1));
+    assert_state(&gb, states[0]);
+
+    rewind_free(&rw);
+    free_states(states, FRAMES);
+    free_states(again, FRAMES - 20);
+    machine_teardown(&gb);
+}
+END_TEST
+
+START_TEST(test_rewind_pop_empty) {
+    GameBoy gb;
+    Rewind  rw;
+
+    machine_setup_fill(&gb);
+    ck_assert(rewind_init(&rw, &gb, 1 << 20, 4, 0));
+    ck_assert(!rewind_pop(&rw, &gb));
+
+    ck_assert(rewind_push(&rw, &gb));
+    ck_assert(rewind_pop(&rw, &gb));
+    ck_assert_uint_eq(rewind_count(&rw), 0);
+    ck_assert_uint_eq(rewind_bytes_used(&rw), 0);
+
+    rewind_free(&rw);
+    machine_teardown(&gb);
+}
+END_TEST
+
+// ============================================================================
+// Arena Tests
+// ============================================================================
+
+START_TEST(test_rewind_deltas_are_small) {
+    GameBoy gb;
+    Rewind  rw;
+    u8     *states[FRAMES];
+
+    machine_setup_fill(&gb);
+    ck_assert(rewind_init(&rw, &gb, 1 << 20, FRAMES, 0));
+    record(&rw, &gb, states, FRAMES);
+
+    // One keyframe, the rest only differ in a few hundred bytes of WRAM and registers
+    ck_assert_uint_lt(rewind_bytes_used(&rw), (size_t)FRAMES * gb_state_size(&gb) / 10);
+
+    rewind_free(&rw);
+    free_states(states, FRAMES);
+    machine_teardown(&gb);
+}
+END_TEST
+
+START_TEST(test_rewind_evicts_oldest_group) {
+    GameBoy gb;
+    Rewind  rw;
+    u8     *states[FRAMES];
+
+    // Entry ring full: groups of 5 go as a whole
+    machine_setup_fill(&gb);
+    ck_assert(rewind_init(&rw, &gb, 1 << 20, 12, 5));
+    record(&rw, &gb, states, FRAMES);
+    ck_assert_uint_le(rewind_count(&rw), 12);
+    ck_assert_uint_ge(rewind_count(&rw), 8);
+
+    u32 oldest = rewind_count(&rw) - 1;
+    ck_assert(rewind_load(&rw, &gb, oldest));
+    assert_state(&gb, states[FRAMES - 1 - oldest]);
+    rewind_free(&rw);
+    free_states(states, FRAMES);
+
+    // Arena full (a keyframe here packs to a few KB): wraps around and still restores every
+    // held state
+    ck_assert(rewind_init(&rw, &gb, 16 * 1024, FRAMES, 4));
+    record(&rw, &gb, states, FRAMES);
+    ck_assert_uint_lt(rewind_count(&rw), FRAMES);
+    ck_assert_uint_le(rewind_bytes_used(&rw), 16 * 1024);
+
+    for (u32 age = 0; age < rewind_count(&rw); age++) {
+        ck_assert(rewind_load(&rw, &gb, age));
+        assert_state(&gb, states[FRAMES - 1 - age]);
+    }
+
+    rewind_free(&rw);
+    free_states(states, FRAMES);
+    machine_teardown(&gb);
+}
+END_TEST
+
+START_TEST(test_rewind_rejects_other_cart) {
+    GameBoy gb;
+    Rewind  rw;
+
+    machine_setup_fill(&gb);
+    ck_assert(rewind_init(&rw, &gb, 1 << 20, 4, 0));
+
+    // A state bigger than the arena, and one of another size
+    Rewind tiny;
+    ck_assert(rewind_init(&tiny, &gb, 64, 4, 0));
+    ck_assert(!rewind_push(&tiny, &gb));
+    rewind_free(&tiny);
+
+    gb.cart.ram_size = 0x800;
+    ck_assert(!rewind_push(&rw, &gb));
+    gb.cart.ram_size = 0x2000;
+    ck_assert(rewind_push(&rw, &gb));
+
+    rewind_free(&rw);
+    machine_teardown(&gb);
+}
+END_TEST
+
+// ============================================================================
+// Test Suite Setup
+// ============================================================================
+
+Suite *rewind_suite(void) {
+    Suite *s;
+    TCase *tc_restore, *tc_arena;
+
+    s          = suite_create("Rewind");
+
+    tc_restore = tcase_create("Restore");
+    tcase_add_test(tc_restore, test_rewind_load_every_age);
+    tcase_add_test(tc_restore, test_rewind_pop_then_push);
+    tcase_add_test(tc_restore, test_rewind_pop_empty);
+    suite_add_tcase(s, tc_restore);
+
+    tc_arena = tcase_create("Arena");
+    tcase_add_test(tc_arena, test_rewind_deltas_are_small);
+    tcase_add_test(tc_arena, test_rewind_evicts_oldest_group);
+    tcase_add_test(tc_arena, test_rewind_rejects_other_cart);
+    suite_add_tcase(s, tc_arena);
+
+    return s;
+}
+
+int main(void) {
+    int      number_failed;
+    Suite   *s;
+    SRunner *sr;
+
+    s  = rewind_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_NORMAL);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (number_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,264 @@
+// tests/test_scheduler.c
+#include <check.h>
+#include <gbemu.h>
+#include <core/bus.h>
+#include <core/scheduler.h>
+
+// ============================================================================
+// Recording handlers
+// ============================================================================
+
+static SchedEvent fired[16];
+static u64        fired_at[16];
+static int        fired_count;
+
+static void record(GameBoy *gb, SchedEvent event) {
+    if (fired_count < 16) {
+        fired[fired_count]    = event;
+        fired_at[fired_count] = gb->cycles;
+    }
+    fired_count++;
+}
+
+static void on_timer(GameBoy *gb, u64 when) {
+    (void)when;
+    record(gb, SCHED_TIMER);
+}
+
+static void on_ppu(GameBoy *gb, u64 when) {
+    (void)when;
+    record(gb, SCHED_PPU);
+}
+
+static void on_apu(GameBoy *gb, u64 when) {
+    (void)when;
+    record(gb, SCHED_APU);
+}
+
+// Periodic: reschedules itself relative to its own deadline, not to gb->cycles
+static void on_serial_periodic(GameBoy *gb, u64 when) {
+    record(gb, SCHED_SERIAL);
+    sched_schedule(&gb->sched, SCHED_SERIAL, when + 100);
+}
+
+static void setup(GameBoy *gb) {
+    gb_init(gb);
+    mmu_write(gb, 0xFF40, 0x00); // LCD off: nothing pending besides the test's own events
+    fired_count = 0;
+    sched_set_handler(&gb->sched, SCHED_TIMER, on_timer);
+    sched_set_handler(&gb->sched, SCHED_PPU, on_ppu);
+    sched_set_handler(&gb->sched, SCHED_APU, on_apu);
+    sched_set_handler(&gb->sched, SCHED_SERIAL, on_serial_periodic);
+}
+
+// ============================================================================
+// Queue Tests
+// ============================================================================
+
+START_TEST(test_sched_empty) {
+    GameBoy gb;
+    setup(&gb);
+
+    ck_assert(sched_next(&gb.sched) == SCHED_NEVER);
+    ck_assert(!sched_is_pending(&gb.sched, SCHED_TIMER));
+    ck_assert(sched_when(&gb.sched, SCHED_TIMER) == SCHED_NEVER);
+}
+END_TEST
+
+START_TEST(test_sched_order) {
+    GameBoy gb;
+    setup(&gb);
+
+    sched_schedule(&gb.sched, SCHED_APU, 300);
+    sched_schedule(&gb.sched, SCHED_TIMER, 100);
+    sched_schedule(&gb.sched, SCHED_PPU, 200);
+    ck_assert_uint_eq(sched_next(&gb.sched), 100);
+
+    gb.cycles = 1000;
+    sched_run_due(&gb);
+
+    ck_assert_int_eq(fired_count, 3);
+    ck_assert_int_eq(fired[0], SCHED_TIMER);
+    ck_assert_int_eq(fired[1], SCHED_PPU);
+    ck_assert_int_eq(fired[2], SCHED_APU);
+    ck_assert(sched_next(&gb.sched) == SCHED_NEVER);
+}
+END_TEST
+
+START_TEST(test_sched_only_due) {
+    GameBoy gb;
+    setup(&gb);
+
+    sched_schedule(&gb.sched, SCHED_TIMER, 100);
+    sched_schedule(&gb.sched, SCHED_PPU, 101);
+
+    gb.cycles = 100;
+    sched_run_due(&gb);
+
+    ck_assert_int_eq(fired_count, 1);
+    ck_assert(sched_is_pending(&gb.sched, SCHED_PPU));
+    ck_assert_uint_eq(sched_next(&gb.sched), 101);
+}
+END_TEST
+
+START_TEST(test_sched_tie_break) {
+    GameBoy gb;
+    setup(&gb);
+
+    sched_schedule(&gb.sched, SCHED_APU, 50);
+    sched_schedule(&gb.sched, SCHED_PPU, 50);
+    sched_schedule(&gb.sched, SCHED_TIMER, 50);
+
+    gb.cycles = 50;
+    sched_run_due(&gb);
+
+    ck_assert_int_eq(fired[0], SCHED_TIMER);
+    ck_assert_int_eq(fired[1], SCHED_PPU);
+    ck_assert_int_eq(fired[2], SCHED_APU);
+}
+END_TEST
+
+START_TEST(test_sched_reschedule_and_cancel) {
+    GameBoy gb;
+    setup(&gb);
+
+    sched_schedule(&gb.sched, SCHED_TIMER, 100);
+    sched_schedule(&gb.sched, SCHED_PPU, 200);
+    sched_schedule(&gb.sched, SCHED_APU, 300);
+
+    // Moving an event keeps a single entry for it
+    sched_schedule(&gb.sched, SCHED_TIMER, 400);
+    ck_assert_uint_eq(gb.sched.count, 3);
+    ck_assert_uint_eq(sched_next(&gb.sched), 200);
+    ck_assert_uint_eq(sched_when(&gb.sched, SCHED_TIMER), 400);
+
+    sched_cancel(&gb.sched, SCHED_PPU);
+    sched_cancel(&gb.sched, SCHED_PPU); // No-op
+    ck_assert_uint_eq(gb.sched.count, 2);
+    ck_assert_uint_eq(sched_next(&gb.sched), 300);
+
+    gb.cycles = 1000;
+    sched_run_due(&gb);
+    ck_assert_int_eq(fired_count, 2);
+    ck_assert_int_eq(fired[0], SCHED_APU);
+    ck_assert_int_eq(fired[1], SCHED_TIMER);
+}
+END_TEST
+
+START_TEST(test_sched_periodic_catch_up) {
+    GameBoy gb;
+    setup(&gb);
+
+    sched_schedule(&gb.sched, SCHED_SERIAL, 100);
+
+    // Late by several periods: every missed deadline fires once
+    gb.cycles = 450;
+    sched_run_due(&gb);
+
+    ck_assert_int_eq(fired_count, 4);
+    ck_assert_uint_eq(sched_when(&gb.sched, SCHED_SERIAL), 500);
+}
+END_TEST
+
+START_TEST(test_sched_deadline_lowered) {
+    GameBoy gb;
+    setup(&gb);
+
+    sched_set_deadline(&gb.sched, 1000);
+    ck_assert_uint_eq(gb.sched.deadline, 1000);
+
+    sched_schedule(&gb.sched, SCHED_TIMER, 600);
+    ck_assert_uint_eq(gb.sched.deadline, 600);
+
+    sched_set_deadline(&gb.sched, 1000);
+    ck_assert_uint_eq(gb.sched.deadline, 600);
+}
+END_TEST
+
+// ============================================================================
+// CPU Integration Tests
+// ============================================================================
+
+START_TEST(test_sched_breaks_cpu_run) {
+    GameBoy gb;
+    setup(&gb);
+
+    // JR -2: 12-cycle busy loop
+    gb.wram[0] = 0x18;
+    gb.wram[1] = 0xFE;
+    gb.cpu.pc  = 0xC000;
+    gb.running = true;
+
+    sched_schedule(&gb.sched, SCHED_TIMER, 100);
+    sched_schedule(&gb.sched, SCHED_PPU, 250);
+
+    GbRunResult res = gb_run_cycles(&gb, 1000);
+
+    // Each event runs at the first instruction boundary at or past its deadline
+    ck_assert_int_eq(res.reason, GB_STOP_BUDGET);
+    ck_assert_int_eq(fired_count, 2);
+    ck_assert_uint_eq(fired_at[0], 108);
+    ck_assert_uint_eq(fired_at[1], 252);
+}
+END_TEST
+
+START_TEST(test_sched_breaks_halt) {
+    GameBoy gb;
+    setup(&gb);
+
+    gb.cpu.halted = true;
+    gb.running    = true;
+
+    sched_schedule(&gb.sched, SCHED_TIMER, 402);
+    gb_run_cycles(&gb, 1000);
+
+    // Halted time is skipped up to the event, not over it
+    ck_assert_int_eq(fired_count, 1);
+    ck_assert_uint_eq(fired_at[0], 404);
+}
+END_TEST
+
+// ============================================================================
+// Test Suite Setup
+// ============================================================================
+
+Suite *scheduler_suite(void) {
+    Suite *s;
+    TCase *tc_queue, *tc_cpu;
+
+    s        = suite_create("Scheduler");
+
+    // Queue operations
+    tc_queue = tcase_create("Queue");
+    tcase_add_test(tc_queue, test_sched_empty);
+    tcase_add_test(tc_queue, test_sched_order);
+    tcase_add_test(tc_queue, test_sched_only_due);
+    tcase_add_test(tc_queue, test_sched_tie_break);
+    tcase_add_test(tc_queue, test_sched_reschedule_and_cancel);
+    tcase_add_test(tc_queue, test_sched_periodic_catch_up);
+    tcase_add_test(tc_queue, test_sched_deadline_lowered);
+    suite_add_tcase(s, tc_queue);
+
+    // Interaction with the run loop
+    tc_cpu = tcase_create("CPU Integration");
+    tcase_add_test(tc_cpu, test_sched_breaks_cpu_run);
+    tcase_add_test(tc_cpu, test_sched_breaks_halt);
+    suite_add_tcase(s, tc_cpu);
+
+    return s;
+}
+
+int main(void) {
+    int      number_failed;
+    Suite   *s;
+    SRunner *sr;
+
+    s  = scheduler_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_NORMAL);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (number_failed == 0) ? 0 : 1;
+}
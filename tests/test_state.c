@@ -0,0 +1,241 @@
+// tests/test_state.c
+#include <check.h>
+#include <gbemu.h>
+#include <core/bus.h>
+#include <core/savestate.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "test_machine.h"
+
+// ============================================================================
+// Round Trip Tests
+// ============================================================================
+
+START_TEST(test_state_round_trip) {
+    GameBoy gb;
+    machine_setup_fill(&gb);
+
+    gb_run_cycles(&gb, 5000);
+    mmu_write(&gb, 0x2000, 0x02); // ROM bank 2
+    mmu_write(&gb, 0x0000, 0x0A); // RAM on
+    mmu_write(&gb, 0xA000, 0x99);
+
+    size_t size;
+    u8    *state  = machine_save(&gb, &size);
+    CPU    cpu    = gb.cpu;
+    u64    cycles = gb.cycles;
+    u8     ly     = gb.ppu.ly;
+    u8     wram[0x2000];
+    memcpy(wram, gb.wram, sizeof(wram));
+
+    // Diverge, then come back
+    gb_run_cycles(&gb, 20000);
+    mmu_write(&gb, 0x2000, 0x03);
+    mmu_write(&gb, 0xA000, 0x11);
+    mmu_write(&gb, 0x0000, 0x00);
+    ck_assert_uint_ne(gb.cycles, cycles);
+
+    ck_assert(gb_load_state(&gb, state, size));
+    ck_assert_uint_eq(gb.cycles, cycles);
+    ck_assert_uint_eq(gb.cpu.pc, cpu.pc);
+    ck_assert_uint_eq(gb.cpu.regs.a, cpu.regs.a);
+    ck_assert_ptr_eq(gb.cpu.gb, &gb);
+    ck_assert_uint_eq(gb.ppu.ly, ly);
+    ck_assert_mem_eq(gb.wram, wram, sizeof(wram));
+
+    // MBC registers restored and remapped
+    ck_assert_uint_eq(gb.cart.mbc.rom_bank, 2);
+    ck_assert_ptr_eq(gb.read_map[0x40], gb.cart.rom + 2 * MBC_ROM_BANK_SIZE);
+    ck_assert_uint_eq(mmu_read(&gb, 0xA000), 0x99);
+
+    // Derived caches rebuilt
+    ck_assert(gb.tile_dirty[0] && gb.tile_dirty[PPU_TILES - 1]);
+
+    free(state);
+    machine_teardown(&gb);
+}
+END_TEST
+
+START_TEST(test_state_replay_deterministic) {
+    GameBoy gb;
+    machine_setup_fill(&gb);
+    gb_run_cycles(&gb, 3000);
+
+    size_t size;
+    u8    *start = machine_save(&gb, &size);
+
+    gb_run_cycles(&gb, 50000);
+    u8 *first = machine_save(&gb, &size);
+
+    ck_assert(gb_load_state(&gb, start, size));
+    gb_run_cycles(&gb, 50000);
+    u8 *second = machine_save(&gb, &size);
+
+    // Same machine after the same run
+    ck_assert_mem_eq(first, second, size);
+
+    free(start);
+    free(first);
+    free(second);
+    machine_teardown(&gb);
+}
+END_TEST
+
+START_TEST(test_state_same_across_instances) {
+    GameBoy a, b;
+    machine_setup_fill(&a);
+    machine_setup_fill(&b);
+
+    // Banks mapped to each instance's own ROM and RAM buffers
+    mmu_write(&a, 0x0000, 0x0A);
+    mmu_write(&b, 0x0000, 0x0A);
+    gb_run_cycles(&a, 5000);
+    gb_run_cycles(&b, 5000);
+
+    size_t size;
+    u8    *state = machine_save(&a, &size);
+    u8    *other = machine_save(&b, &size);
+    ck_assert_mem_eq(state, other, size);
+
+    free(state);
+    free(other);
+    machine_teardown(&a);
+    machine_teardown(&b);
+}
+END_TEST
+
+START_TEST(test_state_file) {
+    GameBoy gb;
+    char    path[] = "/tmp/baredmg_stateXXXXXX";
+    int     fd     = mkstemp(path);
+    ck_assert_int_ge(fd, 0);
+    close(fd);
+
+    machine_setup_fill(&gb);
+    gb_run_cycles(&gb, 4000);
+    u16 pc     = gb.cpu.pc;
+    u64 cycles = gb.cycles;
+
+    ck_assert_int_eq(gb_save_state_file(&gb, path), 0);
+    gb_run_cycles(&gb, 4000);
+    ck_assert_int_eq(gb_load_state_file(&gb, path), 0);
+
+    ck_assert_uint_eq(gb.cpu.pc, pc);
+    ck_assert_uint_eq(gb.cycles, cycles);
+
+    remove(path);
+    ck_assert_int_eq(gb_load_state_file(&gb, path), -1);
+    machine_teardown(&gb);
+}
+END_TEST
+
+// ============================================================================
+// Validation Tests
+// ============================================================================
+
+START_TEST(test_state_rejects_mismatch) {
+    GameBoy gb;
+    machine_setup_fill(&gb);
+    gb_run_cycles(&gb, 2000);
+
+    size_t size;
+    u8    *state = machine_save(&gb, &size);
+    gb_run_cycles(&gb, 2000);
+    u64 cycles = gb.cycles;
+
+    // Truncated
+    ck_assert(!gb_load_state(&gb, state, size - 8));
+
+    // Other version
+    state[4] ^= 0xFF;
+    ck_assert(!gb_load_state(&gb, state, size));
+    state[4] ^= 0xFF;
+
+    // Other cart RAM size
+    gb.cart.ram_size = 0x800;
+    ck_assert(!gb_load_state(&gb, state, size));
+    gb.cart.ram_size = 0x2000;
+
+    // Other cart with the same RAM size: another title or global checksum, another ROM size
+    gb.cart.raw_header.title[0] = 'X';
+    ck_assert(!gb_load_state(&gb, state, size));
+    gb.cart.raw_header.title[0] = 0;
+
+    gb.cart.raw_header.global_ck_lo = 0x12;
+    ck_assert(!gb_load_state(&gb, state, size));
+    gb.cart.raw_header.global_ck_lo = 0;
+
+    gb.cart.rom_size = 2 * MBC_ROM_BANK_SIZE;
+    ck_assert(!gb_load_state(&gb, state, size));
+    gb.cart.rom_size = 4 * MBC_ROM_BANK_SIZE;
+
+    // Nothing was touched
+    ck_assert_uint_eq(gb.cycles, cycles);
+
+    ck_assert(gb_load_state(&gb, state, size));
+    ck_assert_uint_ne(gb.cycles, cycles);
+
+    free(state);
+    machine_teardown(&gb);
+}
+END_TEST
+
+START_TEST(test_state_keeps_save_sync) {
+    GameBoy gb;
+    machine_setup_fill(&gb);
+
+    size_t size;
+    u8    *state = machine_save(&gb, &size);
+
+    // Saved without a .sav flush pending, restored on an instance that has one
+    gb.save_sync_cycles = GB_FRAME_CYCLES;
+    ck_assert(gb_load_state(&gb, state, size));
+    ck_assert_uint_eq(sched_when(&gb.sched, SCHED_SAVE), gb.cycles + GB_FRAME_CYCLES);
+
+    free(state);
+    machine_teardown(&gb);
+}
+END_TEST
+
+// ============================================================================
+// Test Suite Setup
+// ============================================================================
+
+Suite *state_suite(void) {
+    Suite *s;
+    TCase *tc_round_trip, *tc_validate;
+
+    s             = suite_create("Save State");
+
+    tc_round_trip = tcase_create("Round Trip");
+    tcase_add_test(tc_round_trip, test_state_round_trip);
+    tcase_add_test(tc_round_trip, test_state_replay_deterministic);
+    tcase_add_test(tc_round_trip, test_state_same_across_instances);
+    tcase_add_test(tc_round_trip, test_state_file);
+    suite_add_tcase(s, tc_round_trip);
+
+    tc_validate = tcase_create("Validation");
+    tcase_add_test(tc_validate, test_state_rejects_mismatch);
+    tcase_add_test(tc_validate, test_state_keeps_save_sync);
+    suite_add_tcase(s, tc_validate);
+
+    return s;
+}
+
+int main(void) {
+    int      number_failed;
+    Suite   *s;
+    SRunner *sr;
+
+    s  = state_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_NORMAL);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (number_failed == 0) ? 0 : 1;
+}
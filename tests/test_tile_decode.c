@@ -0,0 +1,134 @@
+// tests/test_tile_decode.c
+#include <check.h>
+#include <core/tile_decode.h>
+#include <string.h>
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+#define MAX_ROWS 100
+
+static u32 rng_state;
+
+static u8 rng_byte(void) {
+    rng_state = rng_state * 1103515245u + 12345u;
+    return (u8)(rng_state >> 16);
+}
+
+// Check one kernel against the scalar loop on random rows, every length up to MAX_ROWS
+// (covers the vector bodies and all tail sizes) and a few palettes
+static void check_matches_scalar(TileDecodeImpl impl) {
+    static const u8 palettes[] = {TILE_PALETTE_IDENTITY, 0x1B, 0xFC, 0x00, 0xD2};
+    u8              planes[2 * MAX_ROWS];
+    u8              want[8 * MAX_ROWS + 1];
+    u8              got[8 * MAX_ROWS + 1];
+
+    rng_state = 1234;
+    for (size_t i = 0; i < sizeof(planes); i++)
+        planes[i] = rng_byte();
+
+    for (size_t p = 0; p < sizeof(palettes); p++) {
+        for (size_t rows = 0; rows <= MAX_ROWS; rows++) {
+            memset(want, 0xAA, sizeof(want));
+            memset(got, 0xAA, sizeof(got));
+
+            ck_assert(tile_decode_select(TILE_DECODE_SCALAR));
+            tile_decode_rows(planes, rows, palettes[p], want);
+            ck_assert(tile_decode_select(impl));
+            tile_decode_rows(planes, rows, palettes[p], got);
+
+            // Also catches writes past the last row
+            ck_assert_msg(memcmp(want, got, sizeof(want)) == 0, "%s: %zu rows, palette 0x%02X",
+                          tile_decode_name(impl), rows, palettes[p]);
+        }
+    }
+
+    tile_decode_select(TILE_DECODE_AUTO);
+}
+
+// ============================================================================
+// Kernel Tests
+// ============================================================================
+
+START_TEST(test_scalar_row) {
+    static const u8 planes[4]    = {0xF0, 0xCC, 0x81, 0x01};
+    static const u8 expected[16] = {3, 3, 1, 1, 2, 2, 0, 0, 1, 0, 0, 0, 0, 0, 0, 3};
+    u8              out[16];
+
+    ck_assert(tile_decode_select(TILE_DECODE_SCALAR));
+    tile_decode_rows(planes, 2, TILE_PALETTE_IDENTITY, out);
+    ck_assert_mem_eq(out, expected, sizeof(expected));
+
+    // Palette applied: 0x1B inverts the shades
+    tile_decode_rows(planes, 1, 0x1B, out);
+    static const u8 inverted[8] = {0, 0, 2, 2, 1, 1, 3, 3};
+    ck_assert_mem_eq(out, inverted, sizeof(inverted));
+
+    tile_decode_select(TILE_DECODE_AUTO);
+}
+END_TEST
+
+START_TEST(test_sse2_matches_scalar) {
+    if (!tile_decode_supported(TILE_DECODE_SSE2))
+        return;
+    check_matches_scalar(TILE_DECODE_SSE2);
+}
+END_TEST
+
+START_TEST(test_avx2_matches_scalar) {
+    if (!tile_decode_supported(TILE_DECODE_AVX2))
+        return;
+    check_matches_scalar(TILE_DECODE_AVX2);
+}
+END_TEST
+
+START_TEST(test_auto_selection) {
+    ck_assert(tile_decode_select(TILE_DECODE_AUTO));
+
+    TileDecodeImpl active = tile_decode_active();
+    ck_assert_int_ne(active, TILE_DECODE_AUTO);
+    ck_assert(tile_decode_supported(active));
+
+    // Never worse than what the CPU offers
+    if (tile_decode_supported(TILE_DECODE_AVX2))
+        ck_assert_int_eq(active, TILE_DECODE_AVX2);
+    check_matches_scalar(active);
+}
+END_TEST
+
+// ============================================================================
+// Test Suite Setup
+// ============================================================================
+
+Suite *tile_decode_suite(void) {
+    Suite *s;
+    TCase *tc_kernels;
+
+    s          = suite_create("Tile Decode");
+
+    // Every available kernel agrees with the scalar loop
+    tc_kernels = tcase_create("Kernels");
+    tcase_add_test(tc_kernels, test_scalar_row);
+    tcase_add_test(tc_kernels, test_sse2_matches_scalar);
+    tcase_add_test(tc_kernels, test_avx2_matches_scalar);
+    tcase_add_test(tc_kernels, test_auto_selection);
+    suite_add_tcase(s, tc_kernels);
+
+    return s;
+}
+
+int main(void) {
+    int      number_failed;
+    Suite   *s;
+    SRunner *sr;
+
+    s  = tile_decode_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_NORMAL);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (number_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,276 @@
+// tests/test_timer.c
+#include <check.h>
+#include <gbemu.h>
+#include <core/bus.h>
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Place the clock at an exact cycle, as if the CPU had run up to it
+static void run_to(GameBoy *gb, u64 cycle) {
+    gb->cycles = cycle;
+    sched_run_due(gb);
+}
+
+// ============================================================================
+// DIV Tests
+// ============================================================================
+
+START_TEST(test_div_boot_value) {
+    GameBoy gb;
+    gb_init(&gb);
+
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF04), 0xAB);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF07), 0xF8);
+    ck_assert(!sched_is_pending(&gb.sched, SCHED_TIMER));
+}
+END_TEST
+
+START_TEST(test_div_increments) {
+    GameBoy gb;
+    gb_init(&gb);
+
+    // Boot counter is 0xABCC: 52 cycles to the next DIV step, then one every 256
+    run_to(&gb, 51);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF04), 0xAB);
+    run_to(&gb, 52);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF04), 0xAC);
+    run_to(&gb, 52 + 256 * 10);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF04), 0xB6);
+}
+END_TEST
+
+START_TEST(test_div_reset) {
+    GameBoy gb;
+    gb_init(&gb);
+
+    run_to(&gb, 1000);
+    mmu_write(&gb, 0xFF04, 0x5A); // Any value resets
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF04), 0x00);
+
+    run_to(&gb, 1000 + 255);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF04), 0x00);
+    run_to(&gb, 1000 + 256);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF04), 0x01);
+}
+END_TEST
+
+// ============================================================================
+// TIMA Tests
+// ============================================================================
+
+START_TEST(test_tima_rate) {
+    GameBoy gb;
+    gb_init(&gb);
+
+    // Counter reset to 0, 16-cycle period
+    mmu_write(&gb, 0xFF04, 0);
+    mmu_write(&gb, 0xFF07, 0x05);
+
+    run_to(&gb, 15);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF05), 0);
+    run_to(&gb, 16);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF05), 1);
+    run_to(&gb, 16 * 100 + 7);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF05), 100);
+
+    // Disabled: TIMA holds its value
+    mmu_write(&gb, 0xFF07, 0x01);
+    run_to(&gb, 16 * 200);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF05), 100);
+    ck_assert(!sched_is_pending(&gb.sched, SCHED_TIMER));
+}
+END_TEST
+
+START_TEST(test_tima_periods) {
+    static const u16 periods[4] = {1024, 16, 64, 256};
+
+    for (u8 sel = 0; sel < 4; sel++) {
+        GameBoy gb;
+        gb_init(&gb);
+
+        mmu_write(&gb, 0xFF04, 0);
+        mmu_write(&gb, 0xFF07, 0x04 | sel);
+        run_to(&gb, (u64)periods[sel] * 10);
+        ck_assert_uint_eq(mmu_read(&gb, 0xFF05), 10);
+    }
+}
+END_TEST
+
+START_TEST(test_tima_overflow_event) {
+    GameBoy gb;
+    gb_init(&gb);
+
+    mmu_write(&gb, 0xFF04, 0);
+    mmu_write(&gb, 0xFF06, 0xF0);
+    mmu_write(&gb, 0xFF05, 0xFE);
+    mmu_write(&gb, 0xFF07, 0x05);
+
+    // 0xFE -> 0xFF at 16, overflow at 32, TMA loaded and IF raised 4 cycles later
+    ck_assert_uint_eq(sched_when(&gb.sched, SCHED_TIMER), 36);
+
+    run_to(&gb, 32);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF05), 0x00);
+    ck_assert_uint_eq(gb.if_register & INT_TIMER, 0);
+
+    run_to(&gb, 36);
+    ck_assert_uint_eq(gb.if_register & INT_TIMER, INT_TIMER);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF05), 0xF0);
+
+    // Next overflow after 16 more increments
+    ck_assert_uint_eq(sched_when(&gb.sched, SCHED_TIMER), 32 + 16 * 16 + 4);
+}
+END_TEST
+
+START_TEST(test_tima_lazy_catch_up) {
+    GameBoy gb;
+    gb_init(&gb);
+
+    mmu_write(&gb, 0xFF04, 0);
+    mmu_write(&gb, 0xFF06, 0x80);
+    mmu_write(&gb, 0xFF07, 0x05);
+
+    // Read long past several overflows without running the events first
+    gb.cycles = 16 * (256 + 128 * 3) + 16 * 5;
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF05), 0x85);
+    ck_assert_uint_eq(gb.if_register & INT_TIMER, INT_TIMER);
+
+    // The overdue event finds nothing left to do
+    gb.if_register = 0;
+    sched_run_due(&gb);
+    ck_assert_uint_eq(gb.if_register, 0);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF05), 0x85);
+}
+END_TEST
+
+START_TEST(test_tima_write_cancels_reload) {
+    GameBoy gb;
+    gb_init(&gb);
+
+    mmu_write(&gb, 0xFF04, 0);
+    mmu_write(&gb, 0xFF06, 0x33);
+    mmu_write(&gb, 0xFF05, 0xFF);
+    mmu_write(&gb, 0xFF07, 0x05);
+
+    // Overflow at 16, write inside the reload window
+    gb.cycles = 18;
+    mmu_write(&gb, 0xFF05, 0x42);
+    run_to(&gb, 40);
+
+    ck_assert_uint_eq(gb.if_register & INT_TIMER, 0);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF05), 0x43);
+}
+END_TEST
+
+START_TEST(test_div_write_glitch) {
+    GameBoy gb;
+    gb_init(&gb);
+
+    mmu_write(&gb, 0xFF04, 0);
+    mmu_write(&gb, 0xFF07, 0x05); // Watches counter bit 3
+
+    // Bit 3 set at cycle 8: resetting the counter is a falling edge
+    run_to(&gb, 8);
+    mmu_write(&gb, 0xFF04, 0);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF05), 1);
+
+    // Bit 3 clear at cycle 8 + 4: no extra increment
+    run_to(&gb, 12);
+    mmu_write(&gb, 0xFF04, 0);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF05), 1);
+}
+END_TEST
+
+START_TEST(test_tac_disable_glitch) {
+    GameBoy gb;
+    gb_init(&gb);
+
+    mmu_write(&gb, 0xFF04, 0);
+    mmu_write(&gb, 0xFF07, 0x05);
+
+    run_to(&gb, 8);
+    mmu_write(&gb, 0xFF07, 0x01);
+    ck_assert_uint_eq(mmu_read(&gb, 0xFF05), 1);
+}
+END_TEST
+
+// ============================================================================
+// CPU Integration Tests
+// ============================================================================
+
+START_TEST(test_timer_wakes_halt) {
+    GameBoy gb;
+    gb_init(&gb);
+
+    mmu_write(&gb, 0xFF04, 0);
+    mmu_write(&gb, 0xFF05, 0xFF);
+    mmu_write(&gb, 0xFF07, 0x04); // 1024-cycle period
+    gb.ie_register = INT_TIMER;
+
+    // HALT, then NOP forever
+    gb.wram[0]     = 0x76;
+    gb.cpu.pc      = 0xC000;
+    gb.running     = true;
+
+    GbRunResult res = gb_run_cycles(&gb, 512);
+    ck_assert_int_eq(res.reason, GB_STOP_HALT);
+    ck_assert(gb.cpu.halted);
+
+    // Halted time is skipped straight to the reload at 1028
+    gb_run_cycles(&gb, 4000);
+    ck_assert(!gb.cpu.halted);
+    ck_assert_uint_eq(gb.if_register & INT_TIMER, INT_TIMER);
+}
+END_TEST
+
+// ============================================================================
+// Test Suite Setup
+// ============================================================================
+
+Suite *timer_suite(void) {
+    Suite *s;
+    TCase *tc_div, *tc_tima, *tc_cpu;
+
+    s      = suite_create("Timer");
+
+    // Divider
+    tc_div = tcase_create("DIV");
+    tcase_add_test(tc_div, test_div_boot_value);
+    tcase_add_test(tc_div, test_div_increments);
+    tcase_add_test(tc_div, test_div_reset);
+    suite_add_tcase(s, tc_div);
+
+    // Counter, overflow and write quirks
+    tc_tima = tcase_create("TIMA");
+    tcase_add_test(tc_tima, test_tima_rate);
+    tcase_add_test(tc_tima, test_tima_periods);
+    tcase_add_test(tc_tima, test_tima_overflow_event);
+    tcase_add_test(tc_tima, test_tima_lazy_catch_up);
+    tcase_add_test(tc_tima, test_tima_write_cancels_reload);
+    tcase_add_test(tc_tima, test_div_write_glitch);
+    tcase_add_test(tc_tima, test_tac_disable_glitch);
+    suite_add_tcase(s, tc_tima);
+
+    // Interrupt delivery through the run loop
+    tc_cpu = tcase_create("CPU Integration");
+    tcase_add_test(tc_cpu, test_timer_wakes_halt);
+    suite_add_tcase(s, tc_cpu);
+
+    return s;
+}
+
+int main(void) {
+    int      number_failed;
+    Suite   *s;
+    SRunner *sr;
+
+    s  = timer_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_NORMAL);
+    number_failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+
+    return (number_failed == 0) ? 0 : 1;
+}